@@ -0,0 +1,61 @@
+/*
+ * bench_cobs.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Word-at-a-time `Cobs` against the byte-at-a-time `Cobs_Reference` it replaced, per frame, for every payload mix
+ *  Decode times cover `decode()` plus `decode_in_place()`, same as the numbers that went in with the change
+ *  Host numbers, so only good for comparing the two, not for budgeting device time
+ *
+ *  NOT run by ctest; run it by hand out of the build directory
+ */
+
+#include <stdint.h>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "host_test.h"
+
+#include "app_comms_cobs.h"
+#include "cobs_reference.h"
+
+//time encode and decode of a rotating set of payloads; returns {encode ns, decode ns} per frame
+template<typename Codec>
+static std::pair<double, double> bench(Codec& codec, std::vector<std::vector<uint8_t>>& payloads, const size_t iterations) {
+	std::vector<uint8_t> frame(Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH), scratch(Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH);
+	size_t next = 0;
+	double encode_ns = time_ns(iterations, [&]() {
+		keep(codec.encode(payloads[next++ % payloads.size()], frame));
+	});
+
+	size_t frame_length = codec.encode(payloads[0], frame);
+	double decode_ns = time_ns(iterations, [&]() {
+		keep(codec.decode(std::span(frame.data(), frame_length), scratch));
+		std::copy_n(frame.begin(), frame_length, scratch.begin());
+		keep(codec.decode_in_place(std::span(scratch.data(), frame_length)));
+	});
+	return {encode_ns, decode_ns};
+}
+
+int main() {
+	std::mt19937 rng(1234);
+	Cobs cobs;
+	Cobs_Reference reference;
+
+	printf("%-6s %-18s %22s %22s\n", "size", "payload", "encode ns (old -> new)", "decode ns (old -> new)");
+	for(size_t length : {20, 240, 1000}) {
+		for(int kind = 0; kind < PAYLOAD_KIND_COUNT; kind++) {
+			std::vector<std::vector<uint8_t>> payloads;
+			for(size_t i = 0; i < 64; i++) payloads.push_back(make_payload(rng, (Payload_Kind)kind, length));
+
+			const size_t iterations = 20000000 / (length + 100);
+			auto [old_encode, old_decode] = bench(reference, payloads, iterations);
+			auto [new_encode, new_decode] = bench(cobs, payloads, iterations);
+			printf("%-6zu %-18s %9.0f -> %7.0f (x%.2f) %9.0f -> %7.0f (x%.2f)\n", length, payload_name((Payload_Kind)kind),
+					old_encode, new_encode, old_encode / new_encode, old_decode, new_decode, old_decode / new_decode);
+		}
+	}
+	return 0;
+}
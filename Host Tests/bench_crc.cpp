@@ -0,0 +1,46 @@
+/*
+ * bench_crc.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Per-frame cost of the software `Comms_CRC` backends, plus the incremental interface the streaming decoder uses
+ *  Host numbers, so they only say how the backends rank against each other; the HARDWARE backend has no peripheral here
+ *  (it falls back to BYTEWISE), so it isn't worth timing
+ *
+ *  NOT run by ctest; run it by hand out of the build directory
+ */
+
+#include <stdint.h>
+#include <random>
+#include <vector>
+
+#include "host_test.h"
+
+#include "app_comms_crc.h"
+
+int main() {
+	std::mt19937 rng(1);
+	std::vector<uint8_t> buf(1024);
+	for(auto& b : buf) b = (uint8_t)rng();
+
+	Comms_CRC bytewise(Comms_CRC::BYTEWISE);
+	Comms_CRC slice_by_4(Comms_CRC::SLICE_BY_4);
+	Comms_CRC slice_by_8(Comms_CRC::SLICE_BY_8);
+
+	printf("%-8s %12s %12s %12s %12s\n", "length", "bytewise", "slice-by-4", "slice-by-8", "update_crc");
+	for(size_t length : {8, 32, 64, 256, 1024}) {
+		std::span<uint8_t> frame(buf.data(), length);
+		const size_t iterations = 100000000 / (length + 16);
+
+		auto bench = [&](Comms_CRC& crc) { return time_ns(iterations, [&]() { keep(crc.compute_crc(frame)); }); };
+		double incremental_ns = time_ns(iterations, [&]() {
+			uint16_t crc = bytewise.start_crc();
+			for(uint8_t b : frame) crc = bytewise.update_crc(crc, b);
+			keep(crc);
+		});
+
+		printf("%-8zu %9.1f ns %9.1f ns %9.1f ns %9.1f ns\n", length, bench(bytewise), bench(slice_by_4), bench(slice_by_8), incremental_ns);
+	}
+	return 0;
+}
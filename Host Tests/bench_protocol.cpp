@@ -0,0 +1,112 @@
+/*
+ * bench_protocol.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Throughput of the receive and transmit paths on the host, end to end:
+ *  	- RX: raw frame bytes through the DMA frame extractor + streaming decoder, then the parser
+ *  	- RX (in place): the older path--buffer the raw frame, `decode_in_place()`, then the parser (which runs the CRC itself)
+ *  	- TX: pack a response with the parser and `encode_in_place()` it
+ *  for a handful of message sizes. Host numbers, so only good for comparing one change against another, not for budgeting device time
+ *
+ *  NOT run by ctest; run it by hand out of the build directory
+ */
+
+#include <stdint.h>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "host_test.h"
+
+#include "app_comms_cobs.h"
+#include "app_comms_cobs_stream.h"
+#include "app_comms_crc.h"
+#include "app_comms_parser.h"
+#include "app_hal_uart_frame_extractor.h"
+#include "app_utils_frame_queue.h"
+
+static constexpr uint8_t DEVICE_ADDRESS = 0x05;
+
+static std::pair<Parser::MessageType_t, size_t> ack(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+														std::span<uint8_t, std::dynamic_extent> tx_payload) {
+	tx_payload[0] = rx_payload[0];
+	return {Parser::DEVICE_ACK_HOST_MESSAGE, 1};
+}
+static constexpr Parser::command_mapping_t COMMANDS[] = {{0x10, ack}};
+static constexpr Parser::dispatch_table_t COMMAND_TABLE = Parser::make_dispatch_table({COMMANDS});
+static constexpr Parser::dispatch_table_t REQUEST_TABLE = Parser::make_dispatch_table({});
+
+int main() {
+	std::mt19937 rng(1);
+	Cobs cobs;
+	Comms_CRC crc;
+	Parser parser(crc, COMMAND_TABLE, REQUEST_TABLE);
+	parser.set_address(DEVICE_ADDRESS);
+
+	//receive side plumbing, sized like the firmware's bulk link
+	static constexpr size_t QUEUE_DEPTH = 4;
+	std::vector<uint8_t> storage(QUEUE_DEPTH * Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH);
+	std::vector<size_t> lengths(QUEUE_DEPTH);
+	std::vector<uint8_t> ring(2 * Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH);
+	Frame_Queue frames(storage, lengths);
+	Cobs_Stream_Decoder decoder(crc);
+	UART_Frame_Extractor extractor(Cobs::CHAR_START_OF_FRAME, Cobs::CHAR_END_OF_FRAME, ring, frames, &decoder);
+	std::vector<uint8_t> tx(Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH);
+
+	printf("%-8s %-14s %12s %12s\n", "payload", "path", "ns/frame", "MB/s");
+	for(size_t plen : {1, 16, 64, 240, 1000}) {
+		//a command with a random payload (plenty of delimiters in there to stuff)
+		bool extended = plen > Parser::MAX_PAYLOAD_LENGTH;
+		std::vector<uint8_t> message = {DEVICE_ADDRESS, (uint8_t)(Parser::HOST_COMMAND_TO_DEVICE | (extended ? Parser::MTYPE_FLAG_EXTENDED : 0))};
+		if(extended) message.push_back((uint8_t)(plen >> 8));
+		message.push_back((uint8_t)plen);
+		message.push_back(0x10);
+		for(size_t i = 1; i < plen; i++) message.push_back((uint8_t)rng());
+		uint16_t check = crc.compute_crc(message);
+		message.push_back((uint8_t)(check >> 8));
+		message.push_back((uint8_t)check);
+
+		std::vector<uint8_t> frame(Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH);
+		std::copy(message.begin(), message.end(), frame.begin() + Cobs::IDX_START_OF_PAYLOAD);
+		frame.resize(cobs.encode_in_place(frame, message.size()));
+
+		const size_t iterations = 50000000 / (plen + 16);
+		size_t dma_index = 0;
+
+		//DMA drops the frame into the ring, then the extractor, streaming decoder and parser take it from there
+		double rx_stream_ns = time_ns(iterations, [&]() {
+			for(uint8_t b : frame) {
+				ring[dma_index] = b;
+				dma_index = (dma_index + 1) % ring.size();
+			}
+			extractor.service(dma_index);
+			std::span<uint8_t> decoded = frames.front();
+			keep(parser.parse_buffer(Cobs_Stream_Decoder::packet(decoded), tx, Cobs_Stream_Decoder::crc_good(decoded)));
+			frames.pop();
+		});
+
+		std::vector<uint8_t> scratch(frame.size());
+		double rx_in_place_ns = time_ns(iterations, [&]() {
+			std::copy(frame.begin(), frame.end(), scratch.begin());
+			int16_t length = cobs.decode_in_place(scratch);
+			keep(parser.parse_buffer(std::span(scratch).subspan(Cobs::IDX_START_OF_PAYLOAD, length), tx));
+		});
+
+		//response with the same payload going back out
+		std::vector<uint8_t> tx_frame(Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH);
+		size_t pl_start = Cobs::IDX_START_OF_PAYLOAD + (extended ? Parser::PL_START_INDEX_EXTENDED : Parser::PL_START_INDEX);
+		double tx_ns = time_ns(iterations, [&]() {
+			std::copy_n(message.begin() + (pl_start - Cobs::IDX_START_OF_PAYLOAD), plen, tx_frame.begin() + pl_start);
+			size_t length = parser.pack_message(Parser::DEVICE_TELEMETRY, plen, std::span(tx_frame).subspan(Cobs::IDX_START_OF_PAYLOAD), extended);
+			keep(cobs.encode_in_place(tx_frame, length));
+		});
+
+		auto row = [&](const char* path, double ns) { printf("%-8zu %-14s %12.1f %12.1f\n", plen, path, ns, frame.size() / ns * 1e3); };
+		row("rx stream", rx_stream_ns);
+		row("rx in place", rx_in_place_ns);
+		row("tx", tx_ns);
+	}
+	return 0;
+}
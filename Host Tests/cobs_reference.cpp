@@ -0,0 +1,174 @@
+/*
+ * cobs_reference.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Straight copy of the byte-at-a-time encoder/decoder bodies from `app_comms_cobs.cpp`, as of right before delimiters got
+ *  scanned for a word at a time; only the class name (and the use of `Cobs`' length helpers) changed
+ *  DON'T "fix" or speed this up--its whole job is to be the old behavior
+ */
+
+#include "cobs_reference.h"
+
+#include <algorithm> //for min, max, copy_backward
+
+int16_t Cobs_Reference::encode(	const std::span<uint8_t, std::dynamic_extent> input_unencoded,
+						std::span<uint8_t, std::dynamic_extent> output_encoded)
+{
+	//sanity check the input length
+	//and ensure that the output buffer has enough space to store the encoded message
+	if(input_unencoded.size() > Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH) return -1;
+	if(output_encoded.size() < encoded_length(input_unencoded.size())) return -1;
+
+	//copy over the unencoded data to the output array
+	//dump data at the third position since [0] is SOF, [1] is overhead byte for SOF, [2] is overhead byte for EOF
+	std::copy(input_unencoded.begin(), input_unencoded.end(), output_encoded.begin() + IDX_START_OF_PAYLOAD);
+
+	//and encode it where it sits
+	return encode_in_place(output_encoded, input_unencoded.size());
+}
+
+int16_t Cobs_Reference::encode_in_place(std::span<uint8_t, std::dynamic_extent> output_encoded, const size_t payload_length) {
+	//sanity check the input length
+	if(payload_length > Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH) return -1;
+
+	//create a local variable for output length
+	size_t output_length = encoded_length(payload_length);
+	size_t blocks = std::max<size_t>(1, (payload_length + BLOCK_DATA_LENGTH - 1) / BLOCK_DATA_LENGTH);
+
+	//and ensure that the output buffer has enough space to store the encoded message
+	if(output_encoded.size() < output_length) return -1;
+
+	//if this is an extended frame, spread the payload out to make room for the overhead bytes of every block after the first
+	//work from the back so nothing gets overwritten before it's moved; the first block is already where it needs to be
+	for(size_t block = blocks - 1; block > 0; block--) {
+		size_t payload_offset = block * BLOCK_DATA_LENGTH;
+		size_t block_data_length = std::min(BLOCK_DATA_LENGTH, payload_length - payload_offset);
+		auto block_data = output_encoded.begin() + IDX_START_OF_PAYLOAD + payload_offset;
+		std::copy_backward(block_data, block_data + block_data_length, block_data + block_data_length + block * BLOCK_OVERHEAD);
+	}
+
+	//for our COBS encoded message, we'll put our terminating characters in the proper places
+	output_encoded[0] = Cobs::CHAR_START_OF_FRAME;
+	output_encoded[output_length - 1] = Cobs::CHAR_END_OF_FRAME;
+
+	//and stuff the delimiters block by block
+	for(size_t block_start = 1; block_start < output_length - 1; block_start += BLOCK_LENGTH)
+		encode_block(output_encoded, block_start, std::min(block_start + BLOCK_LENGTH, output_length - 1));
+
+	//return the size of our encoded array
+	return (int16_t)output_length;
+}
+
+
+int16_t Cobs_Reference::decode(	const std::span<uint8_t, std::dynamic_extent> input_encoded,
+						std::span<uint8_t, std::dynamic_extent> output_decoded)
+{
+	//sanity check the framing of the message
+	if(!frame_valid(input_encoded)) return -1;
+
+	//sanity check that we have enough space in the output buffer to store the decoded message
+	if(output_decoded.size() < decoded_length(input_encoded.size()))
+		return -1;
+
+	//copy the payload over, putting the delimiters back where they belong along the way
+	return restore_delimiters(input_encoded, output_decoded);
+}
+
+int16_t Cobs_Reference::decode_in_place(std::span<uint8_t, std::dynamic_extent> frame) {
+	//sanity check the framing of the message
+	if(!frame_valid(frame)) return -1;
+
+	//the payload is (mostly) already where it needs to be; just put the delimiters back
+	//and close up the gaps left by block overhead bytes if this is an extended frame
+	return restore_delimiters(frame, frame.subspan(IDX_START_OF_PAYLOAD));
+}
+
+//==================================== PRIVATE FUNCTIONS ====================================
+
+bool Cobs_Reference::frame_valid(const std::span<uint8_t, std::dynamic_extent> input_encoded) {
+	//sanity check the input length
+	if(input_encoded.size() > Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH || input_encoded.size() < OVERHEAD)
+		return false;
+
+	//sanity check that the first character is a start of frame
+	//and that the final character is an end of frame
+	return input_encoded.front() == Cobs::CHAR_START_OF_FRAME && input_encoded.back() == Cobs::CHAR_END_OF_FRAME;
+}
+
+void Cobs_Reference::encode_block(std::span<uint8_t, std::dynamic_extent> frame, const size_t block_start, const size_t block_end) {
+	//work through the block to figure out where to put the delimiter indices/offsets
+	//chains that don't hit any more delimiters point to the end of the block
+	size_t next_sof_char_index = block_end;
+	size_t next_eof_char_index = block_end;
+
+	//start iterating from back to front, starting at the last byte of the block
+	for(size_t i = block_end - 1; i >= block_start + BLOCK_OVERHEAD; i--) {
+		//if the character at the particular index matches our SOF
+		if(frame[i] == Cobs::CHAR_START_OF_FRAME) {
+			//replace the character at that index with an offset to the next SOF character we find
+			//make sure to appropriately cast the index variable to a uint8_t
+			frame[i] = (uint8_t)(next_sof_char_index - i);
+
+			//and store the current index as the next_delimiter_index
+			next_sof_char_index = i;
+		}
+
+		//do the same kinda thing, but look for EOF characters
+		if(frame[i] == Cobs::CHAR_END_OF_FRAME) {
+			frame[i] = (uint8_t)(next_eof_char_index - i);
+			next_eof_char_index = i;
+		}
+	}
+
+	//first overhead byte points to the first SOF char we see in the block
+	frame[block_start] = (uint8_t)(next_sof_char_index - block_start);
+
+	//second overhead byte points to the first EOF char we see in the block
+	frame[block_start + 1] = (uint8_t)(next_eof_char_index - (block_start + 1));
+}
+
+int16_t Cobs_Reference::restore_delimiters(	const std::span<uint8_t, std::dynamic_extent> input_encoded,
+									std::span<uint8_t, std::dynamic_extent> output_decoded)
+{
+	size_t eof_index = input_encoded.size() - 1;
+	size_t output_index = 0;
+
+	//run through the frame one block at a time
+	for(size_t block_start = 1; block_start < eof_index; block_start += BLOCK_LENGTH) {
+		size_t block_end = std::min(block_start + BLOCK_LENGTH, eof_index);
+		if(block_end - block_start < BLOCK_OVERHEAD) return -1; //frame got cut off in the middle of a block's overhead bytes
+
+		//overhead bytes point relative to where they sit
+		size_t next_sof_char_index = input_encoded[block_start] + block_start;
+		size_t next_eof_char_index = input_encoded[block_start + 1] + block_start + 1;
+
+		//run elementwise through the encoded block
+		//replacing all "encoded" characters with delimiters
+		for(size_t i = block_start + BLOCK_OVERHEAD; i < block_end; i++) {
+			//grab the offset before touching the output--when decoding in place, the output IS the input
+			uint8_t encoded_char = input_encoded[i];
+			uint8_t decoded_char = encoded_char;
+
+			//if our index indicates a SOF character in the particular position
+			if(next_sof_char_index == i) {
+				next_sof_char_index += encoded_char;
+				decoded_char = CHAR_START_OF_FRAME;
+			}
+
+			//do a similar thing when hunting for EOF characters
+			if(next_eof_char_index == i) {
+				next_eof_char_index += encoded_char;
+				decoded_char = CHAR_END_OF_FRAME;
+			}
+
+			output_decoded[output_index++] = decoded_char;
+		}
+
+		//and ensure that our delimiter indices point to the end of the block
+		if(next_sof_char_index != block_end || next_eof_char_index != block_end) return -1;
+	}
+
+	return (int16_t)output_index;
+}
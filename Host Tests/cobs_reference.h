@@ -0,0 +1,94 @@
+/*
+ * cobs_reference.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  The COBS encoder/decoder exactly as it was before the word-at-a-time delimiter scan went in
+ *  Kept around for the host tests, as the reference the current `Cobs` has to match byte for byte (and the baseline it gets benchmarked against)
+ *  Same interface and return values as `Cobs`; the length helpers and framing constants are borrowed straight from it
+ */
+
+#ifndef HOST_TESTS_COBS_REFERENCE_H_
+#define HOST_TESTS_COBS_REFERENCE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h> //for memcpy
+#include <math.h> //for sinf
+#include <span>
+#include <vector>
+#include <random>
+
+#include "app_comms_cobs.h" //for framing constants and length helpers
+
+class Cobs_Reference {
+public:
+	int16_t encode(	const std::span<uint8_t, std::dynamic_extent> input_unencoded,
+					std::span<uint8_t, std::dynamic_extent> output_encoded);
+	int16_t decode(	const std::span<uint8_t, std::dynamic_extent> input_encoded,
+					std::span<uint8_t, std::dynamic_extent> output_decoded);
+	int16_t encode_in_place(std::span<uint8_t, std::dynamic_extent> frame, const size_t payload_length);
+	int16_t decode_in_place(std::span<uint8_t, std::dynamic_extent> frame);
+
+private:
+	static constexpr size_t OVERHEAD = Cobs::MSG_MAX_ENCODED_LENGTH - Cobs::MSG_MAX_UNENCODED_LENGTH;
+	static constexpr size_t BLOCK_OVERHEAD = Cobs::BLOCK_OVERHEAD;
+	static constexpr size_t BLOCK_DATA_LENGTH = Cobs::BLOCK_DATA_LENGTH;
+	static constexpr size_t BLOCK_LENGTH = Cobs::BLOCK_LENGTH;
+	static constexpr size_t IDX_START_OF_PAYLOAD = Cobs::IDX_START_OF_PAYLOAD;
+	static constexpr uint8_t CHAR_START_OF_FRAME = Cobs::CHAR_START_OF_FRAME;
+	static constexpr uint8_t CHAR_END_OF_FRAME = Cobs::CHAR_END_OF_FRAME;
+	static size_t encoded_length(const size_t payload_length) { return Cobs::encoded_length(payload_length); }
+	static size_t decoded_length(const size_t frame_length) { return Cobs::decoded_length(frame_length); }
+
+	int16_t restore_delimiters(	const std::span<uint8_t, std::dynamic_extent> input_encoded,
+								std::span<uint8_t, std::dynamic_extent> output_decoded);
+	void encode_block(std::span<uint8_t, std::dynamic_extent> frame, const size_t block_start, const size_t block_end);
+	bool frame_valid(const std::span<uint8_t, std::dynamic_extent> input_encoded);
+};
+
+//payload mixes both implementations get run against; roughly what the links actually carry, plus the delimiter-heavy worst cases
+enum Payload_Kind {
+	PAYLOAD_RANDOM,				//uniformly random bytes
+	PAYLOAD_FLOATS,				//telemetry-style floats
+	PAYLOAD_WAVEFORM,			//int16 samples of a slow sine, lots of 0x00/0xFF in the high bytes
+	PAYLOAD_DENSE_DELIMITERS,	//about a third of the bytes are delimiters
+	PAYLOAD_ALL_ZERO,			//every byte a delimiter
+	PAYLOAD_KIND_COUNT,
+};
+
+inline const char* payload_name(const Payload_Kind kind) {
+	static constexpr const char* NAMES[] = {"random bytes", "telemetry floats", "int16 waveform", "1/3 delimiters", "all zero"};
+	return NAMES[kind];
+}
+
+inline std::vector<uint8_t> make_payload(std::mt19937& rng, const Payload_Kind kind, const size_t length) {
+	std::vector<uint8_t> payload(length);
+	switch(kind) {
+		case PAYLOAD_RANDOM:
+			for(auto& b : payload) b = (uint8_t)rng();
+			break;
+		case PAYLOAD_FLOATS:
+			for(size_t i = 0; i + 4 <= length; i += 4) {
+				float value = 100.0f * sinf(i * 0.01f) + (rng() % 1000) * 1e-3f;
+				memcpy(&payload[i], &value, 4);
+			}
+			break;
+		case PAYLOAD_WAVEFORM:
+			for(size_t i = 0; i + 2 <= length; i += 2) {
+				int16_t sample = (int16_t)(2000 * sinf(i * 0.003f));
+				memcpy(&payload[i], &sample, 2);
+			}
+			break;
+		case PAYLOAD_DENSE_DELIMITERS:
+			for(auto& b : payload) b = (rng() % 3 == 0) ? Cobs::CHAR_END_OF_FRAME : (rng() % 3 == 0) ? Cobs::CHAR_START_OF_FRAME : (uint8_t)rng();
+			break;
+		case PAYLOAD_ALL_ZERO:
+		default:
+			break;
+	}
+	return payload;
+}
+
+#endif /* HOST_TESTS_COBS_REFERENCE_H_ */
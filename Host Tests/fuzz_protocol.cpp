@@ -0,0 +1,370 @@
+/*
+ * fuzz_protocol.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Randomized test of the whole receive path: COBS framing, the streaming decoder, and the parser
+ *  Seeded, so a failure reproduces; pass a seed and iteration count on the command line to go looking for more
+ *
+ *  	- random payloads (heavy on delimiter characters) have to survive an in-place COBS round trip, short and extended
+ *  	- the same frames pushed through the DMA frame extractor + streaming decoder have to come out identical to the in-place decoder's
+ *  	- mangled frames and plain line noise must never get either decoder to write past its buffer, or pass a frame that wasn't sent
+ *  	- emergency stop frames trip the decoder's hook (stamped with their EOF), and near misses don't
+ *  	- the parser has to come back with a sane response (or none) to every well-formed message, and keep its response inside the tx buffer
+ *  	  no matter what junk it's fed
+ */
+
+#include <stdint.h>
+#include <stdlib.h> //for strtoul
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "host_test.h"
+
+#include "app_comms_cobs.h"
+#include "app_comms_cobs_stream.h"
+#include "app_comms_crc.h"
+#include "app_comms_parser.h"
+#include "app_hal_uart_frame_extractor.h"
+#include "app_utils_frame_queue.h"
+#include "app_cmhand_mapping.h"
+
+static constexpr uint8_t DEVICE_ADDRESS = 0x05;
+static constexpr size_t GUARD_LENGTH = 16; //bytes past the end of every buffer that nobody's allowed to touch
+static constexpr uint8_t GUARD_BYTE = 0xA5;
+
+//======================================== HANDLERS ========================================
+//echo whatever we got back; plenty to exercise the parser's framing without dragging the rest of the firmware along
+
+static std::pair<Parser::MessageType_t, size_t> echo_command(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																std::span<uint8_t, std::dynamic_extent> tx_payload) {
+	size_t length = std::min(rx_payload.size(), tx_payload.size());
+	std::copy_n(rx_payload.begin(), length, tx_payload.begin());
+	return {Parser::DEVICE_ACK_HOST_MESSAGE, length};
+}
+
+static std::pair<Parser::MessageType_t, size_t> echo_request(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																std::span<uint8_t, std::dynamic_extent> tx_payload) {
+	size_t length = std::min(rx_payload.size(), tx_payload.size());
+	std::copy_n(rx_payload.begin(), length, tx_payload.begin());
+	return {Parser::DEVICE_RESPONSE_HOST_REQUEST, length};
+}
+
+//leave some codes unmapped so the parser's unknown-code paths get hit too
+static constexpr Parser::command_mapping_t COMMANDS[] = {{0x00, echo_command}, {0x01, echo_command}, {0xFF, echo_command}};
+static constexpr Parser::request_mapping_t REQUESTS[] = {{0x00, echo_request}, {0x80, echo_request}};
+static constexpr Parser::dispatch_table_t COMMAND_TABLE = Parser::make_dispatch_table({COMMANDS});
+static constexpr Parser::dispatch_table_t REQUEST_TABLE = Parser::make_dispatch_table({REQUESTS});
+
+//======================================== HELPERS ========================================
+
+//payload bytes; delimiters show up a lot more often than they would by chance, since they're what the framing has to get right
+static uint8_t random_byte(std::mt19937& rng) {
+	switch(rng() % 4) {
+		case 0: return Cobs::CHAR_END_OF_FRAME;
+		case 1: return Cobs::CHAR_START_OF_FRAME;
+		default: return (uint8_t)rng();
+	}
+}
+
+static bool guard_intact(const std::vector<uint8_t>& buf, const size_t length) {
+	return std::all_of(buf.begin() + length, buf.end(), [](uint8_t b) { return b == GUARD_BYTE; });
+}
+
+//build a host message addressed to us (or whoever) with a good CRC
+static std::vector<uint8_t> make_message(std::mt19937& rng, Comms_CRC& crc) {
+	uint8_t flags = 0;
+	if(rng() % 4 == 0) flags |= Parser::MTYPE_FLAG_EXTENDED;
+	if(rng() % 2 == 0) flags |= Parser::MTYPE_FLAG_SEQUENCED;
+	bool extended = flags & Parser::MTYPE_FLAG_EXTENDED;
+
+	static constexpr uint8_t TYPES[] = {	Parser::HOST_COMMAND_ALL_DEVICES, Parser::HOST_COMMAND_TO_DEVICE,
+											Parser::HOST_REQUEST_FROM_DEVICE, Parser::HOST_BATCH_TO_DEVICE};
+	static constexpr uint8_t IDS[] = {DEVICE_ADDRESS, DEVICE_ADDRESS, DEVICE_ADDRESS, Parser::BROADCAST_ADDRESS, 0x06};
+
+	size_t max_plen = extended ? Parser::MAX_PAYLOAD_LENGTH_EXTENDED - Parser::SEQ_OVERHEAD : Parser::MAX_PAYLOAD_LENGTH - Parser::SEQ_OVERHEAD;
+	size_t plen = 1 + rng() % ((rng() % 8 == 0) ? max_plen : 16);
+
+	std::vector<uint8_t> message;
+	message.push_back(IDS[rng() % std::size(IDS)]);
+	message.push_back(TYPES[rng() % std::size(TYPES)] | flags);
+	if(extended) message.push_back((uint8_t)(plen >> 8));
+	message.push_back((uint8_t)plen);
+	if(flags & Parser::MTYPE_FLAG_SEQUENCED) message.push_back((uint8_t)rng());
+	for(size_t i = 0; i < plen; i++) message.push_back(random_byte(rng));
+
+	uint16_t check = crc.compute_crc(message);
+	message.push_back((uint8_t)(check >> 8));
+	message.push_back((uint8_t)check);
+	return message;
+}
+
+//encode a payload into a frame; empty if the encoder refused
+static std::vector<uint8_t> encode(Cobs& cobs, const std::vector<uint8_t>& payload) {
+	std::vector<uint8_t> frame(Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH);
+	std::copy(payload.begin(), payload.end(), frame.begin() + Cobs::IDX_START_OF_PAYLOAD);
+	int16_t length = cobs.encode_in_place(frame, payload.size());
+	if(length <= 0) return {};
+	frame.resize(length);
+	return frame;
+}
+
+//======================================== TESTS ========================================
+
+static void fuzz_cobs_round_trip(std::mt19937& rng, Cobs& cobs, const size_t iterations) {
+	for(size_t it = 0; it < iterations; it++) {
+		//mostly short frames, plus a good helping of every extended block count
+		size_t max_length = (it % 2) ? Cobs::MSG_MAX_UNENCODED_LENGTH : Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH;
+		std::vector<uint8_t> payload(1 + rng() % max_length);
+		for(auto& b : payload) b = random_byte(rng);
+
+		std::vector<uint8_t> frame = encode(cobs, payload);
+		CHECK(frame.size() == Cobs::encoded_length(payload.size()));
+		if(frame.empty()) continue;
+
+		//only the ends of the frame are allowed to hold delimiters
+		CHECK(frame.front() == Cobs::CHAR_START_OF_FRAME && frame.back() == Cobs::CHAR_END_OF_FRAME);
+		CHECK(std::none_of(frame.begin() + 1, frame.end() - 1,
+				[](uint8_t b) { return b == Cobs::CHAR_START_OF_FRAME || b == Cobs::CHAR_END_OF_FRAME; }));
+
+		int16_t decoded_length = cobs.decode_in_place(frame);
+		CHECK(decoded_length == (int16_t)payload.size());
+		CHECK(decoded_length > 0 && std::equal(payload.begin(), payload.end(), frame.begin() + Cobs::IDX_START_OF_PAYLOAD));
+	}
+
+	//one past the longest payload has to be refused, not truncated
+	std::vector<uint8_t> frame(Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH + Cobs::BLOCK_LENGTH);
+	CHECK(cobs.encode_in_place(frame, Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH + 1) < 0);
+}
+
+static void fuzz_mangled_frames(std::mt19937& rng, Cobs& cobs, const size_t iterations) {
+	for(size_t it = 0; it < iterations; it++) {
+		std::vector<uint8_t> payload(1 + rng() % Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH);
+		for(auto& b : payload) b = random_byte(rng);
+		std::vector<uint8_t> frame = encode(cobs, payload);
+		if(frame.empty()) continue;
+
+		//truncate it, flip a byte, or drop a delimiter somewhere it shouldn't be
+		switch(rng() % 3) {
+			case 0: frame.resize(1 + rng() % frame.size()); break;
+			case 1: frame[rng() % frame.size()] ^= (uint8_t)(1 + rng() % 255); break;
+			default: frame[rng() % frame.size()] = (rng() % 2) ? Cobs::CHAR_START_OF_FRAME : Cobs::CHAR_END_OF_FRAME; break;
+		}
+
+		//decoder has to stay inside the frame, and never claim more than it could have decoded
+		size_t length = frame.size();
+		frame.resize(length + GUARD_LENGTH, GUARD_BYTE);
+		int16_t decoded_length = cobs.decode_in_place(std::span(frame.data(), length));
+		CHECK(guard_intact(frame, length));
+		CHECK(decoded_length < (int16_t)length);
+	}
+}
+
+//everything pushed through the DMA ring, extractor and streaming decoder has to match what the in-place decoder makes of it
+static void fuzz_stream_decoder(std::mt19937& rng, Cobs& cobs, Comms_CRC& crc, const size_t iterations) {
+	static constexpr size_t QUEUE_DEPTH = 4;
+	static constexpr size_t SLOT_SIZE = Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH;
+	std::vector<uint8_t> storage(QUEUE_DEPTH * SLOT_SIZE + GUARD_LENGTH, GUARD_BYTE);
+	std::vector<size_t> lengths(QUEUE_DEPTH);
+	std::vector<uint8_t> ring(512);
+
+	Frame_Queue frames(std::span(storage.data(), QUEUE_DEPTH * SLOT_SIZE), lengths);
+	Cobs_Stream_Decoder decoder(crc);
+	UART_Frame_Extractor extractor(Cobs::CHAR_START_OF_FRAME, Cobs::CHAR_END_OF_FRAME, ring, frames, &decoder);
+	size_t dma_index = 0;
+
+	//pretend to be the DMA; hand the extractor whatever's arrived in random-sized bursts
+	auto receive = [&](const std::vector<uint8_t>& bytes) {
+		size_t sent = 0;
+		while(sent < bytes.size()) {
+			size_t burst = std::min<size_t>(1 + rng() % (ring.size() - 1), bytes.size() - sent);
+			for(size_t i = 0; i < burst; i++) {
+				ring[dma_index] = bytes[sent + i];
+				dma_index = (dma_index + 1) % ring.size();
+			}
+			sent += burst;
+			extractor.service(dma_index);
+		}
+	};
+
+	size_t matched = 0;
+	for(size_t it = 0; it < iterations; it++) {
+		std::vector<uint8_t> payload(1 + rng() % Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH);
+		for(auto& b : payload) b = random_byte(rng);
+		bool mangle = rng() % 4 == 0;
+		if(rng() % 2) {
+			//give half of them a real CRC, so both STATUS values get checked
+			uint16_t check = crc.compute_crc(std::span(payload).first(payload.size() - std::min<size_t>(payload.size(), 2)));
+			if(payload.size() > 2) { payload[payload.size() - 2] = (uint8_t)(check >> 8); payload.back() = (uint8_t)check; }
+		}
+
+		std::vector<uint8_t> frame = encode(cobs, payload);
+		if(frame.empty()) continue;
+		if(mangle) {
+			//a delimiter would just split the frame in two; the extractor's job, not the decoder's
+			uint8_t& victim = frame[1 + rng() % (frame.size() - 2)];
+			do victim ^= (uint8_t)(1 + rng() % 255);
+			while(victim == Cobs::CHAR_START_OF_FRAME || victim == Cobs::CHAR_END_OF_FRAME);
+		}
+
+		//line noise between frames is fine as long as it doesn't hold a SOF
+		std::vector<uint8_t> noise(rng() % 8);
+		for(auto& b : noise) b = (uint8_t)(rng() % Cobs::CHAR_START_OF_FRAME);
+
+		std::vector<uint8_t> reference = frame;
+		int16_t reference_length = cobs.decode_in_place(reference);
+
+		uint32_t rejects = extractor.get_reject_count();
+		uint32_t overflows = extractor.get_overflow_count();
+		receive(noise);
+		receive(frame);
+		CHECK(frames.size() <= 1);
+		CHECK(guard_intact(storage, QUEUE_DEPTH * SLOT_SIZE));
+
+		std::span<uint8_t> decoded = frames.front();
+		if(decoded.empty()) {
+			//only frames the in-place decoder would've refused are allowed to go missing (or a mangle that made a frame too long)
+			CHECK(reference_length < 0 || extractor.get_reject_count() != rejects || extractor.get_overflow_count() != overflows);
+			CHECK(mangle);
+			continue;
+		}
+
+		//a mangled frame can still decode to something; it just has to be the same something both ways
+		CHECK(reference_length >= 0);
+		if(reference_length < 0) { frames.pop(); continue; }
+		std::span<uint8_t> packet = Cobs_Stream_Decoder::packet(decoded);
+		std::span<uint8_t> reference_packet = std::span(reference).subspan(Cobs::IDX_START_OF_PAYLOAD, reference_length);
+		CHECK(std::equal(packet.begin(), packet.end(), reference_packet.begin(), reference_packet.end()));
+		CHECK(Cobs_Stream_Decoder::crc_good(decoded) == crc.validate_crc(reference_packet));
+		if(!mangle) matched++;
+		frames.pop();
+	}
+
+	//make sure we didn't just skip everything
+	CHECK(matched > iterations / 2);
+}
+
+//emergency stop frames have to trip the hook straight out of the decoder, stamped with when their EOF landed
+//anything close but not quite (bad CRC, extra payload, somebody else's address) must not
+static uint32_t fake_clock = 0;
+static uint32_t fake_timestamp() { return fake_clock += 1000; }
+
+static void check_emergency_stop(std::mt19937& rng, Cobs& cobs, Comms_CRC& crc) {
+	std::vector<uint8_t> storage(4 * Cobs::MSG_MAX_ENCODED_LENGTH);
+	std::vector<size_t> lengths(4);
+	std::vector<uint8_t> ring(512);
+	Frame_Queue frames(storage, lengths);
+	Cobs_Stream_Decoder decoder(crc, fake_timestamp);
+	UART_Frame_Extractor extractor(Cobs::CHAR_START_OF_FRAME, Cobs::CHAR_END_OF_FRAME, ring, frames, &decoder);
+	decoder.set_address(DEVICE_ADDRESS, false);
+
+	struct { size_t trips = 0; uint32_t eof_timestamp = 0; } hook;
+	decoder.attach_emergency_stop_cb(&hook, [](void* context, const uint32_t eof_timestamp) {
+		auto* h = static_cast<decltype(hook)*>(context);
+		h->trips++;
+		h->eof_timestamp = eof_timestamp;
+	});
+
+	size_t dma_index = 0;
+	auto receive = [&](std::vector<uint8_t> message, const bool good_crc) {
+		uint16_t check = crc.compute_crc(message);
+		if(!good_crc) check ^= 0x0100;
+		message.push_back((uint8_t)(check >> 8));
+		message.push_back((uint8_t)check);
+		for(uint8_t b : encode(cobs, message)) {
+			ring[dma_index] = b;
+			dma_index = (dma_index + 1) % ring.size();
+		}
+		extractor.service(dma_index);
+		while(!frames.front().empty()) frames.pop();
+	};
+
+	const uint8_t STOP = CM_Mapping::STAGE_EMERGENCY_STOP;
+	for(size_t it = 0; it < 100; it++) {
+		//the real thing, in every form it's allowed to take
+		static constexpr uint8_t IDS[] = {DEVICE_ADDRESS, Parser::BROADCAST_ADDRESS};
+		size_t trips = hook.trips;
+		if(rng() % 2) receive({IDS[rng() % 2], Parser::HOST_COMMAND_TO_DEVICE, 1, STOP}, true);
+		else receive({(uint8_t)rng(), Parser::HOST_COMMAND_ALL_DEVICES, 1, STOP}, true);
+		CHECK(hook.trips == trips + 1);
+		CHECK(hook.eof_timestamp == fake_clock); //the decoder only reads the clock once, right as the EOF lands
+
+		//and the near misses
+		receive({DEVICE_ADDRESS, Parser::HOST_COMMAND_TO_DEVICE, 1, STOP}, false);
+		receive({DEVICE_ADDRESS, Parser::HOST_COMMAND_TO_DEVICE, 2, STOP, 0x00}, true);
+		receive({DEVICE_ADDRESS + 1, Parser::HOST_COMMAND_TO_DEVICE, 1, STOP}, true);
+		receive({DEVICE_ADDRESS, (uint8_t)(Parser::HOST_COMMAND_TO_DEVICE | Parser::MTYPE_FLAG_SEQUENCED), 1, 0x00, STOP}, true);
+		CHECK(hook.trips == trips + 1);
+	}
+}
+
+static void fuzz_parser(std::mt19937& rng, Cobs& cobs, Comms_CRC& crc, const size_t iterations) {
+	Parser parser(crc, COMMAND_TABLE, REQUEST_TABLE);
+	parser.set_address(DEVICE_ADDRESS);
+	std::vector<uint8_t> tx(Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH + GUARD_LENGTH);
+
+	for(size_t it = 0; it < iterations; it++) {
+		std::fill(tx.begin(), tx.end(), GUARD_BYTE);
+		std::span<uint8_t> tx_packet(tx.data(), tx.size() - GUARD_LENGTH);
+
+		//well-formed messages; whatever comes back has to be a properly framed response with a good CRC
+		std::vector<uint8_t> message = make_message(rng, crc);
+		uint8_t mtype = message[Parser::MTYPE_INDEX] & Parser::MESSAGE_TYPE_MASK;
+		size_t response_length = parser.parse_buffer(message, tx_packet);
+		CHECK(guard_intact(tx, tx_packet.size()));
+
+		bool for_us = Parser::addressed_to(message[Parser::ID_INDEX], message[Parser::MTYPE_INDEX], DEVICE_ADDRESS);
+		bool expect_response = for_us && mtype != Parser::HOST_COMMAND_ALL_DEVICES;
+		CHECK((response_length > 0) == expect_response);
+		if(response_length > 0) {
+			std::span<uint8_t> response = tx_packet.first(response_length);
+			CHECK(response[Parser::ID_INDEX] == DEVICE_ADDRESS);
+			CHECK(crc.validate_crc(response));
+			uint8_t response_type = response[Parser::MTYPE_INDEX] & Parser::MESSAGE_TYPE_MASK;
+			CHECK(response_type >= Parser::DEVICE_NACK_HOST_MESSAGE && response_type <= Parser::DEVICE_RESPONSE_HOST_BATCH);
+
+			//and the response has to make it back through the framing
+			std::vector<uint8_t> response_copy(response.begin(), response.end());
+			std::vector<uint8_t> frame = encode(cobs, response_copy);
+			CHECK(!frame.empty() && cobs.decode_in_place(frame) == (int16_t)response_length);
+		}
+
+		//junk, with a fair chance of a header that at least looks right
+		std::fill(tx.begin(), tx.end(), GUARD_BYTE);
+		std::vector<uint8_t> junk(rng() % (Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH + 8));
+		for(auto& b : junk) b = (uint8_t)rng();
+		if(junk.size() > Parser::MTYPE_INDEX && rng() % 2) {
+			junk[Parser::ID_INDEX] = DEVICE_ADDRESS;
+			junk[Parser::MTYPE_INDEX] &= ~0x0C; //keep it a host message type
+		}
+		response_length = parser.parse_buffer(junk, tx_packet);
+		CHECK(response_length <= tx_packet.size());
+		CHECK(guard_intact(tx, tx_packet.size()));
+
+		//and a short tx buffer, like a nearly full queue slot, has to be respected too
+		std::fill(tx.begin(), tx.end(), GUARD_BYTE);
+		size_t short_length = rng() % 32;
+		response_length = parser.parse_buffer(message, std::span(tx.data(), short_length));
+		CHECK(response_length <= short_length);
+		CHECK(guard_intact(tx, short_length));
+	}
+}
+
+int main(int argc, char** argv) {
+	uint32_t seed = (argc > 1) ? strtoul(argv[1], nullptr, 0) : 1;
+	size_t iterations = (argc > 2) ? strtoul(argv[2], nullptr, 0) : 20000;
+	printf("seed %u, %zu iterations\n", seed, iterations);
+
+	std::mt19937 rng(seed);
+	Cobs cobs;
+	Comms_CRC crc;
+
+	fuzz_cobs_round_trip(rng, cobs, iterations);
+	fuzz_mangled_frames(rng, cobs, iterations);
+	fuzz_stream_decoder(rng, cobs, crc, iterations);
+	check_emergency_stop(rng, cobs, crc);
+	fuzz_parser(rng, cobs, crc, iterations);
+	return TEST_RESULT();
+}
@@ -0,0 +1,47 @@
+/*
+ * host_test.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Bare minimum test scaffolding for the host tests; no framework to drag along
+ *  	\--> `CHECK()` logs every failure (with where it happened) and keeps going, so one run shows everything that's broken
+ *  	\--> `TEST_RESULT()` at the end of `main()` turns the failure count into the exit code ctest looks at
+ *
+ *  Also a little timing helper for the benchmarks
+ */
+
+#ifndef HOST_TESTS_HOST_TEST_H_
+#define HOST_TESTS_HOST_TEST_H_
+
+#include <stdio.h> //for printf
+#include <stddef.h> //for size_t
+#include <chrono> //for benchmark timing
+
+inline size_t host_test_failures = 0;
+
+#define CHECK(cond) do { \
+		if(!(cond)) { \
+			host_test_failures++; \
+			printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+		} \
+	} while(0)
+
+#define TEST_RESULT() ( \
+		printf(host_test_failures ? "FAILED (%zu checks)\n" : "passed\n", host_test_failures), \
+		host_test_failures ? 1 : 0)
+
+//run `func` `iterations` times and return the average time per call in nanoseconds
+template<typename Func>
+double time_ns(const size_t iterations, Func func) {
+	auto start = std::chrono::steady_clock::now();
+	for(size_t i = 0; i < iterations; i++) func();
+	auto elapsed = std::chrono::steady_clock::now() - start;
+	return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+//keep the optimizer from throwing away work whose result we never look at
+template<typename T>
+inline void keep(T const& value) { asm volatile("" : : "r,m"(value) : "memory"); }
+
+#endif /* HOST_TESTS_HOST_TEST_H_ */
@@ -0,0 +1,89 @@
+/*
+ * stm32g474xx.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  HOST STAND-IN for the device header; only for building `app_comms_crc.cpp` with `STM32G474xx` defined in the host tests
+ *  Models just enough of the CRC peripheral (and RCC) for the HARDWARE backend to run:
+ *  	- writing CR with the RESET bit loads INIT into the CRC accumulator
+ *  	- a 32-bit write to DR shifts all 32 bits through the accumulator, most significant bit first, using POL
+ *  	  (16-bit polynomial, no input/output reversal--the only configuration the firmware uses)
+ *  	- reading DR returns the accumulator
+ *  Counts data register writes too, so a test can tell how the buffer was fed in
+ *
+ *  Register behavior is straight out of RM0440 (CRC calculation unit); it's a model, not the real thing, so a pass here
+ *  says the backend drives the peripheral the way the reference manual says it should
+ */
+
+#ifndef HOST_TESTS_STUBS_STM32G474XX_H_
+#define HOST_TESTS_STUBS_STM32G474XX_H_
+
+#include <stdint.h>
+
+#define RCC_AHB1ENR_CRCEN		(1UL << 12)
+#define CRC_CR_RESET			(1UL << 0)
+#define CRC_CR_POLYSIZE_0		(1UL << 3)
+
+typedef struct {
+	uint32_t AHB1ENR;
+} RCC_TypeDef;
+
+#ifdef __cplusplus
+
+//data register: writes get crunched through the accumulator, reads return it
+struct CRC_Data_Register {
+	CRC_Data_Register& operator=(const uint32_t data);
+	operator uint32_t() const;
+};
+
+//control register: the RESET bit reloads the accumulator (and reads back as 0, like the real one)
+struct CRC_Control_Register {
+	CRC_Control_Register& operator=(const uint32_t value);
+	operator uint32_t() const { return value; }
+	uint32_t value = 0;
+};
+
+typedef struct {
+	CRC_Data_Register DR;
+	uint32_t IDR;
+	CRC_Control_Register CR;
+	uint32_t INIT;
+	uint32_t POL;
+
+	//model state
+	uint16_t accumulator;
+	uint32_t word_writes;
+} CRC_TypeDef;
+
+inline CRC_TypeDef crc_peripheral_model = {};
+inline RCC_TypeDef rcc_model = {};
+#define CRC (&crc_peripheral_model)
+#define RCC (&rcc_model)
+
+inline CRC_Data_Register& CRC_Data_Register::operator=(const uint32_t data) {
+	//clocking has to be on, or the real thing just ignores us
+	if(!(RCC->AHB1ENR & RCC_AHB1ENR_CRCEN)) return *this;
+
+	uint16_t crc = CRC->accumulator;
+	for(int bit = 31; bit >= 0; bit--) {
+		bool feedback = ((crc >> 15) ^ (data >> bit)) & 1;
+		crc = (uint16_t)(crc << 1);
+		if(feedback) crc ^= (uint16_t)CRC->POL;
+	}
+	CRC->accumulator = crc;
+	CRC->word_writes++;
+	return *this;
+}
+
+inline CRC_Data_Register::operator uint32_t() const { return CRC->accumulator; }
+
+inline CRC_Control_Register& CRC_Control_Register::operator=(const uint32_t _value) {
+	if(_value & CRC_CR_RESET) CRC->accumulator = (uint16_t)CRC->INIT;
+	value = _value & ~CRC_CR_RESET;
+	return *this;
+}
+
+#endif
+
+#endif /* HOST_TESTS_STUBS_STM32G474XX_H_ */
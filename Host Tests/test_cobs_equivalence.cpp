@@ -0,0 +1,107 @@
+/*
+ * test_cobs_equivalence.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  The word-at-a-time `Cobs` has to behave EXACTLY like the byte-at-a-time encoder/decoder it replaced (`Cobs_Reference`):
+ *  	- byte-identical encoded frames, from both `encode()` and `encode_in_place()`, for every payload mix and length
+ *  	- identical return values and output from `decode()`/`decode_in_place()`, on good frames AND corrupted ones
+ *  	  (so a mangled frame gets rejected--or let through--exactly the way it used to be)
+ *  	- neither decoder writes past the frame it was given
+ */
+
+#include <stdint.h>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "host_test.h"
+
+#include "app_comms_cobs.h"
+#include "cobs_reference.h"
+
+static constexpr size_t BUFFER_LENGTH = Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH + 16;
+static constexpr uint8_t GUARD_BYTE = 0x5A;
+
+static void check_encode(Cobs& cobs, Cobs_Reference& reference, const std::vector<uint8_t>& payload) {
+	//copying encoder, into buffers pre-filled with the same junk so untouched bytes compare equal too
+	std::vector<uint8_t> encoded(BUFFER_LENGTH, GUARD_BYTE), reference_encoded(BUFFER_LENGTH, GUARD_BYTE);
+	std::vector<uint8_t> input = payload;
+	int16_t length = cobs.encode(input, encoded);
+	int16_t reference_length = reference.encode(input, reference_encoded);
+	CHECK(length == reference_length);
+	CHECK(encoded == reference_encoded);
+
+	//in place, with the payload already in the frame
+	std::vector<uint8_t> frame(BUFFER_LENGTH, GUARD_BYTE);
+	std::copy(payload.begin(), payload.end(), frame.begin() + Cobs::IDX_START_OF_PAYLOAD);
+	std::vector<uint8_t> reference_frame = frame;
+	CHECK(cobs.encode_in_place(frame, payload.size()) == reference.encode_in_place(reference_frame, payload.size()));
+	CHECK(frame == reference_frame);
+}
+
+static void check_decode(Cobs& cobs, Cobs_Reference& reference, const std::vector<uint8_t>& frame) {
+	//copying decoder
+	std::vector<uint8_t> input = frame, reference_input = frame;
+	std::vector<uint8_t> decoded(BUFFER_LENGTH, GUARD_BYTE), reference_decoded(BUFFER_LENGTH, GUARD_BYTE);
+	int16_t length = cobs.decode(input, decoded);
+	int16_t reference_length = reference.decode(reference_input, reference_decoded);
+	CHECK(length == reference_length);
+	if(length > 0) CHECK(std::equal(decoded.begin(), decoded.begin() + length, reference_decoded.begin()));
+
+	//a failed decode can leave junk in the output, but never past the longest message the frame could've held
+	size_t limit = std::max<size_t>(Cobs::decoded_length(frame.size()), std::max<int16_t>(length, 0));
+	CHECK(std::all_of(decoded.begin() + limit, decoded.end(), [](uint8_t b) { return b == GUARD_BYTE; }));
+
+	//in place; only the decoded message is defined afterwards, but nothing past the frame may be touched
+	std::vector<uint8_t> in_place = frame, reference_in_place = frame;
+	in_place.resize(frame.size() + 16, GUARD_BYTE);
+	reference_in_place.resize(frame.size() + 16, GUARD_BYTE);
+	length = cobs.decode_in_place(std::span(in_place.data(), frame.size()));
+	reference_length = reference.decode_in_place(std::span(reference_in_place.data(), frame.size()));
+	CHECK(length == reference_length);
+	if(length > 0) {
+		auto start = Cobs::IDX_START_OF_PAYLOAD;
+		CHECK(std::equal(in_place.begin() + start, in_place.begin() + start + length, reference_in_place.begin() + start));
+	}
+	CHECK(std::all_of(in_place.begin() + frame.size(), in_place.end(), [](uint8_t b) { return b == GUARD_BYTE; }));
+}
+
+int main() {
+	std::mt19937 rng(1);
+	Cobs cobs;
+	Cobs_Reference reference;
+
+	//every length (including empty and one past the max) for every payload mix
+	for(size_t length = 0; length <= Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH + 1; length++) {
+		for(int kind = 0; kind < PAYLOAD_KIND_COUNT; kind++) {
+			auto payload = make_payload(rng, (Payload_Kind)kind, length);
+			check_encode(cobs, reference, payload);
+		}
+	}
+
+	//and a pile of random round trips, with corrupted frames mixed in
+	for(size_t it = 0; it < 100000; it++) {
+		size_t length = rng() % (Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH + 1);
+		auto payload = make_payload(rng, (Payload_Kind)(rng() % PAYLOAD_KIND_COUNT), length);
+		check_encode(cobs, reference, payload);
+
+		std::vector<uint8_t> frame(BUFFER_LENGTH);
+		int16_t frame_length = cobs.encode(payload, frame);
+		if(frame_length <= 0) continue;
+		frame.resize(frame_length);
+		check_decode(cobs, reference, frame);
+
+		//overhead bytes and chain offsets are what the fast decoder skips over, so mangle those the most
+		switch(rng() % 4) {
+			case 0: frame[1 + rng() % (frame.size() - 2)] = (uint8_t)rng(); break;
+			case 1: frame[1 + (rng() % Cobs::MAX_BLOCKS) * Cobs::BLOCK_LENGTH % (frame.size() - 2)] += (uint8_t)(1 + rng() % 8); break;
+			case 2: frame.resize(Cobs::IDX_START_OF_PAYLOAD + rng() % (frame.size() - Cobs::IDX_START_OF_PAYLOAD)); frame.push_back(Cobs::CHAR_END_OF_FRAME); break;
+			default: frame.insert(frame.begin() + 1 + rng() % (frame.size() - 1), (uint8_t)rng()); break;
+		}
+		check_decode(cobs, reference, frame);
+	}
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,158 @@
+/*
+ * test_debug_print.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  `Debug_Print` is just a `Record_Ring` with a frame packer on the back of it, so check the parts that are its own:
+ *  	- messages come back out of `pack_frame()` whole, in order, laid out the way `app_utils_debug_print.h` says
+ *  	- messages that could never go out (empty, too long) are turned away up front, and counted along with ring-full drops
+ *  	- a frame never splits a message; whatever doesn't fit waits for the next one
+ *  	- a thread printing while the main thread packs frames (i.e. an ISR printing while the bulk link drains) never garbles anything
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+#include "host_test.h"
+
+#include "app_utils_debug_print.h"
+
+//same as `Parser::MAX_PAYLOAD_LENGTH`; what the bulk link hands `pack_frame()`
+static constexpr size_t PAYLOAD_LENGTH = 248;
+
+static uint32_t unpack_u32(const uint8_t* bytes) {
+	return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 8) | (uint32_t)bytes[3];
+}
+
+//pull the messages back out of a packed payload; false if the layout's broken
+static bool unpack_frame(const uint8_t* payload, const size_t length, uint32_t& dropped, std::vector<std::string>& out) {
+	if(length < Debug_Print::MESSAGES_START_INDEX) return false;
+	dropped = unpack_u32(payload + Debug_Print::DROPPED_INDEX);
+	for(size_t index = Debug_Print::MESSAGES_START_INDEX; index < length;) {
+		size_t message_length = payload[index++];
+		if(message_length == 0 || index + message_length > length) return false;
+		out.emplace_back(reinterpret_cast<const char*>(payload + index), message_length);
+		index += message_length;
+	}
+	return true;
+}
+
+static void test_basics() {
+	static Debug_Print db; //ring storage is a couple kB; keep it off the stack
+	std::array<uint8_t, PAYLOAD_LENGTH> payload;
+	CHECK(!db.frame_ready());
+	CHECK(db.pack_frame(payload) == 0);
+
+	//in order, whole, laid out as documented
+	CHECK(db.print("hello"));
+	CHECK(db.print("current 1.250 A\r\n"));
+	CHECK(db.frame_ready());
+	size_t length = db.pack_frame(payload);
+	CHECK(length == Debug_Print::MESSAGES_START_INDEX + 1 + 5 + 1 + 17);
+	uint32_t dropped = 0;
+	std::vector<std::string> received;
+	CHECK(unpack_frame(payload.data(), length, dropped, received));
+	CHECK(dropped == 0);
+	CHECK(received.size() == 2 && received[0] == "hello" && received[1] == "current 1.250 A\r\n");
+	CHECK(!db.frame_ready());
+
+	//messages that could never go out get turned away and counted
+	CHECK(!db.print(""));
+	CHECK(!db.print(std::string(Debug_Print::MESSAGE_MAX_LENGTH + 1, 'x')));
+	CHECK(db.get_dropped_count() == 2);
+	CHECK(!db.frame_ready());
+
+	//the longest message we take fits in a frame on its own
+	CHECK(db.print(std::string(Debug_Print::MESSAGE_MAX_LENGTH, 'y')));
+	length = db.pack_frame(payload);
+	received.clear();
+	CHECK(unpack_frame(payload.data(), length, dropped, received));
+	CHECK(dropped == 2);
+	CHECK(received.size() == 1 && received[0] == std::string(Debug_Print::MESSAGE_MAX_LENGTH, 'y'));
+
+	//a frame stops short of a message that doesn't fit rather than splitting it, and too small a payload gets nothing
+	CHECK(db.print(std::string(150, 'a')));
+	CHECK(db.print(std::string(150, 'b')));
+	CHECK(db.pack_frame(std::span<uint8_t>(payload.data(), 3)) == 0);
+	length = db.pack_frame(payload);
+	received.clear();
+	CHECK(unpack_frame(payload.data(), length, dropped, received));
+	CHECK(received.size() == 1 && received[0] == std::string(150, 'a'));
+	CHECK(db.frame_ready());
+	length = db.pack_frame(payload);
+	received.clear();
+	CHECK(unpack_frame(payload.data(), length, dropped, received));
+	CHECK(received.size() == 1 && received[0] == std::string(150, 'b'));
+	CHECK(!db.frame_ready());
+
+	//a full ring drops and counts, and the count goes out with the next frame
+	size_t printed = 0;
+	while(db.print("filling up the ring")) printed++;
+	CHECK(printed > 0);
+	CHECK(db.get_dropped_count() == 3);
+	received.clear();
+	while(db.frame_ready()) {
+		length = db.pack_frame(payload);
+		CHECK(unpack_frame(payload.data(), length, dropped, received));
+		CHECK(dropped == 3);
+	}
+	CHECK(received.size() == printed);
+}
+
+static void test_threaded() {
+	static constexpr uint32_t MESSAGES = 100000;
+
+	static Debug_Print db;
+	std::atomic<bool> done{false};
+	uint32_t accepted = 0;
+
+	std::thread producer([&]() {
+		char text[64];
+		for(uint32_t i = 0; i < MESSAGES; i++) {
+			int length = snprintf(text, sizeof(text), "message %u of %u%.*s", accepted, MESSAGES, (int)(i % 23), "......................");
+			if(db.print(std::string_view(text, (size_t)length))) accepted++;
+			else std::this_thread::yield();
+		}
+		done.store(true);
+	});
+
+	//drain on this thread, the way the bulk link does; every message has to come out whole and in sequence
+	std::array<uint8_t, PAYLOAD_LENGTH> payload;
+	uint32_t received = 0;
+	size_t bad = 0;
+	while(true) {
+		bool finished = done.load();
+		size_t length = db.pack_frame(payload);
+		if(length == 0) {
+			if(finished && !db.frame_ready()) break;
+			std::this_thread::yield();
+			continue;
+		}
+		uint32_t dropped;
+		std::vector<std::string> messages;
+		if(!unpack_frame(payload.data(), length, dropped, messages)) bad++;
+		for(const std::string& message : messages) {
+			unsigned int sequence, total;
+			if(sscanf(message.c_str(), "message %u of %u", &sequence, &total) != 2 || sequence != received || total != MESSAGES) bad++;
+			received++;
+		}
+	}
+	producer.join();
+
+	CHECK(bad == 0);
+	CHECK(received == accepted);
+	CHECK(accepted + db.get_dropped_count() == MESSAGES);
+	printf("threaded: %u messages through, %u dropped\n", accepted, db.get_dropped_count());
+}
+
+int main() {
+	test_basics();
+	test_threaded();
+	return TEST_RESULT();
+}
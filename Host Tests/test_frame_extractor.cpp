@@ -0,0 +1,212 @@
+/*
+ * test_frame_extractor.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  `UART_Frame_Extractor` against a fake DMA: bytes get written into a plain ring and `service()` gets called
+ *  with wherever the "DMA" is, the same way the idle line and half/full transfer interrupts would call it
+ *  	- frames come out the same no matter where the service calls land (mid frame, across the ring wrap, on the ring size itself)
+ *  	- a full queue, an oversized frame and a decoder rejection each throw away exactly one frame and count it
+ *  	- `reset()` drops a half received frame but leaves completed ones alone
+ */
+
+#include <stdint.h>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "host_test.h"
+
+#include "app_hal_uart_frame_extractor.h"
+#include "app_utils_frame_queue.h"
+
+static constexpr uint8_t SOF = 0xFF;
+static constexpr uint8_t EOF_CHAR = 0x00;
+static constexpr size_t QUEUE_DEPTH = 4;
+static constexpr size_t SLOT_SIZE = 32;
+static constexpr size_t RING_SIZE = 64;
+
+//pretends to be the circular receive DMA
+struct Fake_UART {
+	std::vector<uint8_t> ring = std::vector<uint8_t>(RING_SIZE);
+	std::vector<uint8_t> storage = std::vector<uint8_t>(QUEUE_DEPTH * SLOT_SIZE);
+	std::vector<size_t> lengths = std::vector<size_t>(QUEUE_DEPTH);
+	Frame_Queue frames{storage, lengths};
+	UART_Frame_Extractor extractor;
+	size_t dma_index = 0;
+
+	Fake_UART(UART_Frame_Decoder* decoder = nullptr): extractor(SOF, EOF_CHAR, ring, frames, decoder) {}
+
+	//write bytes into the ring without telling anybody
+	void arrive(const std::vector<uint8_t>& bytes) {
+		for(uint8_t b : bytes) {
+			ring[dma_index] = b;
+			dma_index = (dma_index + 1) % RING_SIZE;
+		}
+	}
+
+	//and the interrupt; the DMA counter reads 0 right at transfer complete, i.e. a write index of the full ring size
+	void interrupt() { extractor.service((dma_index == 0) ? RING_SIZE : dma_index); }
+
+	std::vector<uint8_t> pop() {
+		auto frame = frames.front();
+		std::vector<uint8_t> out(frame.begin(), frame.end());
+		frames.pop();
+		return out;
+	}
+};
+
+static std::vector<uint8_t> make_frame(std::mt19937& rng, const size_t body_length) {
+	std::vector<uint8_t> frame = {SOF};
+	for(size_t i = 0; i < body_length; i++) frame.push_back((uint8_t)(1 + rng() % 0xFE));
+	frame.push_back(EOF_CHAR);
+	return frame;
+}
+
+//decoder that just XORs bytes into the slot, and turns down any frame holding a 0x42
+class Test_Decoder : public UART_Frame_Decoder {
+public:
+	void start(std::span<uint8_t, std::dynamic_extent> slot) override { frame = slot; starts++; }
+	bool feed(const size_t index, const uint8_t byte) override {
+		if(byte == 0x42) return false;
+		frame[index - 1] = byte ^ 0x5A;
+		length = index;
+		return true;
+	}
+	size_t finish(const size_t index) override { return (index == length + 1) ? length : 0; }
+	std::span<uint8_t, std::dynamic_extent> frame;
+	size_t length = 0;
+	size_t starts = 0;
+};
+
+//frames split at every possible point, across the wrap, with garbage between them
+static void test_split_frames(std::mt19937& rng) {
+	Fake_UART uart;
+	for(size_t it = 0; it < 2000; it++) {
+		std::vector<uint8_t> frame = make_frame(rng, rng() % (SLOT_SIZE - 2));
+		std::vector<uint8_t> garbage(rng() % 4, 0x33); //no SOF in here, so it's just ignored
+
+		std::vector<uint8_t> bytes = garbage;
+		bytes.insert(bytes.end(), frame.begin(), frame.end());
+
+		//deliver it in a random number of bursts, with an interrupt after each
+		size_t sent = 0;
+		while(sent < bytes.size()) {
+			size_t burst = std::min<size_t>(1 + rng() % 8, bytes.size() - sent);
+			uart.arrive(std::vector<uint8_t>(bytes.begin() + sent, bytes.begin() + sent + burst));
+			sent += burst;
+			uart.interrupt();
+			if(sent < bytes.size()) CHECK(uart.frames.empty()); //nothing gets published before its EOF
+		}
+
+		//and sometimes a spurious interrupt with nothing new (i.e. half transfer right after an idle line)
+		if(rng() % 4 == 0) uart.interrupt();
+
+		CHECK(uart.frames.size() == 1);
+		CHECK(uart.pop() == frame);
+	}
+	CHECK(uart.extractor.get_dropped_count() == 0);
+	CHECK(uart.extractor.get_overflow_count() == 0);
+}
+
+//a SOF in the middle of a frame starts over; an EOF without a SOF is ignored
+static void test_framing() {
+	Fake_UART uart;
+	uart.arrive({0x11, EOF_CHAR, SOF, 0x01, 0x02, SOF, 0x03, EOF_CHAR});
+	uart.interrupt();
+	CHECK(uart.frames.size() == 1);
+	CHECK(uart.pop() == std::vector<uint8_t>({SOF, 0x03, EOF_CHAR}));
+}
+
+static void test_queue_full() {
+	std::mt19937 rng(3);
+	Fake_UART uart;
+
+	//fill every slot, then one more
+	std::vector<std::vector<uint8_t>> sent;
+	for(size_t i = 0; i < QUEUE_DEPTH + 1; i++) {
+		sent.push_back(make_frame(rng, 5));
+		uart.arrive(sent.back());
+	}
+	uart.interrupt();
+	CHECK(uart.frames.full());
+	CHECK(uart.extractor.get_dropped_count() == 1);
+
+	//the first ones make it; the one that showed up to a full queue doesn't
+	for(size_t i = 0; i < QUEUE_DEPTH; i++) CHECK(uart.pop() == sent[i]);
+	CHECK(uart.frames.empty());
+
+	//and once there's room again, frames go through like normal
+	auto frame = make_frame(rng, 5);
+	uart.arrive(frame);
+	uart.interrupt();
+	CHECK(uart.pop() == frame);
+}
+
+static void test_overflow() {
+	std::mt19937 rng(4);
+	Fake_UART uart;
+
+	//biggest frame that fits (SOF + body + EOF == slot), then one byte too many
+	auto fits = make_frame(rng, SLOT_SIZE - 2);
+	auto too_long = make_frame(rng, SLOT_SIZE - 1);
+	uart.arrive(fits);
+	uart.interrupt();
+	uart.arrive(too_long);
+	uart.interrupt();
+	CHECK(uart.frames.size() == 1);
+	CHECK(uart.pop() == fits);
+	CHECK(uart.extractor.get_overflow_count() == 1);
+}
+
+static void test_decoder() {
+	std::mt19937 rng(5);
+	Test_Decoder decoder;
+	Fake_UART uart(&decoder);
+
+	//good frame; what's published is whatever the decoder made of it
+	auto frame = make_frame(rng, 10);
+	std::replace(frame.begin(), frame.end(), (uint8_t)0x42, (uint8_t)0x43);
+	uart.arrive(frame);
+	uart.interrupt();
+	auto decoded = uart.pop();
+	CHECK(decoded.size() == 10);
+	for(size_t i = 0; i < decoded.size(); i++) CHECK(decoded[i] == (frame[i + 1] ^ 0x5A));
+
+	//a frame the decoder bails on mid-way never gets published, and doesn't take the next one down with it
+	uart.arrive({SOF, 0x01, 0x42, 0x03, EOF_CHAR});
+	uart.arrive(frame);
+	uart.interrupt();
+	CHECK(uart.frames.size() == 1);
+	CHECK(uart.extractor.get_reject_count() == 1);
+	CHECK(uart.pop().size() == 10);
+	CHECK(decoder.starts == 3);
+}
+
+static void test_reset() {
+	Fake_UART uart;
+	uart.arrive({SOF, 0x01, EOF_CHAR, SOF, 0x02});
+	uart.interrupt();
+	CHECK(uart.frames.size() == 1);
+
+	//DMA restarts from the top of the ring (i.e. after an overrun); the half frame is gone, the complete one isn't
+	uart.extractor.reset();
+	uart.dma_index = 0;
+	uart.arrive({0x03, EOF_CHAR, SOF, 0x04, EOF_CHAR});
+	uart.interrupt();
+	CHECK(uart.frames.size() == 2);
+	CHECK(uart.pop() == std::vector<uint8_t>({SOF, 0x01, EOF_CHAR}));
+	CHECK(uart.pop() == std::vector<uint8_t>({SOF, 0x04, EOF_CHAR}));
+}
+
+int main() {
+	std::mt19937 rng(1);
+	test_split_frames(rng);
+	test_framing();
+	test_queue_full();
+	test_overflow();
+	test_decoder();
+	test_reset();
+	return TEST_RESULT();
+}
@@ -0,0 +1,146 @@
+/*
+ * test_frame_queue.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  `Frame_Queue` with a real producer thread standing in for the receive ISR and the main thread as the consumer
+ *  	- every frame comes out once, in order, with exactly the contents and length it went in with
+ *  	- the producer never gets handed a slot the consumer is still reading, and is turned away when the queue's full
+ *  Plus the single-threaded corner cases: empty/full, oversized pushes, and the power-of-two slot count
+ *
+ *  Threads on a host aren't an ISR preempting the main loop, but they do interleave at every possible point (and on more than
+ *  one core, with real reordering), which is the harder case for the acquire/release handoff
+ */
+
+#include <stdint.h>
+#include <random>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+#include "host_test.h"
+
+#include "app_utils_frame_queue.h"
+
+static constexpr size_t QUEUE_DEPTH = 4;
+static constexpr size_t SLOT_SIZE = 64;
+static constexpr size_t HEADER_LENGTH = 4; //every frame starts with its sequence number
+
+static void test_basics() {
+	std::vector<uint8_t> storage(QUEUE_DEPTH * SLOT_SIZE);
+	std::vector<size_t> lengths(QUEUE_DEPTH);
+	Frame_Queue queue(storage, lengths);
+
+	CHECK(queue.empty() && !queue.full());
+	CHECK(queue.front().empty());
+	CHECK(queue.capacity() == QUEUE_DEPTH && queue.slot_size() == SLOT_SIZE);
+	queue.pop(); //does nothing on an empty queue
+	CHECK(queue.size() == 0);
+
+	//too long for a slot
+	CHECK(!queue.push(SLOT_SIZE + 1));
+
+	//fill it up, check it's full, and drain it again
+	for(size_t i = 0; i < QUEUE_DEPTH; i++) {
+		auto slot = queue.write_slot();
+		CHECK(slot.size() == SLOT_SIZE);
+		slot[0] = (uint8_t)i;
+		CHECK(queue.push(i + 1));
+	}
+	CHECK(queue.full());
+	CHECK(queue.write_slot().empty());
+	CHECK(!queue.push(1));
+	for(size_t i = 0; i < QUEUE_DEPTH; i++) {
+		auto frame = queue.front();
+		CHECK(frame.size() == i + 1 && frame[0] == (uint8_t)i);
+		queue.pop();
+	}
+	CHECK(queue.empty());
+}
+
+//slot counts that aren't a power of two get rounded down, so slots keep lining up when the free-running counters wrap
+static void test_power_of_two() {
+	for(size_t count : {1, 2, 3, 5, 6, 7, 8, 9, 100}) {
+		std::vector<uint8_t> storage(count * 16);
+		std::vector<size_t> lengths(count);
+		Frame_Queue queue(storage, lengths);
+
+		size_t expected = 1;
+		while(expected * 2 <= count) expected *= 2;
+		CHECK(queue.capacity() == expected);
+		CHECK(queue.slot_size() == storage.size() / expected);
+
+		//and the slots it hands out stay inside the storage, and cycle through all of them in order
+		for(size_t i = 0; i < 3 * expected; i++) {
+			auto slot = queue.write_slot();
+			CHECK(slot.data() == storage.data() + (i % expected) * queue.slot_size());
+			CHECK(slot.data() + slot.size() <= storage.data() + storage.size());
+			CHECK(queue.push(1));
+			queue.pop();
+		}
+	}
+}
+
+static void test_stress(const size_t frame_count) {
+	std::vector<uint8_t> storage(QUEUE_DEPTH * SLOT_SIZE);
+	std::vector<size_t> lengths(QUEUE_DEPTH);
+	Frame_Queue queue(storage, lengths);
+	std::atomic<size_t> rejected_pushes{0};
+
+	//producer: like the receive ISR, it writes a frame straight into the slot it was handed and publishes it
+	//when the queue's full it gets turned away; it just keeps asking (yielding so this doesn't crawl on a single core)
+	std::thread producer([&]() {
+		std::mt19937 rng(2);
+		for(uint32_t seq = 0; seq < frame_count; seq++) {
+			std::span<uint8_t> slot;
+			while((slot = queue.write_slot()).empty()) {
+				rejected_pushes++;
+				std::this_thread::yield();
+			}
+
+			//fill the frame from the sequence number so the consumer can check every byte
+			size_t length = HEADER_LENGTH + rng() % (SLOT_SIZE - HEADER_LENGTH + 1);
+			for(size_t i = 0; i < HEADER_LENGTH; i++) slot[i] = (uint8_t)(seq >> (8 * i));
+			for(size_t i = HEADER_LENGTH; i < length; i++) slot[i] = (uint8_t)(seq * 31 + i);
+			CHECK(queue.push(length));
+		}
+	});
+
+	//consumer: the main loop
+	std::mt19937 rng(3);
+	size_t bad_frames = 0;
+	for(uint32_t seq = 0; seq < frame_count; ) {
+		auto frame = queue.front();
+		if(frame.empty()) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		uint32_t frame_seq = 0;
+		for(size_t i = 0; i < HEADER_LENGTH; i++) frame_seq |= (uint32_t)frame[i] << (8 * i);
+		bool good = frame.size() >= HEADER_LENGTH && frame_seq == seq;
+		for(size_t i = HEADER_LENGTH; good && i < frame.size(); i++) good = frame[i] == (uint8_t)(seq * 31 + i);
+
+		//hang onto the frame for a bit every so often, so the producer catches up and fills the queue
+		//if it ever got handed this slot while we're still on it, the re-check below catches the scribbled-over bytes
+		if(rng() % 16 == 0) std::this_thread::yield();
+		for(size_t i = HEADER_LENGTH; good && i < frame.size(); i++) good = frame[i] == (uint8_t)(seq * 31 + i);
+		if(!good) bad_frames++;
+
+		queue.pop();
+		seq++;
+	}
+	producer.join();
+
+	CHECK(bad_frames == 0);
+	CHECK(queue.empty());
+	printf("stress: %zu frames, %zu pushes turned away on a full queue\n", frame_count, rejected_pushes.load());
+}
+
+int main() {
+	test_basics();
+	test_power_of_two();
+	test_stress(200000);
+	return TEST_RESULT();
+}
@@ -0,0 +1,202 @@
+/*
+ * test_record_ring.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  `Record_Ring` is what the trace log leans on to take events from any context, so check:
+ *  	- records come back whole and in order, including across the end of the ring (PADDING records)
+ *  	- a full ring drops (and counts) records rather than overwriting anything; so do zero-length records
+ *  	- a bunch of producer threads hammering the ring while a consumer drains it never tears or reorders a record
+ *  	  (threads stand in for ISRs preempting each other; a host is a much meaner scheduler than the NVIC)
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <array>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+#include "host_test.h"
+
+#include "app_utils_record_ring.h"
+
+//fill a record with a pattern that depends on who wrote it and when, so a torn or stale record can't pass for a good one
+static void fill_record(std::span<uint8_t> record, const uint8_t producer, const uint32_t sequence) {
+	record[0] = producer;
+	memcpy(record.data() + 1, &sequence, sizeof(sequence));
+	for(size_t i = 5; i < record.size(); i++) record[i] = (uint8_t)(producer * 31 + sequence * 7 + i);
+}
+
+static bool record_good(std::span<uint8_t> record, uint8_t& producer, uint32_t& sequence) {
+	if(record.size() < 5) return false;
+	producer = record[0];
+	memcpy(&sequence, record.data() + 1, sizeof(sequence));
+	for(size_t i = 5; i < record.size(); i++)
+		if(record[i] != (uint8_t)(producer * 31 + sequence * 7 + i)) return false;
+	return true;
+}
+
+static void test_basics() {
+	std::array<uint32_t, 16> storage;
+	Record_Ring ring(storage);
+	CHECK(ring.empty());
+	CHECK(ring.front().empty());
+	CHECK(ring.capacity() == 64);
+
+	//in order, whole
+	for(uint32_t i = 0; i < 3; i++) {
+		uint8_t bytes[9];
+		fill_record(bytes, 1, i);
+		CHECK(ring.write(std::span<const uint8_t>(bytes, sizeof(bytes))));
+	}
+	for(uint32_t i = 0; i < 3; i++) {
+		uint8_t producer; uint32_t sequence;
+		auto record = ring.front();
+		CHECK(record.size() == 9);
+		CHECK(record_good(record, producer, sequence) && producer == 1 && sequence == i);
+		ring.pop();
+	}
+	CHECK(ring.empty());
+
+	//claimed but not committed yet holds up everything behind it
+	auto first = ring.claim(8);
+	auto second = ring.claim(8);
+	CHECK(!first.empty() && !second.empty());
+	fill_record(second, 2, 1);
+	ring.commit(second);
+	CHECK(ring.front().empty());
+	fill_record(first, 2, 0);
+	ring.commit(first);
+	uint8_t producer; uint32_t sequence;
+	CHECK(record_good(ring.front(), producer, sequence) && sequence == 0);
+	ring.pop();
+	CHECK(record_good(ring.front(), producer, sequence) && sequence == 1);
+	ring.pop();
+	CHECK(ring.empty());
+
+	//6-word records don't divide the ring evenly, so these keep landing across the end of it (behind PADDING records)
+	bool wrapped = false;
+	for(uint32_t i = 0; i < 20; i++) {
+		auto record = ring.claim(20);
+		CHECK(record.size() == 20);
+		if(record.empty()) break;
+		wrapped |= record.data() == reinterpret_cast<uint8_t*>(&storage[1]);
+		fill_record(record, 3, i);
+		ring.commit(record);
+		CHECK(ring.front().size() == 20 && record_good(ring.front(), producer, sequence) && producer == 3 && sequence == i);
+		ring.pop();
+		CHECK(ring.empty());
+	}
+	CHECK(wrapped);
+
+	//a header landing in the very last word of the ring: even the shortest record needs a PADDING word and goes back to the start
+	//walk the head up to the last word with 2-word records (and a 3-word one to fix up the parity if need be)
+	size_t next_header = 0;
+	for(size_t i = 0; i < 2 * storage.size() && next_header != storage.size() - 1; i++) {
+		auto record = ring.claim(next_header == storage.size() - 2 ? 8 : 4);
+		CHECK(!record.empty());
+		if(record.empty()) break;
+		fill_record(record, 5, i);
+		ring.commit(record);
+		next_header = (reinterpret_cast<uint32_t*>(record.data()) - storage.data()) + (record.size() + 3) / 4;
+		ring.pop();
+	}
+	CHECK(next_header == storage.size() - 1);
+	auto last = ring.claim(1);
+	CHECK(last.data() == reinterpret_cast<uint8_t*>(&storage[1]) && last.size() == 1);
+	if(!last.empty()) {
+		last[0] = 0xA5;
+		ring.commit(last);
+		CHECK(ring.front().size() == 1 && ring.front()[0] == 0xA5);
+		ring.pop();
+	}
+	CHECK(ring.empty());
+
+	//zero-length records get turned away (and counted) rather than handing back a span with nowhere to put its header
+	uint32_t dropped_before = ring.get_dropped_count();
+	CHECK(ring.claim(0).empty());
+	CHECK(!ring.write(std::span<const uint8_t>()));
+	CHECK(ring.get_dropped_count() == dropped_before + 2);
+	CHECK(ring.empty());
+
+	//full ring drops and counts; nothing already in there gets touched
+	uint32_t dropped = ring.get_dropped_count();
+	size_t written = 0;
+	while(true) {
+		uint8_t bytes[12];
+		fill_record(bytes, 4, written);
+		if(!ring.write(std::span<const uint8_t>(bytes, sizeof(bytes)))) break;
+		written++;
+	}
+	CHECK(ring.get_dropped_count() == dropped + 1);
+	CHECK(ring.claim(ring.capacity()).empty()); //longer than the whole ring
+	CHECK(ring.get_dropped_count() == dropped + 2);
+	for(size_t i = 0; i < written; i++) {
+		CHECK(record_good(ring.front(), producer, sequence) && producer == 4 && sequence == i);
+		ring.pop();
+	}
+	CHECK(ring.empty());
+}
+
+static void test_threaded() {
+	static constexpr size_t PRODUCERS = 4;
+	static constexpr uint32_t RECORDS_PER_PRODUCER = 200000;
+
+	std::array<uint32_t, 256> storage;
+	Record_Ring ring(storage);
+	std::atomic<size_t> producers_done{0};
+	std::array<uint32_t, PRODUCERS> accepted{};
+
+	std::vector<std::thread> producers;
+	for(size_t p = 0; p < PRODUCERS; p++) {
+		producers.emplace_back([&, p]() {
+			uint32_t next = 0;
+			for(uint32_t i = 0; i < RECORDS_PER_PRODUCER; i++) {
+				//mix of lengths so records keep landing across the end of the ring
+				size_t length = 5 + (i * 13 + p * 5) % 60;
+				auto record = ring.claim(length);
+				if(record.empty()) {
+					std::this_thread::yield();
+					continue;
+				}
+				fill_record(record, (uint8_t)p, next++);
+				ring.commit(record);
+			}
+			accepted[p] = next;
+			producers_done.fetch_add(1);
+		});
+	}
+
+	//drain on this thread; each producer's records have to show up whole, and in the order that producer wrote them
+	std::array<uint32_t, PRODUCERS> received{};
+	size_t bad = 0;
+	while(true) {
+		bool done = producers_done.load() == PRODUCERS;
+		auto record = ring.front();
+		if(record.empty()) {
+			if(done && ring.empty()) break;
+			std::this_thread::yield();
+			continue;
+		}
+		uint8_t producer; uint32_t sequence;
+		if(!record_good(record, producer, sequence) || producer >= PRODUCERS || sequence != received[producer]) bad++;
+		else received[producer]++;
+		ring.pop();
+	}
+	for(auto& thread : producers) thread.join();
+
+	CHECK(bad == 0);
+	CHECK(received == accepted);
+	uint32_t total_accepted = 0;
+	for(uint32_t count : accepted) total_accepted += count;
+	CHECK(total_accepted + ring.get_dropped_count() == PRODUCERS * RECORDS_PER_PRODUCER);
+	printf("threaded: %u records through, %u dropped\n", total_accepted, ring.get_dropped_count());
+}
+
+int main() {
+	test_basics();
+	test_threaded();
+	return TEST_RESULT();
+}
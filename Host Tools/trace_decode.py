@@ -0,0 +1,287 @@
+#!/usr/bin/env python3
+"""
+trace_decode.py
+
+ Created on: Oct 16, 2026
+     Author: Ishaan
+
+Turns the binary trace stream (DEVICE_TRACE frames) back into text on the host
+
+The device only ever sends an event ID, a timestamp and raw argument bits (see `app_utils_trace.h`)
+so this pulls the format strings straight out of the firmware's `app_utils_trace_formats.h`
+and does all the formatting over here, where cycles are cheap
+
+Reads from a serial port (needs pyserial) or from a raw capture of the link:
+    trace_decode.py --port /dev/ttyUSB0 --baud 115200 --start
+    trace_decode.py --file capture.bin
+
+Debug text the firmware prints (DEVICE_DEBUG_TEXT frames, see `app_utils_debug_print.h`) gets interleaved with the trace as it arrives
+Everything else (responses, telemetry, etc.) just gets skipped
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+# ========================== PROTOCOL CONSTANTS (mirror the firmware) ==========================
+
+CHAR_START_OF_FRAME = 0xFF
+CHAR_END_OF_FRAME = 0x00
+BLOCK_OVERHEAD = 2
+BLOCK_LENGTH = 254 # BLOCK_OVERHEAD + BLOCK_DATA_LENGTH
+
+CRC_POLYNOMIAL = 0x1021
+CRC_SEED = 0x1D0F
+
+MESSAGE_TYPE_MASK = 0x0F
+MTYPE_FLAG_EXTENDED = 0x80
+MTYPE_FLAG_SEQUENCED = 0x40
+HOST_COMMAND_TO_DEVICE = 0x1
+DEVICE_TRACE = 0x9
+DEVICE_DEBUG_TEXT = 0xB
+
+CM_TRACE_START = 0x72
+
+# layout of a DEVICE_TRACE payload and the records inside it (see `app_utils_trace.h`)
+TRACE_FRAME_HEADER = struct.Struct(">II") # dropped count, cycle counter frequency
+TRACE_RECORD_HEADER = struct.Struct("<HI") # event ID, timestamp
+TRACE_ARG_LENGTH = 4
+
+# layout of a DEVICE_DEBUG_TEXT payload (see `app_utils_debug_print.h`)
+DEBUG_FRAME_HEADER = struct.Struct(">I") # dropped count
+
+DEFAULT_FORMATS_FILE = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                    "..", "User App", "utils", "app_utils_trace_formats.h")
+
+# =============================================== FORMAT LIST ===============================================
+
+def load_formats(path):
+    """pull every X(NAME, "format") entry out of the format list, in order; the position is the event ID"""
+    with open(path) as f:
+        text = f.read()
+    return [(name, fmt) for name, fmt in re.findall(r'X\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', text)]
+
+def conversions(fmt):
+    """conversion characters in the order they appear, skipping literal percent signs"""
+    return [c for c in re.findall(r"%(.)", fmt) if c != "%"]
+
+def format_event(fmt, arg_bytes):
+    args = []
+    for index, conversion in enumerate(conversions(fmt)):
+        raw = arg_bytes[index * TRACE_ARG_LENGTH:(index + 1) * TRACE_ARG_LENGTH]
+        if len(raw) < TRACE_ARG_LENGTH:
+            return None
+        if conversion == "f":
+            args.append(struct.unpack("<f", raw)[0])
+        elif conversion == "d":
+            args.append(struct.unpack("<i", raw)[0])
+        else:
+            args.append(struct.unpack("<I", raw)[0])
+    return fmt.replace("%u", "%d") % tuple(args)
+
+# =============================================== FRAMING ===============================================
+
+def crc16(data, crc=CRC_SEED):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ CRC_POLYNOMIAL) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+def cobs_decode(frame):
+    """`frame` runs SOF through EOF inclusive; returns the decoded message, or None if the framing's broken"""
+    if len(frame) < 4 or frame[0] != CHAR_START_OF_FRAME or frame[-1] != CHAR_END_OF_FRAME:
+        return None
+    eof_index = len(frame) - 1
+    decoded = bytearray()
+    for block_start in range(1, eof_index, BLOCK_LENGTH):
+        block_end = min(block_start + BLOCK_LENGTH, eof_index)
+        if block_end - block_start < BLOCK_OVERHEAD:
+            return None
+        next_sof = frame[block_start] + block_start
+        next_eof = frame[block_start + 1] + block_start + 1
+        for i in range(block_start + BLOCK_OVERHEAD, block_end):
+            byte = frame[i]
+            if i == next_sof:
+                next_sof += byte
+                byte = CHAR_START_OF_FRAME
+            if i == next_eof:
+                next_eof += byte
+                byte = CHAR_END_OF_FRAME
+            decoded.append(byte)
+        if next_sof != block_end or next_eof != block_end:
+            return None
+    return bytes(decoded)
+
+def cobs_encode(message):
+    """short frames only, which is all we ever need to send"""
+    assert len(message) <= BLOCK_LENGTH - BLOCK_OVERHEAD
+    block = bytearray([0, 0]) + bytearray(message)
+    block_end = len(block)
+    next_sof = next_eof = block_end
+    for i in range(block_end - 1, BLOCK_OVERHEAD - 1, -1):
+        if block[i] == CHAR_START_OF_FRAME:
+            block[i] = next_sof - i
+            next_sof = i
+        if block[i] == CHAR_END_OF_FRAME:
+            block[i] = next_eof - i
+            next_eof = i
+    block[0] = next_sof
+    block[1] = next_eof - 1
+    return bytes([CHAR_START_OF_FRAME]) + bytes(block) + bytes([CHAR_END_OF_FRAME])
+
+def parse_message(message):
+    """returns (address, message type, payload), or None if the message doesn't hold together"""
+    if len(message) < 6 or crc16(message) != 0:
+        return None
+    address, mtype = message[0], message[1]
+    index = 2
+    if mtype & MTYPE_FLAG_EXTENDED:
+        plen = (message[2] << 8) | message[3]
+        index = 4
+    else:
+        plen = message[2]
+        index = 3
+    if mtype & MTYPE_FLAG_SEQUENCED:
+        index += 1
+    payload = message[index:index + plen]
+    if len(payload) != plen or index + plen + 2 != len(message):
+        return None
+    return address, mtype & MESSAGE_TYPE_MASK, payload
+
+def build_command(address, payload):
+    message = bytes([address, HOST_COMMAND_TO_DEVICE, len(payload)]) + bytes(payload)
+    crc = crc16(message)
+    return cobs_encode(message + bytes([crc >> 8, crc & 0xFF]))
+
+class Frame_Splitter:
+    """same SOF/EOF state machine as the firmware's frame extractor"""
+    def __init__(self):
+        self.frame = None
+
+    def feed(self, data):
+        for byte in data:
+            if byte == CHAR_START_OF_FRAME:
+                self.frame = bytearray([byte])
+            elif self.frame is not None:
+                self.frame.append(byte)
+                if byte == CHAR_END_OF_FRAME:
+                    yield bytes(self.frame)
+                    self.frame = None
+
+# =============================================== DECODER ===============================================
+
+class Trace_Decoder:
+    def __init__(self, formats, out):
+        self.formats = formats
+        self.out = out
+        self.last_dropped = None
+        self.last_timestamp = None
+        self.timestamp_offset = 0
+
+    def unwrap(self, timestamp):
+        """the cycle counter wraps every 2^32 cycles; records are (nearly) in order, so a big step backwards means a wrap"""
+        if self.last_timestamp is not None and timestamp < self.last_timestamp and self.last_timestamp - timestamp > (1 << 31):
+            self.timestamp_offset += 1 << 32
+        self.last_timestamp = timestamp
+        return timestamp + self.timestamp_offset
+
+    def frame(self, payload):
+        if len(payload) < TRACE_FRAME_HEADER.size:
+            return
+        dropped, clock_hz = TRACE_FRAME_HEADER.unpack_from(payload, 0)
+        if self.last_dropped is not None and dropped != self.last_dropped:
+            self.out.write("!!! %d events dropped on the device\n" % ((dropped - self.last_dropped) & 0xFFFFFFFF))
+        self.last_dropped = dropped
+
+        index = TRACE_FRAME_HEADER.size
+        while index < len(payload):
+            length = payload[index]
+            record = payload[index + 1:index + 1 + length]
+            index += 1 + length
+            if len(record) != length or length < TRACE_RECORD_HEADER.size:
+                self.out.write("!!! truncated record\n")
+                return
+            event_id, timestamp = TRACE_RECORD_HEADER.unpack_from(record, 0)
+            seconds = self.unwrap(timestamp) / clock_hz if clock_hz else 0.0
+            if event_id >= len(self.formats):
+                self.out.write("[%14.6f] <unknown event %d>\n" % (seconds, event_id))
+                continue
+            name, fmt = self.formats[event_id]
+            text = format_event(fmt, record[TRACE_RECORD_HEADER.size:])
+            if text is None:
+                text = "<%s: missing arguments>" % name
+            self.out.write("[%14.6f] %-16s %s\n" % (seconds, name, text))
+
+class Debug_Text_Decoder:
+    def __init__(self, out):
+        self.out = out
+        self.last_dropped = None
+
+    def frame(self, payload):
+        if len(payload) < DEBUG_FRAME_HEADER.size:
+            return
+        (dropped,) = DEBUG_FRAME_HEADER.unpack_from(payload, 0)
+        if self.last_dropped is not None and dropped != self.last_dropped:
+            self.out.write("!!! %d debug messages dropped on the device\n" % ((dropped - self.last_dropped) & 0xFFFFFFFF))
+        self.last_dropped = dropped
+
+        index = DEBUG_FRAME_HEADER.size
+        while index < len(payload):
+            length = payload[index]
+            text = payload[index + 1:index + 1 + length]
+            index += 1 + length
+            if len(text) != length:
+                self.out.write("!!! truncated debug message\n")
+                return
+            self.out.write("%-16s %s\n" % ("[debug]", text.decode("ascii", errors="replace").rstrip("\r\n")))
+
+def main():
+    parser = argparse.ArgumentParser(description="decode the binary trace stream coming off the device")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="serial port the bulk link is on")
+    source.add_argument("--file", help="raw capture of the link ('-' for stdin)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--address", type=lambda x: int(x, 0), default=0x00, help="device address, for --start")
+    parser.add_argument("--start", action="store_true", help="send TRACE_START before listening")
+    parser.add_argument("--formats", default=DEFAULT_FORMATS_FILE, help="path to app_utils_trace_formats.h")
+    args = parser.parse_args()
+
+    decoder = Trace_Decoder(load_formats(args.formats), sys.stdout)
+    debug_text = Debug_Text_Decoder(sys.stdout)
+    splitter = Frame_Splitter()
+
+    def handle(data):
+        for frame in splitter.feed(data):
+            message = cobs_decode(frame)
+            parsed = parse_message(message) if message is not None else None
+            if parsed is not None and parsed[1] == DEVICE_TRACE:
+                decoder.frame(parsed[2])
+            elif parsed is not None and parsed[1] == DEVICE_DEBUG_TEXT:
+                debug_text.frame(parsed[2])
+        sys.stdout.flush()
+
+    if args.port:
+        import serial # only needed when talking to a live device
+        with serial.Serial(args.port, args.baud, timeout=0.1) as link:
+            if args.start:
+                link.write(build_command(args.address, [CM_TRACE_START]))
+            while True:
+                handle(link.read(4096))
+    else:
+        stream = sys.stdin.buffer if args.file == "-" else open(args.file, "rb")
+        with stream:
+            while True:
+                data = stream.read(4096)
+                if not data:
+                    break
+                handle(data)
+
+if __name__ == "__main__":
+    try:
+        main()
+    except KeyboardInterrupt:
+        pass
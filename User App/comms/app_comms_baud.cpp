@@ -0,0 +1,65 @@
+/*
+ * app_comms_baud.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#include "app_comms_baud.h"
+
+#include "app_hal_timing.h" //for the fallback timeout
+#include "app_utils_trace.h" //to log rate changes
+
+Comms_Baud_Negotiator::Comms_Baud_Negotiator(UART& _uart):
+	uart(_uart)
+{}
+
+bool Comms_Baud_Negotiator::request(const uint32_t baud) {
+	//make sure the hardware can actually do this (and the rest of the link can live with it) before we promise anything
+	if(baud < min_baud || !uart.baud_rate_supported(baud)) return false;
+
+	//the switch itself happens in `loop()`, after the response to this request has gone out
+	pending_baud = baud;
+	state = PENDING;
+	return true;
+}
+
+void Comms_Baud_Negotiator::frame_received() {
+	//host made it over to the new rate--it's here to stay
+	if(state == PROBATION) state = IDLE;
+}
+
+void Comms_Baud_Negotiator::loop() {
+	switch(state) {
+		case PENDING:
+			//wait until the last byte of the ACK is out, otherwise it'd get garbled
+			if(!uart.tx_idle()) return;
+
+			//remember where we came from, and switch over
+			fallback_baud = uart.get_baud_rate();
+			if(!uart.set_baud_rate(pending_baud)) {
+				state = IDLE; //couldn't apply it, so we're still on the old rate; nothing to fall back from
+				return;
+			}
+			switch_time_ms = Timer::get_ms();
+			state = PROBATION;
+			Trace::log<Trace::BAUD_SWITCH>(fallback_baud, pending_baud);
+			return;
+
+		case PROBATION:
+			//host never showed up--go back to the rate we know works
+			if(Timer::get_ms() - switch_time_ms < FALLBACK_TIMEOUT_MS) return;
+			if(!uart.tx_idle()) return; //anything we sent in the meantime has to finish first
+			uart.set_baud_rate(fallback_baud);
+			state = IDLE;
+			Trace::log<Trace::BAUD_FALLBACK>(fallback_baud);
+			return;
+
+		case IDLE:
+		default:
+			return;
+	}
+}
+
+void Comms_Baud_Negotiator::set_min_baud_rate(const uint32_t baud) { min_baud = baud; }
+bool Comms_Baud_Negotiator::switch_pending() { return state == PENDING; }
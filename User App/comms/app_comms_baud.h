@@ -0,0 +1,67 @@
+/*
+ * app_comms_baud.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Lets the host bump the baud rate of the link it's talking to us over, without reflashing
+ *
+ *  The handshake goes:
+ *  	- host sends LINK_SET_BAUD_RATE with the new rate; we check the UART can actually do it, and ACK (at the OLD rate)
+ *  	- once that ACK has completely left the wire, we switch over to the new rate
+ *  	- host switches over too, and sends any valid frame (i.e. a ping) at the new rate
+ *  	- if we don't see a valid frame within FALLBACK_TIMEOUT_MS, we assume the host never made it over and go back to the old rate
+ *  This way a botched switch (host can't do the rate, cable can't handle it, etc.) never leaves the device unreachable
+ */
+
+#ifndef COMMS_APP_COMMS_BAUD_H_
+#define COMMS_APP_COMMS_BAUD_H_
+
+extern "C" {
+	#include "stm32g474xx.h" //for uint32_t
+}
+
+#include "app_hal_uart.h" //the UART we're reconfiguring
+
+class Comms_Baud_Negotiator {
+public:
+	//how long we wait on a valid frame at the new rate before falling back
+	static constexpr uint32_t FALLBACK_TIMEOUT_MS = 1000;
+
+	Comms_Baud_Negotiator(UART& _uart);
+
+	//delete copy constructor and assignment operator; command handlers hang onto a pointer to this
+	Comms_Baud_Negotiator(Comms_Baud_Negotiator const&) = delete;
+	void operator=(Comms_Baud_Negotiator const&) = delete;
+
+	//schedule a switch to the new baud rate; returns false (and changes nothing) if the UART can't do that rate, or it's below the floor
+	bool request(const uint32_t baud);
+
+	//refuse any switch below this rate (i.e. one that would stretch a multi-drop reply slot out too far, see `Comms_Exec_Subsystem`)
+	void set_min_baud_rate(const uint32_t baud);
+
+	//let us know whenever a valid frame comes in--confirms the new rate if we're waiting on that
+	void frame_received();
+
+	//call from the comms loop; applies a scheduled switch once the transmitter drains, and handles the fallback timeout
+	void loop();
+
+	//true while a switch is scheduled but not applied yet--hold off on sending anything that isn't urgent so the transmitter can drain
+	bool switch_pending();
+
+private:
+	enum Negotiation_State_t {
+		IDLE,			//nothing going on
+		PENDING,		//waiting for the transmitter to drain before switching
+		PROBATION,		//switched, waiting for the host to show up at the new rate
+	};
+
+	UART& uart;
+	Negotiation_State_t state = IDLE;
+	uint32_t min_baud = 0; //slowest rate the host is allowed to ask for
+	uint32_t pending_baud = 0; //what we're switching to
+	uint32_t fallback_baud = 0; //what we go back to if the host doesn't show up
+	uint32_t switch_time_ms = 0; //when we switched
+};
+
+#endif /* COMMS_APP_COMMS_BAUD_H_ */
@@ -9,65 +9,92 @@
  *  							[0] [1] [2]       ...		   [input length - 1]
  *  [0] [	 1	  ]	[    2    ] [3] [4] ... [input length + 1] [input length + 2] [input length + 3]
  *  SOF idxOfDelSOF idxOfDelEOF d0	d1	d2	     dn-1			  dn				 EOF
+ *
+ *  Extended frames just repeat the [idxOfDelSOF idxOfDelEOF d...] section once per block
  */
 
 #include <app_comms_cobs.h>
-#include <string.h> //for memcpy
+#include <string.h> //for memcpy, memmove
+#include <algorithm> //for min, max, copy_backward
+
+//================================ WORD-AT-A-TIME HELPERS ================================
+//the classic "has a zero byte" trick: subtracting 1 from every byte only borrows into a byte's top bit if that byte was zero
+//(or already had its top bit set, which `~word` masks back out); exact for answering "is there one anywhere in the word"
+static inline bool has_zero_byte(const uint32_t word) { return ((word - 0x01010101u) & ~word & 0x80808080u) != 0; }
+
+//SOF bytes (0xFF) are the zero bytes of the inverted word, so one trick covers both delimiters
+static inline bool has_delimiter(const uint32_t word) { return has_zero_byte(word) || has_zero_byte(~word); }
+
+//stretches between delimiters at least this long get copied with memmove rather than byte by byte when decoding
+static constexpr size_t MIN_BULK_COPY_LENGTH = 16;
+
+//byte order doesn't matter for the checks above; memcpy since frames aren't necessarily word aligned (compiles down to a single load)
+static inline uint32_t load_word(const uint8_t* bytes) {
+	uint32_t word;
+	memcpy(&word, bytes, sizeof(word));
+	return word;
+}
 
 //empty constructor
 Cobs::Cobs() {}
 
+size_t Cobs::encoded_length(const size_t payload_length) {
+	//always at least one block, even for an empty payload
+	size_t blocks = std::max<size_t>(1, (payload_length + BLOCK_DATA_LENGTH - 1) / BLOCK_DATA_LENGTH);
+	return payload_length + blocks * BLOCK_OVERHEAD + 2;
+}
+
+size_t Cobs::decoded_length(const size_t frame_length) {
+	if(frame_length < Cobs::OVERHEAD) return 0;
+	size_t blocks = (frame_length - 2 + BLOCK_LENGTH - 1) / BLOCK_LENGTH;
+	return frame_length - 2 - blocks * BLOCK_OVERHEAD;
+}
+
 int16_t Cobs::encode(	const std::span<uint8_t, std::dynamic_extent> input_unencoded,
 						std::span<uint8_t, std::dynamic_extent> output_encoded)
 {
 	//sanity check the input length
-	if(input_unencoded.size() > Cobs::MSG_MAX_UNENCODED_LENGTH) return -1;
-
-	//create a local variable for output length
-	size_t output_length = input_unencoded.size() + Cobs::OVERHEAD;
-
 	//and ensure that the output buffer has enough space to store the encoded message
-	if(output_encoded.size() < output_length) return -1;
+	if(input_unencoded.size() > Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH) return -1;
+	if(output_encoded.size() < encoded_length(input_unencoded.size())) return -1;
 
-	//for our COBS encoded message, we'll put our terminating characters in the proper places
-	output_encoded[0] = Cobs::CHAR_START_OF_FRAME;
-	output_encoded[output_length - 1] = Cobs::CHAR_END_OF_FRAME;
-
-	//and copy over the unencoded data to the output array
+	//copy over the unencoded data to the output array
 	//dump data at the third position since [0] is SOF, [1] is overhead byte for SOF, [2] is overhead byte for EOF
 	std::copy(input_unencoded.begin(), input_unencoded.end(), output_encoded.begin() + IDX_START_OF_PAYLOAD);
 
-	//work through the output array to figure out where to put the delimiter indices/offsets
-	size_t next_sof_char_index = output_length - 1;
-	size_t next_eof_char_index = output_length - 1;
+	//and encode it where it sits
+	return encode_in_place(output_encoded, input_unencoded.size());
+}
 
-	//start iterating from back to front, starting at the last byte of our unencoded packet
-	for(size_t i = output_length - 2; i >= IDX_START_OF_PAYLOAD; i--) {
-		//if the character at the particular index matches our SOF
-		if(output_encoded[i] == Cobs::CHAR_START_OF_FRAME) {
-			//replace the character at that index with an offset to the next SOF character we find
-			//make sure to appropriately cast the index variable to a uint8_t
-			output_encoded[i] = (uint8_t)(next_sof_char_index - i);
+int16_t Cobs::encode_in_place(std::span<uint8_t, std::dynamic_extent> output_encoded, const size_t payload_length) {
+	//sanity check the input length
+	if(payload_length > Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH) return -1;
 
-			//and store the current index as the next_delimiter_index
-			next_sof_char_index = i;
-		}
+	//create a local variable for output length
+	size_t output_length = encoded_length(payload_length);
+	size_t blocks = std::max<size_t>(1, (payload_length + BLOCK_DATA_LENGTH - 1) / BLOCK_DATA_LENGTH);
 
-		//do the same kinda thing, but look for EOF characters
-		if(output_encoded[i] == Cobs::CHAR_END_OF_FRAME) {
-			output_encoded[i] = (uint8_t)(next_eof_char_index - i);
-			next_eof_char_index = i;
-		}
+	//and ensure that the output buffer has enough space to store the encoded message
+	if(output_encoded.size() < output_length) return -1;
 
+	//if this is an extended frame, spread the payload out to make room for the overhead bytes of every block after the first
+	//work from the back so nothing gets overwritten before it's moved; the first block is already where it needs to be
+	for(size_t block = blocks - 1; block > 0; block--) {
+		size_t payload_offset = block * BLOCK_DATA_LENGTH;
+		size_t block_data_length = std::min(BLOCK_DATA_LENGTH, payload_length - payload_offset);
+		auto block_data = output_encoded.begin() + IDX_START_OF_PAYLOAD + payload_offset;
+		std::copy_backward(block_data, block_data + block_data_length, block_data + block_data_length + block * BLOCK_OVERHEAD);
 	}
 
-	//at index [1], point to the first SOF char we see in our message
-	output_encoded[1] = next_sof_char_index - 1; //subtracting 1 because we're placing this at the first index
+	//for our COBS encoded message, we'll put our terminating characters in the proper places
+	output_encoded[0] = Cobs::CHAR_START_OF_FRAME;
+	output_encoded[output_length - 1] = Cobs::CHAR_END_OF_FRAME;
 
-	//at index [2], point to the first EOF char we see in our message
-	output_encoded[2] = next_eof_char_index - 2; //subtracting 2 because we're placing this at the second index
+	//and stuff the delimiters block by block
+	for(size_t block_start = 1; block_start < output_length - 1; block_start += BLOCK_LENGTH)
+		encode_block(output_encoded, block_start, std::min(block_start + BLOCK_LENGTH, output_length - 1));
 
-	//return the size of our encoded array; consistent overhead means this is just a fixed amount smaller than the unencoded size
+	//return the size of our encoded array
 	return (int16_t)output_length;
 }
 
@@ -75,50 +102,151 @@ int16_t Cobs::encode(	const std::span<uint8_t, std::dynamic_extent> input_unenco
 int16_t Cobs::decode(	const std::span<uint8_t, std::dynamic_extent> input_encoded,
 						std::span<uint8_t, std::dynamic_extent> output_decoded)
 {
-	//sanity check the input length
-	if(input_encoded.size() > Cobs::MSG_MAX_ENCODED_LENGTH || input_encoded.size() < Cobs::OVERHEAD)
-		return -1;
+	//sanity check the framing of the message
+	if(!frame_valid(input_encoded)) return -1;
 
-	//sanity check that the first character is a start of frame
-	if(input_encoded.front() != Cobs::CHAR_START_OF_FRAME)
+	//sanity check that we have enough space in the output buffer to store the decoded message
+	if(output_decoded.size() < decoded_length(input_encoded.size()))
 		return -1;
 
-	//sanity check that the final character is an end of frame
-	if(input_encoded.back() != Cobs::CHAR_END_OF_FRAME)
-		return -1;
+	//copy the payload over, putting the delimiters back where they belong along the way
+	return restore_delimiters(input_encoded, output_decoded);
+}
 
-	//sanity check that we have enough space in the output buffer to store the decoded message
-	if(output_decoded.size() < input_encoded.size() - Cobs::OVERHEAD)
-		return -1;
+int16_t Cobs::decode_in_place(std::span<uint8_t, std::dynamic_extent> frame) {
+	//sanity check the framing of the message
+	if(!frame_valid(frame)) return -1;
+
+	//the payload is (mostly) already where it needs to be; just put the delimiters back
+	//and close up the gaps left by block overhead bytes if this is an extended frame
+	return restore_delimiters(frame, frame.subspan(IDX_START_OF_PAYLOAD));
+}
+
+//==================================== PRIVATE FUNCTIONS ====================================
 
-	//first, just copy over the payload into the decoded buffer
-	//I think compiler should be able to optimize this process to run significantly faster than iterating
-	std::copy(input_encoded.begin() + IDX_START_OF_PAYLOAD, input_encoded.end() - 1, output_decoded.begin());
+bool Cobs::frame_valid(const std::span<uint8_t, std::dynamic_extent> input_encoded) {
+	//sanity check the input length
+	if(input_encoded.size() > Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH || input_encoded.size() < Cobs::OVERHEAD)
+		return false;
+
+	//no encoder makes a block that stops halfway through its overhead bytes
+	//have to catch it up here; otherwise we'd decode a whole block before noticing, one byte more than `decoded_length()` promised
+	if((input_encoded.size() - 2) % BLOCK_LENGTH == 1) return false;
 
-	//now run elementwise through the encoded message
-	//replacing all "encoded" characters in the output with delimiters
-	size_t next_sof_char_index = input_encoded[1] + 1; //offset by 1 since we're starting at index 1
-	size_t next_eof_char_index = input_encoded[2] + 2; //offset by 2 since we're starting at index 2
+	//sanity check that the first character is a start of frame
+	//and that the final character is an end of frame
+	return input_encoded.front() == Cobs::CHAR_START_OF_FRAME && input_encoded.back() == Cobs::CHAR_END_OF_FRAME;
+}
 
-	for(size_t i = IDX_START_OF_PAYLOAD; i < input_encoded.size() - 1; i++) {
-		//if our index indicates a SOF character in the particular position
-		if(next_sof_char_index == i) {
-			next_sof_char_index += input_encoded[i];
-			output_decoded[i-IDX_START_OF_PAYLOAD] = CHAR_START_OF_FRAME; //indices are offset since we're in the frame of reference of the encoded packet
+void Cobs::encode_block(std::span<uint8_t, std::dynamic_extent> frame, const size_t block_start, const size_t block_end) {
+	//work through the block to figure out where to put the delimiter indices/offsets
+	//chains that don't hit any more delimiters point to the end of the block
+	size_t next_sof_char_index = block_end;
+	size_t next_eof_char_index = block_end;
+
+	//start iterating from back to front, starting at the last byte of the block
+	//`i` is one past the next byte we look at
+	size_t data_start = block_start + BLOCK_OVERHEAD;
+	size_t i = block_end;
+	while(i > data_start) {
+		//most payload bytes aren't delimiters, so check a whole word at a time and skip straight past clean ones
+		//a word that does have a delimiter in it (and any odd bytes at the front of the block) gets handled byte by byte
+		size_t stop = data_start;
+		if(i - data_start >= sizeof(uint32_t)) {
+			if(!has_delimiter(load_word(&frame[i - sizeof(uint32_t)]))) {
+				i -= sizeof(uint32_t);
+				continue;
+			}
+			stop = i - sizeof(uint32_t);
 		}
 
-		//do a similar thing when hunting for EOF characters
-		if(next_eof_char_index == i) {
-			next_eof_char_index += input_encoded[i];
-			output_decoded[i-IDX_START_OF_PAYLOAD] = CHAR_END_OF_FRAME; //indices are offset since we're in the frame of reference of the encoded packet
+		while(i > stop) {
+			i--;
+
+			//if the character at the particular index matches our SOF
+			if(frame[i] == Cobs::CHAR_START_OF_FRAME) {
+				//replace the character at that index with an offset to the next SOF character we find
+				//make sure to appropriately cast the index variable to a uint8_t
+				frame[i] = (uint8_t)(next_sof_char_index - i);
+
+				//and store the current index as the next_delimiter_index
+				next_sof_char_index = i;
+			}
+
+			//do the same kinda thing, but look for EOF characters
+			if(frame[i] == Cobs::CHAR_END_OF_FRAME) {
+				frame[i] = (uint8_t)(next_eof_char_index - i);
+				next_eof_char_index = i;
+			}
 		}
 	}
 
-	//and finally ensure that our delimiter indices point to the last element in our buffer
-	if(next_sof_char_index != (input_encoded.size() - 1)) return -1;
-	if(next_eof_char_index != (input_encoded.size() - 1)) return -1;
+	//first overhead byte points to the first SOF char we see in the block
+	frame[block_start] = (uint8_t)(next_sof_char_index - block_start);
 
-	//return the size of our decoded array; consistent overhead means this is just a fixed amount smaller than the encoded size
-	return (int16_t)(input_encoded.size() - Cobs::OVERHEAD);
+	//second overhead byte points to the first EOF char we see in the block
+	frame[block_start + 1] = (uint8_t)(next_eof_char_index - (block_start + 1));
 }
 
+int16_t Cobs::restore_delimiters(	const std::span<uint8_t, std::dynamic_extent> input_encoded,
+									std::span<uint8_t, std::dynamic_extent> output_decoded)
+{
+	size_t eof_index = input_encoded.size() - 1;
+	size_t output_index = 0;
+
+	//run through the frame one block at a time
+	for(size_t block_start = 1; block_start < eof_index; block_start += BLOCK_LENGTH) {
+		size_t block_end = std::min(block_start + BLOCK_LENGTH, eof_index);
+		if(block_end - block_start < BLOCK_OVERHEAD) return -1; //frame got cut off in the middle of a block's overhead bytes
+
+		//overhead bytes point relative to where they sit
+		size_t next_sof_char_index = input_encoded[block_start] + block_start;
+		size_t next_eof_char_index = input_encoded[block_start + 1] + block_start + 1;
+
+		//run through the encoded block, replacing all "encoded" characters with delimiters
+		//delimiters only ever sit where the chains point, so there's no need to look at anything in between
+		//\--> whenever the nearest chain position is a ways off, copy the whole stretch before it over in one go
+		size_t i = block_start + BLOCK_OVERHEAD;
+		size_t next_delimiter_index = std::min(next_sof_char_index, next_eof_char_index);
+		while(i < block_end) {
+			if(next_delimiter_index >= i + MIN_BULK_COPY_LENGTH) {
+				size_t run_end = std::min(next_delimiter_index, block_end);
+				//memmove since decoding in place overlaps (output only ever sits at or before the input)
+				//and when nothing actually moves (in place, first block), there's nothing to copy at all
+				if(&output_decoded[output_index] != &input_encoded[i])
+					memmove(&output_decoded[output_index], &input_encoded[i], run_end - i);
+				output_index += run_end - i;
+				i = run_end;
+				continue;
+			}
+
+			//otherwise go byte by byte
+			//grab the offset before touching the output--when decoding in place, the output IS the input
+			uint8_t encoded_char = input_encoded[i];
+			uint8_t decoded_char = encoded_char;
+
+			//if our index indicates a SOF character in the particular position
+			if(next_sof_char_index == i) {
+				next_sof_char_index += encoded_char;
+				decoded_char = CHAR_START_OF_FRAME;
+			}
+
+			//do a similar thing when hunting for EOF characters
+			if(next_eof_char_index == i) {
+				next_eof_char_index += encoded_char;
+				decoded_char = CHAR_END_OF_FRAME;
+			}
+
+			//only moves when we just passed a delimiter
+			if(next_delimiter_index == i) next_delimiter_index = std::min(next_sof_char_index, next_eof_char_index);
+
+			output_decoded[output_index++] = decoded_char;
+			i++;
+		}
+
+		//and ensure that our delimiter indices point to the end of the block
+		if(next_sof_char_index != block_end || next_eof_char_index != block_end) return -1;
+	}
+
+	return (int16_t)output_index;
+}
@@ -23,6 +23,18 @@
  *   I'll make sure to comment my code thoroughly to ensure that the functionality of this flavor of COBS makes sense
  *   In total, this implementation of COBS requires 4 overhead bytes total (including SOF and EOF)
  *
+ *  EXTENDED FRAMES: ===========================================================
+ *  The overhead bytes are single bytes, so they can only point ~254 bytes ahead--that's what limits a frame to 256 bytes
+ *  To go longer, a frame is split into BLOCKS, each carrying its own pair of overhead bytes:
+ *   - SOF
+ *   - block 0: [idx of first SOF char in block] [idx of first EOF char in block] <up to BLOCK_DATA_LENGTH payload bytes>
+ *   - block 1: [...] [...] <...>
+ *   - ...
+ *   - EOF
+ *  Every block except the last is completely full; delimiter chains of a block end where the next block (or the EOF) starts
+ *  A single-block frame is EXACTLY the short frame format above, so anything that speaks short frames doesn't notice a difference
+ *  Overhead of a frame with `n` blocks is 2 + 2n bytes
+ *
  *  ========================================================================
  *
  *  My general convention throughout the communication subsystem is to share data between objects using `std::span`s
@@ -34,9 +46,7 @@
 #define INC_APP_COBS_H_
 
 #include <stddef.h> //for size_t
-extern "C" {
-	#include "stm32g474xx.h" //for uint8_t
-}
+#include <stdint.h> //for uint8_t; no device headers here so this builds for the host too
 #include <span> //passing information to and from functions using spans
 
 class Cobs {
@@ -47,6 +57,14 @@ private:
 public:
 	static const size_t MSG_MAX_ENCODED_LENGTH = 256;
 	static const size_t MSG_MAX_UNENCODED_LENGTH = MSG_MAX_ENCODED_LENGTH - OVERHEAD;
+
+	//extended frames are built out of a handful of short-frame-sized blocks
+	static constexpr size_t BLOCK_OVERHEAD = 2; //the two overhead bytes at the start of every block
+	static constexpr size_t BLOCK_DATA_LENGTH = MSG_MAX_UNENCODED_LENGTH; //payload bytes in a full block
+	static constexpr size_t BLOCK_LENGTH = BLOCK_OVERHEAD + BLOCK_DATA_LENGTH;
+	static constexpr size_t MAX_BLOCKS = 4;
+	static constexpr size_t MSG_MAX_EXTENDED_UNENCODED_LENGTH = MAX_BLOCKS * BLOCK_DATA_LENGTH;
+	static constexpr size_t MSG_MAX_EXTENDED_ENCODED_LENGTH = MAX_BLOCKS * BLOCK_LENGTH + 2; //+ SOF and EOF
 	static const size_t IDX_START_OF_PAYLOAD = 3;
 	static const uint8_t CHAR_START_OF_FRAME = 0xFF;
 	static const uint8_t CHAR_END_OF_FRAME = 0x00;
@@ -54,6 +72,10 @@ public:
 	//empty constructor, don't need to do anything really
 	Cobs();
 
+	//how long a payload is once it's encoded, and vice versa (accounting for however many blocks it takes)
+	static size_t encoded_length(const size_t payload_length);
+	static size_t decoded_length(const size_t frame_length);
+
 	//pass the unencoded input via a span
 	//and dump the encoded output into the memory location pointed by the span
 	//return length of the encoded message if encode successful, -1 if not
@@ -66,6 +88,35 @@ public:
 	int16_t decode(	const std::span<uint8_t, std::dynamic_extent> input_encoded,
 							std::span<uint8_t, std::dynamic_extent> output_decoded);
 
+	//===================== ZERO-COPY VARIANTS =====================
+	//since the payload sits at the same offset in both the encoded and unencoded frames, we never actually need to move it
+	//these variants just stuff/unstuff the delimiters where the payload already is
+
+	//`frame` should have the unencoded payload already sitting at [IDX_START_OF_PAYLOAD, IDX_START_OF_PAYLOAD + payload_length)
+	//fills in the SOF, overhead bytes, and EOF around it, and replaces delimiters in the payload
+	//payloads longer than a single block get spread out into an extended frame (shuffling the payload back to make room for block overhead)
+	//return length of the encoded frame if encode successful, -1 if not
+	int16_t encode_in_place(std::span<uint8_t, std::dynamic_extent> frame, const size_t payload_length);
+
+	//`frame` is a complete encoded frame (SOF through EOF)
+	//restores delimiters in the payload, leaving the decoded message at [IDX_START_OF_PAYLOAD, IDX_START_OF_PAYLOAD + return value)
+	//return length of the decoded message if decode successful, -1 if not; frame contents are garbage if decode fails
+	int16_t decode_in_place(std::span<uint8_t, std::dynamic_extent> frame);
+
+private:
+	//run through the encoded frame block by block, writing the payload into `output_decoded` with the delimiters restored
+	//`output_decoded` is allowed to alias the payload section of `input_encoded` (bytes only ever move towards the front)
+	//only looks at the bytes the delimiter chains point to; everything in between gets copied over in bulk
+	//returns the decoded length, or -1 if the overhead bytes don't line up with the end of their blocks
+	int16_t restore_delimiters(	const std::span<uint8_t, std::dynamic_extent> input_encoded,
+								std::span<uint8_t, std::dynamic_extent> output_decoded);
+
+	//stuff the delimiters in a single block occupying [block_start, block_end) of the frame
+	//scans a word at a time, only dropping down to single bytes for words that actually have a delimiter in them
+	void encode_block(std::span<uint8_t, std::dynamic_extent> frame, const size_t block_start, const size_t block_end);
+
+	//sanity check the framing of an encoded message
+	bool frame_valid(const std::span<uint8_t, std::dynamic_extent> input_encoded);
 };
 
 
@@ -0,0 +1,133 @@
+/*
+ * app_comms_cobs_stream.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#include "app_comms_cobs_stream.h"
+#include "app_cmhand_mapping.h" //for the emergency stop command code
+
+Cobs_Stream_Decoder::Cobs_Stream_Decoder(Comms_CRC& _crc_comp, uint32_t (*const _timestamp)()):
+	crc_comp(_crc_comp), timestamp(_timestamp)
+{}
+
+void Cobs_Stream_Decoder::start(std::span<uint8_t, std::dynamic_extent> slot) {
+	//new frame, new slot, fresh CRC
+	frame_buf = slot;
+	running_crc = crc_comp.start_crc();
+
+	//first block starts right after the SOF
+	//point the delimiter chains there too, so the "did the last block's chains end on time" check passes for the first block
+	block_start_index = 1;
+	next_sof_char_index = 1;
+	next_eof_char_index = 1;
+	output_index = IDX_START_OF_PAYLOAD;
+}
+
+bool Cobs_Stream_Decoder::feed(const size_t index, const uint8_t byte) {
+	//first two bytes of every block are the overhead bytes--they point to the first stuffed SOF and EOF characters in the block
+	//offset by where they sit in the frame
+	if(index == block_start_index) {
+		//chains of the previous block should've ended right where this one starts
+		if(next_sof_char_index != index || next_eof_char_index != index) return false;
+		next_sof_char_index = index + byte;
+		return true;
+	}
+	if(index == block_start_index + 1) {
+		next_eof_char_index = index + byte;
+		return true;
+	}
+
+	//for the payload, restore any stuffed delimiters and follow the chain to the next one
+	uint8_t decoded_byte = byte;
+	if(index == next_sof_char_index) {
+		next_sof_char_index += byte;
+		decoded_byte = Cobs::CHAR_START_OF_FRAME;
+	}
+	if(index == next_eof_char_index) {
+		//both chains landing on the same byte can't come out of a valid encoder
+		if(decoded_byte == Cobs::CHAR_START_OF_FRAME) return false;
+		next_eof_char_index += byte;
+		decoded_byte = Cobs::CHAR_END_OF_FRAME;
+	}
+
+	//drop the decoded byte into the slot and fold it into the CRC
+	//for the first block this is right where the byte arrived; later blocks get shifted forward over the overhead bytes before them
+	frame_buf[output_index++] = decoded_byte;
+	running_crc = crc_comp.update_crc(running_crc, decoded_byte);
+
+	//as soon as the ID and MTYPE are in, see if this frame is any of our business
+	//anything a device sent (i.e. another device's response) isn't, and neither is anything addressed to another device
+	if(filtering && output_index == IDX_START_OF_PAYLOAD + Parser::MTYPE_INDEX + 1) {
+		uint8_t message_type = decoded_byte & Parser::MESSAGE_TYPE_MASK;
+		bool from_device = message_type >= Parser::DEVICE_NACK_HOST_MESSAGE && message_type <= Parser::DEVICE_DEBUG_TEXT;
+		if(from_device || !Parser::addressed_to(frame_buf[IDX_START_OF_PAYLOAD + Parser::ID_INDEX], decoded_byte, address)) {
+			filtered_count = filtered_count + 1;
+			return false;
+		}
+	}
+
+	//if that was the last byte of a full block, the next block starts right after it
+	if(index + 1 == block_start_index + Cobs::BLOCK_LENGTH) block_start_index = index + 1;
+	return true;
+}
+
+size_t Cobs_Stream_Decoder::finish(const size_t index) {
+	//stamp the EOF before doing anything else with the frame
+	uint32_t eof_timestamp = (timestamp != nullptr) ? timestamp() : 0;
+
+	//need at least one byte of decoded message
+	if(output_index <= IDX_START_OF_PAYLOAD) return 0;
+
+	//both delimiter chains should end right at the EOF; if they don't, the frame got mangled on the way in
+	if(next_sof_char_index != index || next_eof_char_index != index) return 0;
+
+	//record how the CRC check went, and publish the frame up to the last decoded byte
+	bool crc_ok = crc_comp.check_crc(running_crc);
+	frame_buf[STATUS_INDEX] = crc_ok ? STATUS_CRC_GOOD : STATUS_CRC_BAD;
+
+	//an emergency stop can't wait for the main loop; handle it right here, before anything else
+	if(crc_ok && emergency_stop_func != nullptr && is_emergency_stop(frame_buf.subspan(IDX_START_OF_PAYLOAD, output_index - IDX_START_OF_PAYLOAD), address))
+		emergency_stop_func(emergency_stop_context, eof_timestamp);
+
+	//and record when it landed
+	uint32_t arrival = (eof_timestamp >> ARRIVAL_SHIFT) & ARRIVAL_MASK;
+	frame_buf[ARRIVAL_INDEX] = (uint8_t)(arrival >> 8);
+	frame_buf[ARRIVAL_INDEX + 1] = (uint8_t)arrival;
+	return output_index;
+}
+
+void Cobs_Stream_Decoder::set_address(const uint8_t _address, const bool filter) {
+	address = _address;
+	filtering = filter;
+}
+
+void Cobs_Stream_Decoder::attach_emergency_stop_cb(void* const context, const emergency_stop_func_t func) {
+	emergency_stop_context = context;
+	emergency_stop_func = func;
+}
+
+bool Cobs_Stream_Decoder::is_emergency_stop(const std::span<uint8_t, std::dynamic_extent> packet, const uint8_t address) {
+	//a plain (no MTYPE flags) single-byte command carrying nothing but the emergency stop code, plus its CRC
+	if(packet.size() != Parser::PACKET_VITALS_OVERHEAD + 1) return false;
+	uint8_t mtype = packet[Parser::MTYPE_INDEX];
+	if(mtype != (uint8_t)Parser::HOST_COMMAND_ALL_DEVICES && mtype != (uint8_t)Parser::HOST_COMMAND_TO_DEVICE) return false;
+	if(packet[Parser::PLEN_INDEX] != 1 || packet[Parser::PL_START_INDEX] != (uint8_t)CM_Mapping::STAGE_EMERGENCY_STOP) return false;
+	return Parser::addressed_to(packet[Parser::ID_INDEX], mtype, address);
+}
+
+uint32_t Cobs_Stream_Decoder::get_filtered_count() { return filtered_count; }
+
+bool Cobs_Stream_Decoder::crc_good(const std::span<uint8_t, std::dynamic_extent> decoded_frame) {
+	return decoded_frame[STATUS_INDEX] == STATUS_CRC_GOOD;
+}
+
+std::span<uint8_t, std::dynamic_extent> Cobs_Stream_Decoder::packet(const std::span<uint8_t, std::dynamic_extent> decoded_frame) {
+	return decoded_frame.subspan(IDX_START_OF_PAYLOAD);
+}
+
+uint32_t Cobs_Stream_Decoder::age(const std::span<uint8_t, std::dynamic_extent> decoded_frame, const uint32_t now) {
+	uint32_t arrival = ((uint32_t)decoded_frame[ARRIVAL_INDEX] << 8) | decoded_frame[ARRIVAL_INDEX + 1];
+	return (((now >> ARRIVAL_SHIFT) - arrival) & ARRIVAL_MASK) << ARRIVAL_SHIFT;
+}
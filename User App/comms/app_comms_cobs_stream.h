@@ -0,0 +1,129 @@
+/*
+ * app_comms_cobs_stream.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Byte-at-a-time version of `Cobs::decode_in_place()` that plugs into the UART's frame extractor
+ *
+ *  Rather than buffering an entire frame and walking it twice in the main loop (once to un-stuff the COBS, once for the CRC),
+ *  this un-stuffs every byte as the receive ISR hands it over, and folds it into a running CRC at the same time
+ *  By the time the EOF character lands, the frame is already decoded and its CRC already checked
+ *  	\--> frames with broken COBS framing are thrown away right in the ISR and never make it to the main loop
+ *  	\--> frames with a bad CRC are still passed along (flagged as such) so the parser can NACK them like it always has
+ *
+ *  Decoded frames are laid out in their queue slot as follows:
+ *
+ *  	[0]			[1:2]		[3]	...	[n + 2]
+ *  	STATUS		ARRIVAL		d0	...	dn-1
+ *
+ *  i.e. the decoded message sits at the same offset as the payload of the encoded frame (`Cobs::IDX_START_OF_PAYLOAD`)
+ *  this way every byte of a short frame gets written exactly where it arrived--same trick as the in-place decoder
+ *  	\--> for extended frames, bytes of later blocks get written a little earlier than they arrived, closing up the gaps left by block overhead
+ *  STATUS holds the result of the CRC check
+ *  ARRIVAL holds a coarse timestamp of when the EOF landed (if a timestamp source was attached), so the consumer can tell how long the frame sat in the queue
+ *  	\--> it's just bits [23:8] of the timestamp source; plenty to measure queueing delays, and it wraps cleanly along with a free-running counter
+ *
+ *  On a multi-drop bus, most of the traffic is for somebody else; turn on filtering in `set_address()` to throw that away as early as possible
+ *  	\--> once the ID and MTYPE of a frame are decoded, frames the parser would ignore (see `Parser::addressed_to()`) get rejected right there
+ *  	\--> so do frames OTHER DEVICES sent (i.e. their responses to a broadcast, or our own echo off a transceiver that hears itself)
+ *  	\--> none of it takes up a receive queue slot or main loop time, and it's counted separately from frames with broken framing
+ *  	\--> this happens before the CRC can be checked, so a frame for us with a mangled ID just looks like somebody else's--the host times out
+ *  	      rather than getting a CRC NACK (same as it would if the parser threw it away)
+ *
+ *  EMERGENCY STOP frames (see `Comms_Emergency_Stop`) are picked out right as their EOF lands, and the attached callback runs
+ *  straight from the receive ISR--so a stop never waits on the main loop, no matter what's ahead of it in the queue
+ *  	\--> the frame still gets queued up like normal, so the parser ACKs it (and runs the stop again, which does nothing by then)
+ *  	\--> only a CRC-checked, exact match counts (see `is_emergency_stop()`); anything else is just a regular frame
+ */
+
+#ifndef COMMS_APP_COMMS_COBS_STREAM_H_
+#define COMMS_APP_COMMS_COBS_STREAM_H_
+
+#include <stddef.h> //for size_t
+#include <stdint.h> //for uint8_t
+#include <span> //passing information to and from functions using spans
+
+#include "app_hal_uart_frame_extractor.h" //for the decoder interface
+#include "app_comms_cobs.h" //for framing characters and offsets
+#include "app_comms_crc.h" //to run the CRC as bytes arrive
+#include "app_comms_parser.h" //to pick out the ID and MTYPE of a frame
+
+class Cobs_Stream_Decoder : public UART_Frame_Decoder {
+public:
+	//where things live in a decoded frame's queue slot
+	static constexpr size_t STATUS_INDEX = 0;
+	static constexpr size_t IDX_START_OF_PAYLOAD = Cobs::IDX_START_OF_PAYLOAD;
+
+	//values the STATUS byte can take
+	static constexpr uint8_t STATUS_CRC_BAD = 0x00;
+	static constexpr uint8_t STATUS_CRC_GOOD = 0x01;
+
+	//the ARRIVAL timestamp keeps these bits of the timestamp source
+	static constexpr size_t ARRIVAL_INDEX = 1;
+	static constexpr size_t ARRIVAL_SHIFT = 8;
+	static constexpr uint32_t ARRIVAL_MASK = 0xFFFF;
+
+	//hang onto a reference of a CRC instance to compute CRCs with (owned and initialized by a higher level class)
+	//optionally pass a free-running counter to stamp frames with (e.g. a cycle counter); a plain function pointer, so this still builds on a host
+	Cobs_Stream_Decoder(Comms_CRC& _crc_comp, uint32_t (*const _timestamp)() = nullptr);
+
+	//delete copy constructor and assignment operator; UART hangs onto a pointer of this
+	Cobs_Stream_Decoder(Cobs_Stream_Decoder const&) = delete;
+	void operator=(Cobs_Stream_Decoder const&) = delete;
+
+	//================== UART_Frame_Decoder interface; CALLED FROM ISR ==================
+	void start(std::span<uint8_t, std::dynamic_extent> slot) override;
+	bool __attribute__((optimize("O3"))) feed(const size_t index, const uint8_t byte) override;
+	size_t finish(const size_t index) override;
+
+	//which device we are; optionally only let through frames addressed to this device (or broadcast)
+	//call before the UART is started
+	void set_address(const uint8_t address, const bool filter);
+	uint32_t get_filtered_count(); //frames thrown away since they were for someone else; free-running since power up
+
+	//run this FROM THE RECEIVE ISR whenever an emergency stop frame for this device lands
+	//it gets handed the timestamp (from the timestamp source) of when the frame's EOF was handed to us, so the stop can be timed from there
+	typedef void (*emergency_stop_func_t)(void* context, const uint32_t eof_timestamp);
+	void attach_emergency_stop_cb(void* const context, const emergency_stop_func_t func);
+
+	//is this decoded packet exactly an emergency stop frame addressed to a device at `address` (CRC not checked here)
+	static bool is_emergency_stop(const std::span<uint8_t, std::dynamic_extent> packet, const uint8_t address);
+
+	//================== helpers for the thread consuming decoded frames ==================
+	static bool crc_good(const std::span<uint8_t, std::dynamic_extent> decoded_frame); //did the frame pass its CRC check
+	static std::span<uint8_t, std::dynamic_extent> packet(const std::span<uint8_t, std::dynamic_extent> decoded_frame); //the decoded message
+	//how long ago the frame arrived, in ticks of the timestamp source; `now` comes from that same source
+	//resolution is 2^ARRIVAL_SHIFT ticks, and ages past 2^(ARRIVAL_SHIFT + 16) ticks alias
+	static uint32_t age(const std::span<uint8_t, std::dynamic_extent> decoded_frame, const uint32_t now);
+
+private:
+	Comms_CRC& crc_comp;
+	uint32_t (*const timestamp)();
+
+	//frame we're currently decoding into
+	std::span<uint8_t, std::dynamic_extent> frame_buf;
+
+	//where we expect the next stuffed delimiters to be (in the frame of reference of the encoded frame)
+	size_t next_sof_char_index = 0;
+	size_t next_eof_char_index = 0;
+
+	//where the current block starts (in the frame of reference of the encoded frame)
+	size_t block_start_index = 0;
+
+	//where the next decoded byte goes
+	size_t output_index = 0;
+
+	//CRC of everything decoded so far
+	uint16_t running_crc = 0;
+
+	//address filtering (see `set_address()`)
+	bool filtering = false;
+	uint8_t address = 0;
+	volatile uint32_t filtered_count = 0;
+
+	void* emergency_stop_context = nullptr;
+	emergency_stop_func_t emergency_stop_func = nullptr;
+};
+
+#endif /* COMMS_APP_COMMS_COBS_STREAM_H_ */
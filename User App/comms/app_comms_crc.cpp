@@ -4,66 +4,147 @@
  *  Created on: Sep 13, 2023
  *      Author: Ishaan
  *
- *  I know that STM32G474 has a built-in CRC calculator; but the hardware is a little restricted in terms of what it can do
  *  this is a relatively fast software implementation that leverages a LUT to:
  *  	- compute a 16-bit CRC given the input byte stream
  *  	- validate a byte stream's CRC value
  *
  *  https://stackoverflow.com/questions/44131951/how-to-generate-16-bit-crc-table-from-a-polynomial
  *  ben eater also has a great video on CRC computation on YouTube
+ *
+ *  slice-by-N is the same trick intel uses for their fast CRC32 implementations, just adapted to a 16-bit, non-reflected CRC
  */
 
 #include "app_comms_crc.h"
 
-Comms_CRC::Comms_CRC(const uint16_t _poly, const uint16_t _seed, const uint16_t _xor_out):
-	polynomial(_poly), seed(_seed), xor_out(_xor_out)
+//only pull in the device header when we're actually building for the device
+#ifdef STM32G474xx
+extern "C" {
+	#include "stm32g474xx.h" //for CRC peripheral registers
+}
+#endif
+
+Comms_CRC::Comms_CRC(const CRC_Backend_t _backend, const uint16_t _seed, const uint16_t _xor_out):
+	backend(_backend), seed(_seed), xor_out(_xor_out)
 {
-	//generate the lookup table based off the polynomial
-	//more or less replicating the solution in the stackoverflow thread
-	for(size_t i = 0; i < 256; i++) {
-
-		//naming this bitstream to wrap my head around this better
-		uint16_t bitstream = ((uint8_t)i) << 8;
-		//shift the data over 8 times
-		for(size_t shift_count = 0; shift_count < 8; shift_count++) {
-			if(bitstream & 0x8000) //mask the high bit, if it's 1
-				bitstream = (bitstream << 1) ^ polynomial;
-			else
-				bitstream = bitstream << 1;
-		}
-
-		//after we finish the shift, the CRC for that particular byte has been computed
-		//store that value in the lookup table
-		LUT[i] = bitstream;
+	//lookup tables are generated at compile time, so the only thing to do here is make sure the hardware is clocked if we're using it
+#ifdef STM32G474xx
+	if(backend == HARDWARE) {
+		RCC->AHB1ENR |= RCC_AHB1ENR_CRCEN;
+		(void)RCC->AHB1ENR; //read back to make sure the clock is running before we touch the peripheral
 	}
+#endif
 }
 
 //remember, the high byte of the CRC goes first (i.e. the lower index in the buffer)
 //and the low byte goes next (higher index in the buffer)
 uint16_t Comms_CRC::compute_crc(const std::span<uint8_t, std::dynamic_extent> buf) {
-	//initializing the CRC value with the appropriate seed
-	uint16_t crc = seed;
-
-	//run through all the bytes
-	for(size_t i = 0; i < buf.size(); i++) {
-		uint8_t crced_byte = ((crc >> 8) ^ buf[i]) & 0xFF; //apply accumulated CRC to the byte in the buffer
-		uint16_t crc_LUT = LUT[crced_byte]; //look the appropriate CRC value up in the table
-		crc = crc_LUT ^ (crc << 8); //ensure the low byte from the previous crc calculation is applied
+	switch(backend) {
+		case SLICE_BY_4: 	return compute_slice_by_4(buf);
+		case SLICE_BY_8: 	return compute_slice_by_8(buf);
+		case HARDWARE: 		return compute_hardware(buf);
+		case BYTEWISE:
+		default: 			return compute_bytewise(buf);
 	}
-
-	//and return the final CRC value
-	return crc;
 }
 
 bool Comms_CRC::validate_crc(const std::span<uint8_t, std::dynamic_extent> buf) {
 	//crc validation just involves running the CRC back through the CRC computation algorithm
-	uint16_t pre_crc = compute_crc(buf);
+	return check_crc(compute_crc(buf));
+}
 
+uint16_t Comms_CRC::start_crc() { return seed; }
+
+uint16_t Comms_CRC::update_crc(const uint16_t crc, const uint8_t byte) {
+	uint8_t crced_byte = ((crc >> 8) ^ byte) & 0xFF; //apply accumulated CRC to the byte in the buffer
+	uint16_t crc_LUT = LUT[0][crced_byte]; //look the appropriate CRC value up in the table
+	return crc_LUT ^ (crc << 8); //ensure the low byte from the previous crc calculation is applied
+}
+
+bool Comms_CRC::check_crc(const uint16_t crc) {
 	//xor the computed CRC
 	//if the result is something other than zero, the CRC computation is incorrect
-	if(pre_crc ^ xor_out)
+	if(crc ^ xor_out)
 		return false;
 	return true; //CRC computation should be zero
 }
 
+//==================================== PRIVATE FUNCTIONS ====================================
+
+uint16_t Comms_CRC::compute_bytewise(const std::span<uint8_t, std::dynamic_extent> buf) {
+	//initializing the CRC value with the appropriate seed
+	uint16_t crc = seed;
 
+	//run through all the bytes
+	for(size_t i = 0; i < buf.size(); i++) crc = update_crc(crc, buf[i]);
+
+	//and return the final CRC value
+	return crc;
+}
+
+uint16_t Comms_CRC::compute_slice_by_4(const std::span<uint8_t, std::dynamic_extent> buf) {
+	uint16_t crc = seed;
+	size_t i = 0;
+
+	//fold 4 bytes in at a time
+	//the CRC register only overlaps the first two bytes; the other two are looked up straight from the data
+	//each byte's contribution comes from the table corresponding to how many bytes follow it in the chunk
+	for(; i + 4 <= buf.size(); i += 4) {
+		crc = 	LUT[3][(crc >> 8) ^ buf[i]] ^
+				LUT[2][(crc & 0xFF) ^ buf[i + 1]] ^
+				LUT[1][buf[i + 2]] ^
+				LUT[0][buf[i + 3]];
+	}
+
+	//mop up whatever's left one byte at a time
+	for(; i < buf.size(); i++) crc = update_crc(crc, buf[i]);
+	return crc;
+}
+
+uint16_t Comms_CRC::compute_slice_by_8(const std::span<uint8_t, std::dynamic_extent> buf) {
+	uint16_t crc = seed;
+	size_t i = 0;
+
+	//same idea as slice-by-4, just with twice the bytes (and tables)
+	for(; i + 8 <= buf.size(); i += 8) {
+		crc = 	LUT[7][(crc >> 8) ^ buf[i]] ^
+				LUT[6][(crc & 0xFF) ^ buf[i + 1]] ^
+				LUT[5][buf[i + 2]] ^
+				LUT[4][buf[i + 3]] ^
+				LUT[3][buf[i + 4]] ^
+				LUT[2][buf[i + 5]] ^
+				LUT[1][buf[i + 6]] ^
+				LUT[0][buf[i + 7]];
+	}
+
+	//mop up whatever's left one byte at a time
+	for(; i < buf.size(); i++) crc = update_crc(crc, buf[i]);
+	return crc;
+}
+
+uint16_t Comms_CRC::compute_hardware(const std::span<uint8_t, std::dynamic_extent> buf) {
+#ifndef STM32G474xx
+	//no peripheral off-target; same result, just slower
+	return compute_bytewise(buf);
+#else
+	//configure the peripheral for our CRC every time--cheap, and means we don't care who touched it last
+	//16-bit polynomial, no input/output bit reversal, and reset the accumulator to our seed
+	CRC->POL = POLYNOMIAL;
+	CRC->INIT = seed;
+	CRC->CR = CRC_CR_POLYSIZE_0 | CRC_CR_RESET;
+
+	size_t i = 0;
+
+	//with no input reversal, a 32-bit write gets processed most significant byte first
+	//so pack 4 bytes big endian to keep the byte order of the buffer
+	for(; i + 4 <= buf.size(); i += 4) {
+		CRC->DR = 	((uint32_t)buf[i] << 24) | ((uint32_t)buf[i + 1] << 16) |
+					((uint32_t)buf[i + 2] << 8) | (uint32_t)buf[i + 3];
+	}
+
+	//and fold whatever's left over into the peripheral's result in software
+	//only ever 0-3 bytes, and it keeps us from having to do byte-wide writes into the data register
+	uint16_t crc = (uint16_t)CRC->DR;
+	for(; i < buf.size(); i++) crc = update_crc(crc, buf[i]);
+	return crc;
+#endif
+}
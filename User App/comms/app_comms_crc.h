@@ -4,12 +4,26 @@
  *  Created on: Sep 13, 2023
  *      Author: Ishaan
  *
- *  I know that STM32G474 has a built-in CRC calculator; but the hardware is a little restricted in terms of what it can do
  *  this is a relatively fast software implementation that leverages a LUT to:
  *  	- compute a 16-bit CRC given the input byte stream
  *  	- validate a byte stream's CRC value
  *
  *  https://stackoverflow.com/questions/44131951/how-to-generate-16-bit-crc-table-from-a-polynomial
+ *
+ *  UPDATE: lookup tables are now generated at compile time (and live in flash rather than RAM)
+ *  As such, the polynomial is a compile-time constant; the seed and xor-out can still be set per-instance
+ *  Whole-buffer computation can run on one of a few backends, all of which produce bit-identical results:
+ *  	- BYTEWISE: the classic one-table-lookup-per-byte loop
+ *  	- SLICE_BY_4/SLICE_BY_8: consumes 4/8 bytes per iteration using 4/8 tables (more flash, fewer dependent operations per byte)
+ *  	- HARDWARE: feeds the buffer through the STM32G4 CRC peripheral, 4 bytes per register write
+ *  		\--> turns out the peripheral can do CRC-16/AUG-CCITT just fine (16-bit poly, programmable init, no bit reversal)
+ *  		\--> only whole words go through the peripheral; the last 0-3 bytes get folded in with `update_crc()`
+ *  			 keeps every register access 32 bits wide, which is also what lets the host tests run this against a model of the peripheral
+ *  		\--> the peripheral is a shared resource! only use it from ONE context (i.e. the main loop)
+ *  The incremental interface (`update_crc()`) is always bytewise and software-only, so it's safe to call from ISRs
+ *
+ *  UPDATE: this file (along with COBS and the parser) builds for the host too, so the protocol can be exercised off-target
+ *  	\--> the HARDWARE backend only exists when building for the STM32G474 (i.e. `STM32G474xx` is defined); everywhere else it falls back to BYTEWISE
  */
 
 #ifndef COMMS_APP_COMMS_CRC_H_
@@ -17,16 +31,68 @@
 
 #include <stddef.h> //for size_t
 #include <span> //for span
+#include <array> //for compile-time lookup tables
+#include <stdint.h> //for uint16_t; no device headers here so this builds for the host too
+
+//============================== COMPILE-TIME LOOKUP TABLE GENERATION ===============================
+/*
+ * Table [0] is the standard bytewise table: CRC contribution of a byte sitting in the top of the CRC register
+ * Table [k] is the contribution of that same byte, followed by k zero bytes
+ * 		\--> this is what lets slice-by-N fold N bytes in at once: each byte's contribution is looked up independently and XOR'd together
+ *
+ * Lives outside of `Comms_CRC` since the class needs to be complete before a member function can be evaluated at compile time
+ */
+static constexpr size_t CRC16_NUM_TABLES = 8;
+typedef std::array<std::array<uint16_t, 256>, CRC16_NUM_TABLES> crc16_tables_t;
 
-extern "C" {
-	#include "stm32g474xx.h" //for uint16_t
+constexpr crc16_tables_t make_crc16_tables(const uint16_t poly) {
+	crc16_tables_t tables{};
+
+	//generate the standard table, more or less replicating the solution in the stackoverflow thread
+	for(size_t i = 0; i < 256; i++) {
+		//naming this bitstream to wrap my head around this better
+		uint16_t bitstream = (uint16_t)(i << 8);
+		//shift the data over 8 times
+		for(size_t shift_count = 0; shift_count < 8; shift_count++) {
+			if(bitstream & 0x8000) //mask the high bit, if it's 1
+				bitstream = (uint16_t)((bitstream << 1) ^ poly);
+			else
+				bitstream = (uint16_t)(bitstream << 1);
+		}
+		tables[0][i] = bitstream;
+	}
+
+	//every subsequent table is the previous one pushed through another zero byte
+	for(size_t k = 1; k < CRC16_NUM_TABLES; k++)
+		for(size_t i = 0; i < 256; i++)
+			tables[k][i] = (uint16_t)((tables[k-1][i] << 8) ^ tables[0][tables[k-1][i] >> 8]);
+
+	return tables;
 }
 
 //can't use 'CRC' as a class name because there's a global level define with the same name
 class Comms_CRC {
 
 public:
-	Comms_CRC(	const uint16_t _poly = DEFAULT_POLYNOMIAL,
+	//different ways we can crunch a whole buffer
+	enum CRC_Backend_t {
+		BYTEWISE,
+		SLICE_BY_4,
+		SLICE_BY_8,
+		HARDWARE,
+	};
+
+	//================================= SYSTEM CRC PARAMETERS - USE THIS =================================
+
+	//CRC-16/AUG-CCITT, common 16-bit CRC parameters
+	static constexpr uint16_t POLYNOMIAL = 0x1021;
+	static constexpr uint16_t DEFAULT_SEED = 0x1D0F;
+	static constexpr uint16_t DEFAULT_XOR_OUT = 0x0000;
+	static constexpr CRC_Backend_t DEFAULT_BACKEND = SLICE_BY_4;
+
+	//====================================================================================================
+
+	Comms_CRC(	const CRC_Backend_t _backend = DEFAULT_BACKEND,
 				const uint16_t _seed = DEFAULT_SEED,
 				const uint16_t _xor_out = DEFAULT_XOR_OUT);
 
@@ -34,21 +100,27 @@ public:
 	uint16_t compute_crc(const std::span<uint8_t, std::dynamic_extent> buf);
 	bool validate_crc(const std::span<uint8_t, std::dynamic_extent> buf);
 
-private:
-	//================================= SYSTEM CRC PARAMETERS - USE THIS =================================
+	//incremental interface for computing a CRC as bytes trickle in (i.e. from an ISR)
+	//`start_crc()` returns the initial value, `update_crc()` folds in one more byte,
+	//and `check_crc()` says whether a CRC run over a message AND its trailing CRC bytes checks out
+	uint16_t start_crc();
+	uint16_t __attribute__((optimize("O3"))) update_crc(const uint16_t crc, const uint8_t byte);
+	bool check_crc(const uint16_t crc);
 
-	//CRC-16/AUG-CCITT, common 16-bit CRC parameters
-	static const uint16_t DEFAULT_POLYNOMIAL = 0x1021;
-	static const uint16_t DEFAULT_SEED = 0x1D0F;
-	static const uint16_t DEFAULT_XOR_OUT = 0x0000;
+	//static constexpr --> computed by the compiler and placed in flash; shared by all instances
+	static constexpr crc16_tables_t LUT = make_crc16_tables(POLYNOMIAL);
+
+private:
+	//the different backends of `compute_crc()`
+	uint16_t compute_bytewise(const std::span<uint8_t, std::dynamic_extent> buf);
+	uint16_t compute_slice_by_4(const std::span<uint8_t, std::dynamic_extent> buf);
+	uint16_t compute_slice_by_8(const std::span<uint8_t, std::dynamic_extent> buf);
+	uint16_t compute_hardware(const std::span<uint8_t, std::dynamic_extent> buf);
 
 	//======================================== INSTANCE VARIABLES=========================================
-	const uint16_t polynomial; //actual CRC polynomial we'll compute with
+	const CRC_Backend_t backend; //how we crunch whole buffers
 	const uint16_t seed; //value CRC computation is initialized with
 	const uint16_t xor_out; //value we need to xor the CRC result with when checking
-
-	//lookup table that gets generated based off the polynomial
-	uint16_t LUT[256];
 };
 
 
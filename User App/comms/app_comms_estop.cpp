@@ -0,0 +1,77 @@
+/*
+ * app_comms_estop.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#include "app_comms_estop.h"
+
+#include <algorithm> //for min
+
+#include "app_hal_timing.h" //for timing how long a trip takes
+#include "app_utils_trace.h" //to log trips
+
+Comms_Emergency_Stop::Comms_Emergency_Stop(std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages):
+	stages(_stages)
+{}
+
+//================================== RECEIVE ISR ==================================
+
+void Comms_Emergency_Stop::trip_forwarder(void* context, const uint32_t eof_cycles) {
+	static_cast<Comms_Emergency_Stop*>(context)->trip(eof_cycles);
+}
+
+void Comms_Emergency_Stop::trip(const uint32_t eof_cycles) {
+	//somebody else is already in here stopping everything; nothing left for us to do
+	if(tripping.exchange(true, std::memory_order_acquire)) return;
+
+	//outputs off first, everything else after
+	for(Power_Stage_Subsystem* stage : stages) stage->set_mode(Power_Stage_Subsystem::Stage_Mode::DISABLED);
+	uint32_t latency_cycles = Timer::get_cycles() - eof_cycles;
+
+	//let the main loop know to double check, and keep track of how long that took
+	tripped.store(true, std::memory_order_release);
+	stats.trips.fetch_add(1, std::memory_order_relaxed);
+	stats.latency_last_cycles.store(latency_cycles, std::memory_order_relaxed);
+	if(latency_cycles > stats.latency_max_cycles.load(std::memory_order_relaxed)) stats.latency_max_cycles.store(latency_cycles, std::memory_order_relaxed);
+	Trace::log<Trace::ESTOP>((uint32_t)stages.size(), latency_cycles);
+
+	tripping.store(false, std::memory_order_release);
+}
+
+//================================== MAIN LOOP ==================================
+
+bool Comms_Emergency_Stop::stop() {
+	bool success = true;
+	for(Power_Stage_Subsystem* stage : stages) success &= stage->set_mode(Power_Stage_Subsystem::Stage_Mode::DISABLED);
+	return success;
+}
+
+void Comms_Emergency_Stop::loop() {
+	if(!tripped.exchange(false, std::memory_order_acquire)) return;
+
+	//anything that isn't disabled now got switched back on by a mode change the ISR interrupted
+	for(Power_Stage_Subsystem* stage : stages) {
+		if(stage->get_mode() == Power_Stage_Subsystem::Stage_Mode::DISABLED) continue;
+		stage->set_mode(Power_Stage_Subsystem::Stage_Mode::DISABLED);
+		stats.reasserts.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+//================================== EITHER ==================================
+
+Comms_Emergency_Stop::Estop_Stats_t Comms_Emergency_Stop::get_stats() {
+	//report in ns; cycle counts are too fine to be useful to the host, and microseconds are too coarse for this
+	//do the math in 64 bits--anything past ~25ms worth of cycles would overflow 32 bits once it's scaled up
+	auto cycles_to_ns = [](const uint32_t cycles) {
+		uint64_t ns = (uint64_t)cycles * 1000000000 / Timer::get_cycles_per_second();
+		return (uint32_t)std::min<uint64_t>(ns, UINT32_MAX);
+	};
+	return {
+		.trips = stats.trips.load(std::memory_order_relaxed),
+		.latency_last_ns = cycles_to_ns(stats.latency_last_cycles.load(std::memory_order_relaxed)),
+		.latency_max_ns = cycles_to_ns(stats.latency_max_cycles.load(std::memory_order_relaxed)),
+		.reasserts = stats.reasserts.load(std::memory_order_relaxed),
+	};
+}
@@ -0,0 +1,89 @@
+/*
+ * app_comms_estop.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Emergency stop that doesn't wait on the main loop
+ *
+ *  A regular STAGE_DISABLE only runs once `Comms_Exec_Subsystem::loop()` gets around to it--behind whatever response is still going out,
+ *  whatever handler is running, and whatever else is in the receive queue
+ *  Instead, the receive ISR watches for one reserved frame (see `Cobs_Stream_Decoder::is_emergency_stop()`):
+ *
+ *  	[ID] [MTYPE = 0x0 or 0x1, no flags] [PLEN = 1] [STAGE_EMERGENCY_STOP] [CRCh] [CRCl]
+ *
+ *  and as soon as its EOF lands (and the CRC checks out), `trip()` disables every stage right from that ISR
+ *  	\--> ID can be this device, `Parser::BROADCAST_ADDRESS`, or anything at all with MTYPE 0x0 (i.e. stop every device on the bus)
+ *  	\--> EOF lands --> ISR runs: at most one character time for the idle line event, plus interrupt latency
+ *  	\--> the frame still gets parsed later on like any other command, which just ACKs it (or doesn't, for MTYPE 0x0)
+ *  		 the same command inside a batch or a sequenced/extended frame doesn't match the pattern, so it only runs once it's parsed
+ *
+ *  Every trip gets timed from the moment the frame's EOF was handed to the decoder to the last stage being off, and logged to the trace
+ *
+ *  Every link's receive ISRs (UART and RX DMA) sit at the same priority, so two trips can't normally preempt each other
+ *  `trip()` still only lets one context in at a time (whoever gets there second just returns--the first one's already stopping everything),
+ *  so nothing else has to hold for it to be safe; and disabling a stage that's already disabled does nothing, so repeat trips are harmless
+ *
+ *  If the ISR happens to land in the middle of the main loop switching a stage's mode, the main loop could finish the switch
+ *  after the stage was disabled--so `loop()` goes back over every stage after a trip and disables anything that came back on
+ */
+
+#ifndef COMMS_APP_COMMS_ESTOP_H_
+#define COMMS_APP_COMMS_ESTOP_H_
+
+extern "C" {
+	#include "stm32g474xx.h" //for uint32_t
+}
+
+#include <span>
+#include <atomic> //for stats shared with the receive ISRs
+
+#include "app_power_stage_top_level.h" //the stages we're stopping
+
+class Comms_Emergency_Stop {
+public:
+	//free-running since power up
+	struct Estop_Stats_t {
+		uint32_t trips;				//emergency stop frames handled in the receive ISR
+		uint32_t latency_last_ns;	//EOF landed --> every stage off, for the most recent trip
+		uint32_t latency_max_ns;	//worst case of the above
+		uint32_t reasserts;			//stages `loop()` found back on after a trip, and disabled again
+	};
+
+	Comms_Emergency_Stop(std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages);
+
+	//delete copy constructor and assignment operator; the receive ISRs hang onto a pointer to this
+	Comms_Emergency_Stop(Comms_Emergency_Stop const&) = delete;
+	void operator=(Comms_Emergency_Stop const&) = delete;
+
+	//================== RECEIVE ISR ==================
+	//attach with `Comms_Exec_Subsystem::attach_emergency_stop_cb(&estop, Comms_Emergency_Stop::trip_forwarder)`
+	//`eof_cycles` is the cycle count (see `Timer::get_cycles()`) when the stop frame's EOF landed
+	static void trip_forwarder(void* context, const uint32_t eof_cycles);
+	void trip(const uint32_t eof_cycles);
+
+	//================== MAIN LOOP ONLY ==================
+	//disable every stage; for the regular (parsed) path. Returns false if a stage refused
+	bool stop();
+
+	//clean up after a trip that raced a mode change
+	void loop();
+
+	//================== EITHER ==================
+	Estop_Stats_t get_stats(); //copy, since the ISR can bump these at any time
+
+private:
+	std::span<Power_Stage_Subsystem*, std::dynamic_extent> stages;
+
+	std::atomic<bool> tripped{false}; //set by the ISR, cleared once `loop()` has double-checked the stages
+	std::atomic<bool> tripping{false}; //held for the duration of `trip()`, so only one context ever runs it at once
+
+	struct {
+		std::atomic<uint32_t> trips{0};
+		std::atomic<uint32_t> latency_last_cycles{0};
+		std::atomic<uint32_t> latency_max_cycles{0};
+		std::atomic<uint32_t> reasserts{0};
+	} stats;
+};
+
+#endif /* COMMS_APP_COMMS_ESTOP_H_ */
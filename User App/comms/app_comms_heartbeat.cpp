@@ -0,0 +1,102 @@
+/*
+ * app_comms_heartbeat.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#include "app_comms_heartbeat.h"
+
+#include <algorithm> //for min
+
+#include "app_hal_timing.h" //for the millisecond tick
+#include "app_utils_trace.h" //to log shutdowns
+
+Comms_Heartbeat::Comms_Heartbeat(	Configuration::Configuration_Params& _config,
+									std::span<Comms_Exec_Subsystem*, std::dynamic_extent> _links,
+									std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages):
+	config(_config), links(_links), stages(_stages)
+{}
+
+void Comms_Heartbeat::loop() {
+	uint32_t now = Timer::get_ms();
+
+	switch(state) {
+		case WATCHING: {
+			//cheap enough to do every pass: a subtraction per link and a compare
+			uint32_t window_ms = config.HEARTBEAT_WINDOW_MS;
+			if(window_ms == 0) return;
+			uint32_t silent_ms = silence_ms(now);
+			if(silent_ms <= window_ms) return;
+
+			//host is gone; remember where every automatically controlled stage's setpoint was so we can ramp it down from there
+			//manual stages have nothing to ramp, so they just go straight off
+			size_t enabled_count = 0;
+			for(size_t i = 0; i < stages.size() && i < ramp_from.size(); i++) {
+				switch(stages[i]->get_mode()) {
+					case Power_Stage_Subsystem::Stage_Mode::DISABLED:
+					case Power_Stage_Subsystem::Stage_Mode::UNINITIALIZED:
+						break;
+					case Power_Stage_Subsystem::Stage_Mode::ENABLED_AUTO:
+						ramp_from[i] = stages[i]->get_regulator_instance().get_last_setpoint();
+						enabled_count++;
+						break;
+					default:
+						stages[i]->set_mode(Power_Stage_Subsystem::Stage_Mode::DISABLED);
+						enabled_count++;
+						break;
+				}
+			}
+
+			//nothing running means nothing to protect; just wait for the host to come back before watching again
+			if(enabled_count == 0) {
+				state = EXPIRED;
+				return;
+			}
+			Trace::log<Trace::HEARTBEAT_LOST>(silent_ms, window_ms, (uint32_t)enabled_count);
+			ramp_start_ms = now;
+			state = RAMPING;
+			[[fallthrough]]; //take the first step right away
+		}
+
+		case RAMPING: {
+			//linear ramp from where each setpoint was down to zero
+			uint32_t ramp_ms = config.HEARTBEAT_RAMP_MS;
+			uint32_t elapsed_ms = now - ramp_start_ms;
+			if(elapsed_ms < ramp_ms) {
+				float remaining = 1.0f - (float)elapsed_ms / (float)ramp_ms;
+				for(size_t i = 0; i < stages.size() && i < ramp_from.size(); i++) {
+					if(stages[i]->get_mode() != Power_Stage_Subsystem::Stage_Mode::ENABLED_AUTO) continue;
+					stages[i]->get_setpoint_instance().make_setpoint_dc(false, ramp_from[i] * remaining);
+				}
+				return;
+			}
+
+			//ramp's done; drop the setpoints to zero for good and turn everything off
+			size_t disabled_count = 0;
+			for(Power_Stage_Subsystem* stage : stages) {
+				if(stage->get_mode() == Power_Stage_Subsystem::Stage_Mode::DISABLED) continue;
+				stage->get_setpoint_instance().make_setpoint_dc(false, 0);
+				stage->set_mode(Power_Stage_Subsystem::Stage_Mode::DISABLED);
+				disabled_count++;
+			}
+			Trace::log<Trace::HEARTBEAT_SHUTDOWN>((uint32_t)disabled_count);
+			state = EXPIRED;
+			return;
+		}
+
+		case EXPIRED:
+			//start watching again once the host shows back up (or the watchdog gets turned off)
+			if(config.HEARTBEAT_WINDOW_MS == 0 || silence_ms(now) <= config.HEARTBEAT_WINDOW_MS) state = WATCHING;
+			return;
+	}
+}
+
+//================================== PRIVATE METHODS ==================================
+
+uint32_t Comms_Heartbeat::silence_ms(const uint32_t now) {
+	//the host only has to be talking on one of the links; unsigned differences so this holds up across the tick wrapping
+	uint32_t silent_ms = UINT32_MAX;
+	for(Comms_Exec_Subsystem* link : links) silent_ms = std::min(silent_ms, now - link->get_last_rx_ms());
+	return silent_ms;
+}
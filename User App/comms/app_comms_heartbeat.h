@@ -0,0 +1,72 @@
+/*
+ * app_comms_heartbeat.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Watchdog that shuts the stages down if the host goes quiet
+ *
+ *  Without this, a stage in ENABLED_AUTO keeps driving its last setpoint forever if the host crashes or the cable falls out
+ *  Every link remembers when it last got a good frame meant for this device (`Comms_Exec_Subsystem::get_last_rx_ms()`)
+ *  	\--> ANY message counts as a heartbeat--there's no dedicated heartbeat command; a TEST_BYTE request does the job if the host has
+ *  	     nothing better to say, and a host that's polling status anyway never has to think about this at all
+ *  `loop()` just compares the newest of those against `HEARTBEAT_WINDOW_MS` (in the config, so it's settable through `Param_Map`)
+ *
+ *  Once the window runs out:
+ *  	- stages under automatic control have their setpoints ramped from wherever they were to zero over `HEARTBEAT_RAMP_MS`
+ *  	  (so a coil doesn't get its current yanked to zero in one go), then get disabled
+ *  	- stages under manual control don't have a setpoint to ramp, so they're disabled right away
+ *  	- both ends get logged to the trace
+ *  The shutdown runs to completion even if the host shows back up halfway through; it has to re-enable whatever it wants running
+ *  A window of 0 turns the whole thing off (the default, so hosts that don't know about this carry on like before)
+ *
+ *  NOTE: only to be used from the main loop. The ramp steps once per pass, so a main loop that's slower than usual gives a coarser ramp
+ */
+
+#ifndef COMMS_APP_COMMS_HEARTBEAT_H_
+#define COMMS_APP_COMMS_HEARTBEAT_H_
+
+extern "C" {
+	#include "stm32g474xx.h" //for uint32_t
+}
+
+#include <array>
+#include <span>
+
+#include "app_config.h" //for the heartbeat window
+#include "app_comms_top_level.h" //links we're listening to
+#include "app_power_stage_top_level.h" //stages we're shutting down
+
+class Comms_Heartbeat {
+public:
+	Comms_Heartbeat(	Configuration::Configuration_Params& _config,
+						std::span<Comms_Exec_Subsystem*, std::dynamic_extent> _links,
+						std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages);
+
+	//delete copy constructor and assignment operator; just one of these watching over everything
+	Comms_Heartbeat(Comms_Heartbeat const&) = delete;
+	void operator=(Comms_Heartbeat const&) = delete;
+
+	//check in on the host, and step any shutdown along
+	void loop();
+
+private:
+	enum Heartbeat_State_t : uint8_t {
+		WATCHING,	//host is around (or the watchdog is off)
+		RAMPING,	//host went quiet; bringing setpoints down to zero
+		EXPIRED,	//stages are down; waiting for the host to show back up
+	};
+
+	//how long ago we heard from the host on any link
+	uint32_t silence_ms(const uint32_t now);
+
+	Configuration::Configuration_Params& config;
+	std::span<Comms_Exec_Subsystem*, std::dynamic_extent> links;
+	std::span<Power_Stage_Subsystem*, std::dynamic_extent> stages;
+
+	Heartbeat_State_t state = WATCHING;
+	uint32_t ramp_start_ms = 0;
+	std::array<float, Configuration::POWER_STAGE_COUNT> ramp_from = {}; //setpoint each stage was at when the ramp started
+};
+
+#endif /* COMMS_APP_COMMS_HEARTBEAT_H_ */
@@ -0,0 +1,123 @@
+/*
+ * app_comms_param_notify.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#include "app_comms_param_notify.h"
+
+#include <algorithm> //for min
+
+#include "app_utils.h" //for packing functions
+#include "app_comms_parser.h" //for maximum payload length
+
+static_assert(	Comms_Param_Notifier::CHANGES_START_INDEX + Comms_Param_Notifier::SUBSCRIPTION_COUNT * Comms_Param_Notifier::CHANGE_LENGTH <= Parser::MAX_PAYLOAD_LENGTH,
+				"every subscription should fit in a single change frame");
+
+Comms_Param_Notifier::Comms_Param_Notifier(Param_Map& _params):
+	params(_params)
+{}
+
+//======================================== SUBSCRIPTIONS ========================================
+
+Param_Map::Param_Result_t Comms_Param_Notifier::subscribe(const std::span<const uint16_t, std::dynamic_extent> ids) {
+	//check everything before touching the table, so a bad ID doesn't leave us half subscribed
+	//duplicates in `ids` get counted twice here, which just errs on the side of refusing
+	size_t new_count = 0;
+	for(uint16_t id : ids) {
+		if(params.describe(id) == nullptr) return Param_Map::PARAM_UNKNOWN_ID;
+		if(find(id) == count) new_count++;
+	}
+	if(count + new_count > SUBSCRIPTION_COUNT) return Param_Map::PARAM_OUT_OF_BOUNDS;
+
+	//and mark everything pending, so the host gets the current value of whatever it just asked for
+	for(uint16_t id : ids) {
+		size_t index = find(id);
+		if(index == count) subscriptions[count++] = {.id = id, .value = 0, .pending = false};
+
+		Subscription_t& subscription = subscriptions[index];
+		params.get(id, subscription.value);
+		if(!subscription.pending) pending_count++;
+		subscription.pending = true;
+	}
+	return Param_Map::PARAM_OK;
+}
+
+size_t Comms_Param_Notifier::unsubscribe(const std::span<const uint16_t, std::dynamic_extent> ids) {
+	size_t dropped = 0;
+	for(uint16_t id : ids) {
+		size_t index = find(id);
+		if(index == count) continue;
+
+		//fill the hole with the last subscription in the table, so everything stays packed at the front
+		if(subscriptions[index].pending) pending_count--;
+		subscriptions[index] = subscriptions[--count];
+		dropped++;
+	}
+	return dropped;
+}
+
+void Comms_Param_Notifier::unsubscribe_all() {
+	count = 0;
+	pending_count = 0;
+}
+
+size_t Comms_Param_Notifier::get_subscriptions(std::span<uint16_t, std::dynamic_extent> ids) {
+	size_t copied = std::min(count, ids.size());
+	for(size_t i = 0; i < copied; i++) ids[i] = subscriptions[i].id;
+	return count;
+}
+
+//======================================== CHANGE DETECTION ========================================
+
+void Comms_Param_Notifier::loop() {
+	//a read hook per subscription; only the newest value survives until the link gets around to sending it
+	for(size_t i = 0; i < count; i++) {
+		Subscription_t& subscription = subscriptions[i];
+		uint32_t value;
+		if(params.get(subscription.id, value) != Param_Map::PARAM_OK) continue;
+		if(value == subscription.value) continue;
+
+		subscription.value = value;
+		if(!subscription.pending) pending_count++;
+		subscription.pending = true;
+	}
+}
+
+bool Comms_Param_Notifier::frame_ready() { return pending_count > 0; }
+
+size_t Comms_Param_Notifier::pack_frame(std::span<uint8_t, std::dynamic_extent> tx_payload) {
+	if(pending_count == 0 || tx_payload.size() < CHANGES_START_INDEX + CHANGE_LENGTH) return 0;
+	size_t max_changes = std::min<size_t>((tx_payload.size() - CHANGES_START_INDEX) / CHANGE_LENGTH, UINT8_MAX);
+
+	//pack everything that's changed (or as much as fits; anything left over goes out in the next frame)
+	size_t changes = 0;
+	size_t tx_index = CHANGES_START_INDEX;
+	for(size_t i = 0; i < count && changes < max_changes; i++) {
+		Subscription_t& subscription = subscriptions[i];
+		if(!subscription.pending) continue;
+
+		tx_payload[tx_index] = (uint8_t)(subscription.id >> 8);
+		tx_payload[tx_index + 1] = (uint8_t)subscription.id;
+		pack(subscription.value, tx_payload.subspan(tx_index + 2, 4));
+		tx_index += CHANGE_LENGTH;
+
+		subscription.pending = false;
+		pending_count--;
+		changes++;
+	}
+
+	//and throw the header on the front
+	pack(next_seq++, tx_payload.subspan(SEQ_INDEX, 4));
+	tx_payload[COUNT_INDEX] = (uint8_t)changes;
+	return tx_index;
+}
+
+//======================================== PRIVATE METHODS ========================================
+
+size_t Comms_Param_Notifier::find(const uint16_t id) {
+	for(size_t i = 0; i < count; i++)
+		if(subscriptions[i].id == id) return i;
+	return count;
+}
@@ -0,0 +1,94 @@
+/*
+ * app_comms_param_notify.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Pushes parameter changes out to the host, so host tools mirroring device state don't have to keep polling just in case
+ *
+ *  The host subscribes to parameters by their `Param_Map` ID (PARAM_SUBSCRIBE), and from then on:
+ *  	- `loop()` reads every subscribed parameter once per main loop pass, and compares it against the last value it saw
+ *  		\--> catches a change no matter where it came from (a command, the heartbeat watchdog, an emergency stop out of the receive ISR...)
+ *  		     without every setter in every subsystem having to know about subscriptions
+ *  		\--> a parameter that changes a bunch of times in one pass (or while the link is backed up) only goes out once, with its newest value
+ *  	- the bulk comms link packs whatever's changed into DEVICE_PARAM_CHANGE frames in the background, same as telemetry
+ *  A freshly subscribed parameter goes out once right away, so the host starts off with its current value
+ *
+ *  DEVICE_PARAM_CHANGE frame payload (all values big endian, like everything else):
+ *  	[0:3]		SEQ			free-running count of change frames sent; a gap means the host missed one (and should re-read everything)
+ *  	[4]			COUNT		number of changes in the frame
+ *  	[5:...]		CHANGES		COUNT changes back to back, each as [ID (2)][VALUE (4)], packed according to the parameter's type
+ *
+ *  NOTE: only to be used from the main loop (same as `Param_Map`)
+ *  	\--> which is why PARAM_SUBSCRIBE/PARAM_UNSUBSCRIBE can't be lined up with SYNC_SCHEDULE (see `Comms_Sync_Scheduler::schedulable()`)
+ */
+
+#ifndef COMMS_APP_COMMS_PARAM_NOTIFY_H_
+#define COMMS_APP_COMMS_PARAM_NOTIFY_H_
+
+#include <stddef.h> //for size_t
+#include <stdint.h> //for uint8_t
+#include <span> //for passing buffers around
+#include <array> //for the subscription table
+
+#include "app_config_param_map.h" //the parameters we're watching
+
+class Comms_Param_Notifier {
+public:
+	//how many parameters the host can be subscribed to at once
+	//sized so every one of them fits in a single frame, in case they all change at once
+	static constexpr size_t SUBSCRIPTION_COUNT = 32;
+
+	//layout of a DEVICE_PARAM_CHANGE frame payload
+	static constexpr size_t SEQ_INDEX = 0;
+	static constexpr size_t COUNT_INDEX = 4;
+	static constexpr size_t CHANGES_START_INDEX = 5;
+	static constexpr size_t CHANGE_LENGTH = 6; //ID + value
+
+	Comms_Param_Notifier(Param_Map& _params);
+
+	//delete copy constructor and assignment operator; handlers and the bulk link hang onto a pointer to this
+	Comms_Param_Notifier(Comms_Param_Notifier const&) = delete;
+	void operator=(Comms_Param_Notifier const&) = delete;
+
+	//subscribe to a handful of parameters; all-or-nothing
+	//PARAM_UNKNOWN_ID if one of them isn't mapped, PARAM_OUT_OF_BOUNDS if they don't all fit in the subscription table
+	//subscribing to something we're already subscribed to is fine; it just goes out again
+	Param_Map::Param_Result_t subscribe(const std::span<const uint16_t, std::dynamic_extent> ids);
+
+	//drop a handful of subscriptions (anything we weren't subscribed to is ignored); returns how many got dropped
+	size_t unsubscribe(const std::span<const uint16_t, std::dynamic_extent> ids);
+	void unsubscribe_all();
+
+	//copy out the IDs we're subscribed to; returns how many there are
+	size_t get_subscriptions(std::span<uint16_t, std::dynamic_extent> ids);
+
+	//look for changes in everything we're subscribed to; call once per main loop pass
+	void loop();
+
+	//returns true if there are changes waiting to go out
+	bool frame_ready();
+
+	//pack as many waiting changes as fit into a DEVICE_PARAM_CHANGE payload; returns the payload length (0 if nothing to send)
+	size_t pack_frame(std::span<uint8_t, std::dynamic_extent> tx_payload);
+
+private:
+	struct Subscription_t {
+		uint16_t id;
+		uint32_t value; //last value we saw
+		bool pending; //value changed since it last went out
+	};
+
+	//where a subscription sits in the table; `count` if we're not subscribed to it
+	size_t find(const uint16_t id);
+
+	Param_Map& params;
+
+	//packed at the front of the table; order doesn't matter
+	std::array<Subscription_t, SUBSCRIPTION_COUNT> subscriptions = {};
+	size_t count = 0;
+	size_t pending_count = 0;
+	uint32_t next_seq = 0;
+};
+
+#endif /* COMMS_APP_COMMS_PARAM_NOTIFY_H_ */
@@ -8,141 +8,292 @@
 #include "app_comms_parser.h"
 
 #include <tuple> //for `std::tie`
+#include <algorithm> //for `std::min`
 
-//simple constructor that just hangs onto our CRC calculation unit
-Parser::Parser(Comms_CRC& _crc_comp): crc_comp(_crc_comp) {}
+//simple constructor that just hangs onto our CRC calculation unit and dispatch tables
+Parser::Parser(Comms_CRC& _crc_comp, const dispatch_table_t& _command_table, const dispatch_table_t& _request_table):
+	crc_comp(_crc_comp), command_table(_command_table), request_table(_request_table)
+{}
 
 size_t Parser::parse_buffer(	const std::span<uint8_t, std::dynamic_extent> rx_packet,
 								std::span<uint8_t, std::dynamic_extent> tx_packet)
 {
+	//check if the crc passes the vibe check, then parse as usual
+	return parse_buffer(rx_packet, tx_packet, crc_comp.validate_crc(rx_packet));
+}
+
+size_t Parser::parse_buffer(	const std::span<uint8_t, std::dynamic_extent> rx_packet,
+								std::span<uint8_t, std::dynamic_extent> tx_packet,
+								const bool crc_good)
+{
+	//sanity check that the packet is long enough to even have a header
+	if(rx_packet.size() < PACKET_PREFIX_OVERHEAD) return 0;
+
+	//figure out where everything is based off the MTYPE flags; the header's a little longer for extended and sequenced messages
+	Message_Format_t format = message_format(rx_packet[MTYPE_INDEX]);
+	bool extended = format.flags & MTYPE_FLAG_EXTENDED;
+	bool sequenced = format.flags & MTYPE_FLAG_SEQUENCED;
+
 	//sanity check that we can even pack a failure message into the tx_buffer
-	if(tx_packet.size() < PACKET_OVERHEAD + 1) return 0;
+	//and that the (possibly longer) header is all there
+	if(tx_packet.size() < format.packet_overhead + 1) return 0;
+	if(rx_packet.size() < format.prefix_overhead) return 0;
 
 	//grab the core details of the packet
 	uint8_t dest_id = rx_packet[ID_INDEX];
 	uint8_t message_code = rx_packet[MTYPE_INDEX] & MESSAGE_TYPE_MASK; //keeping this a uint8_t for now
-	size_t plen = rx_packet[PLEN_INDEX];
+	size_t plen = extended ? ((size_t)rx_packet[PLEN_INDEX] << 8) | rx_packet[PLEN_LOW_INDEX_EXTENDED] : rx_packet[PLEN_INDEX];
+	uint8_t seq = sequenced ? rx_packet[format.prefix_overhead - SEQ_OVERHEAD] : 0; //SEQ sits right before the payload
 
-	//check if the crc passes the vibe check
-	bool crc_good = crc_comp.validate_crc(rx_packet);
-
-	//if the message ID doesn't match and it's not an ALL_DEVICES command
+	//if the message ID doesn't match and it's not a broadcast or an ALL_DEVICES command
 	//just return since we don't need to process or respond to this message
-	if(dest_id != (uint8_t)device_address && message_code != (uint8_t)HOST_COMMAND_ALL_DEVICES)
+	if(!addressed_to(dest_id, rx_packet[MTYPE_INDEX], (uint8_t)device_address))
 		return 0;
 
 	//if we're here, we have received a message we need to act on
 	MessageType_t response_type;
 	size_t response_plen;
+	size_t pl_start = format.prefix_overhead;
+	bool dispatched = false; //only remember responses to messages we actually ran
+	uint16_t message_crc = 0;
 
 	//if the CRC is bad
 	if(!crc_good) {
 		response_type = DEVICE_NACK_HOST_MESSAGE;
 		response_plen = 1;
-		tx_packet[PL_START_INDEX] = (uint8_t)NACK_ERROR_INVALID_CRC;
+		tx_packet[pl_start] = (uint8_t)NACK_ERROR_INVALID_CRC;
 	}
 
-	//if our payload size is outta bounds
-	else if(plen < MIN_PAYLOAD_LENGTH || plen > MAX_PAYLOAD_LENGTH) {
+	//if our payload size is outta bounds (or runs past the end of the packet)
+	else if(plen < MIN_PAYLOAD_LENGTH || plen > format.max_plen || plen + format.prefix_overhead + 2 > rx_packet.size()) {
 		response_type = DEVICE_NACK_HOST_MESSAGE;
 		response_plen = 1;
-		tx_packet[PL_START_INDEX] = (uint8_t)NACK_ERROR_INVALID_MSG_SIZE;
+		tx_packet[pl_start] = (uint8_t)NACK_ERROR_INVALID_MSG_SIZE;
 	}
 
 	//otherwise, everything seems to be good
 	else {
-		//create some local variables to pass the command or request handlers
-		std::span<uint8_t, std::dynamic_extent> rx_payload = rx_packet.subspan(PL_START_INDEX, plen);
-		std::span<uint8_t, std::dynamic_extent> tx_payload = tx_packet.subspan(PL_START_INDEX, tx_packet.size() - PACKET_OVERHEAD);
-		//use `response_type` defined above as a reponse type parameter
-		//use `response_plen` defined above as a response size parameter
-		uint8_t command_request_code = rx_payload[0]; //command or request code is found at the beginning of the payload
+		//if this is a retransmission of a sequenced message we've already handled, just send the same response again
+		if(sequenced) {
+			message_crc = (uint16_t)((rx_packet[pl_start + plen] << 8) | rx_packet[pl_start + plen + 1]);
+			size_t cached_length;
+			if(replay_response(seq, message_crc, tx_packet, cached_length)) return cached_length;
+		}
 
-		//act slightly differently based on the possible message response types
-		switch(message_code) {
+		//create some local variables to pass the command or request handlers
+		//responses are capped at what fits in a message of the same format as the request
+		std::span<uint8_t, std::dynamic_extent> rx_payload = rx_packet.subspan(pl_start, plen);
+		std::span<uint8_t, std::dynamic_extent> tx_payload = tx_packet.subspan(pl_start, std::min(tx_packet.size() - format.packet_overhead, format.max_plen));
 
-		//handle an ALL_DEVICES and SINGLE_DEVICE message the same way
-			case HOST_COMMAND_ALL_DEVICES:
-			case HOST_COMMAND_TO_DEVICE:
-				//if the command is mapped, run it and record the function responses
-				if(command_handler_map[command_request_code] != nullptr) {
-					std::tie(response_type, response_plen) = command_handler_map[command_request_code](rx_payload, tx_payload);
-				}
-				//if it wasn't mapped, respond with a NACK
-				else {
-					response_type = DEVICE_NACK_HOST_MESSAGE;
-					response_plen = 1;
-					tx_packet[PL_START_INDEX] = (uint8_t)NACK_ERROR_UNKNOWN_COMMAND_CODE;
-				}
-
-				//that's all we have to do here really
-				break;
-
-			//handle a request code
-			case HOST_REQUEST_FROM_DEVICE:
-				//if the request is mapped, run it and record the function responses
-				if(request_handler_map[command_request_code] != nullptr) {
-					std::tie(response_type, response_plen) = request_handler_map[command_request_code](rx_payload, tx_payload);
-				}
-				//if it wasn't mapped, respond with a NACK
-				else {
-					response_type = DEVICE_NACK_HOST_MESSAGE;
-					response_plen = 1;
-					tx_packet[PL_START_INDEX] = (uint8_t)NACK_ERROR_UNKNOWN_REQUEST_CODE;
-				}
-
-				//that's all we really need to do here
-				break;
-
-			//if we're here, we received an invalid message code
-			//send a NACK back with the appropriate error code
-			default:
-				response_type = DEVICE_NACK_HOST_MESSAGE;
-				response_plen = 1;
-				tx_packet[PL_START_INDEX] = (uint8_t)NACK_ERROR_UNKNOWN_MSG_TYPE;
-				break;
-		}
+		//batches get unpacked and each message inside dispatched individually
+		//everything else goes straight to the appropriate handler
+		if(message_code == (uint8_t)HOST_BATCH_TO_DEVICE)
+			std::tie(response_type, response_plen) = parse_batch(rx_payload, tx_payload);
+		else
+			std::tie(response_type, response_plen) = dispatch(message_code, rx_payload, tx_payload);
+		dispatched = true;
 	}
 
 	/*TODO: clean up and sanity-check the command/request handler?*/
 
 	//pack the "vitals" of the message appropriately
-	tx_packet[ID_INDEX] = dest_id; //message is coming from this device address
-	tx_packet[MTYPE_INDEX] = (uint8_t)response_type; //we're sending this kinda message
-	tx_packet[PLEN_INDEX] = (uint8_t)response_plen; //and the payload contains this many bytes
-	size_t response_length_with_prefix = response_plen + PACKET_PREFIX_OVERHEAD;
+	//always respond with our own address, so responses to broadcasts say who they came from
+	size_t response_length = pack_vitals((uint8_t)device_address, response_type, response_plen, format, seq, tx_packet);
+
+	//don't respond in the case of ALL_DEVICES command
+	if(message_code == (uint8_t)HOST_COMMAND_ALL_DEVICES) response_length = 0;
+
+	//remember what we responded with, in case the host asks again
+	if(sequenced && dispatched) cache_response(seq, message_crc, tx_packet.subspan(0, response_length));
+
+	//return the length of our response
+	return response_length;
+}
+
+//wrap up a message the device is sending of its own accord
+size_t Parser::pack_message(	const MessageType_t message_type, const size_t plen,
+								std::span<uint8_t, std::dynamic_extent> tx_packet,
+								const bool extended)
+{
+	//make sure the payload is a legal size and the whole packet fits
+	Message_Format_t format = message_format(extended ? MTYPE_FLAG_EXTENDED : 0);
+	if(plen < MIN_PAYLOAD_LENGTH || plen > format.max_plen) return 0;
+	if(tx_packet.size() < plen + format.prefix_overhead + 2) return 0;
+
+	//message is coming from this device
+	return pack_vitals((uint8_t)device_address, message_type, plen, format, 0, tx_packet);
+}
+
+//==================================== PRIVATE FUNCTIONS ====================================
+
+//work out the layout of a message from the flag bits of its MTYPE
+Parser::Message_Format_t Parser::message_format(const uint8_t flags) {
+	bool extended = flags & MTYPE_FLAG_EXTENDED;
+	bool sequenced = flags & MTYPE_FLAG_SEQUENCED;
+
+	Message_Format_t format;
+	format.flags = flags & (MTYPE_FLAG_EXTENDED | MTYPE_FLAG_SEQUENCED);
+	format.prefix_overhead = (extended ? PACKET_PREFIX_OVERHEAD_EXTENDED : PACKET_PREFIX_OVERHEAD) + (sequenced ? SEQ_OVERHEAD : 0);
+	format.packet_overhead = (extended ? PACKET_OVERHEAD_EXTENDED : PACKET_OVERHEAD) + (sequenced ? SEQ_OVERHEAD : 0);
+	format.max_plen = (extended ? Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH : Cobs::MSG_MAX_UNENCODED_LENGTH) - format.packet_overhead;
+	return format;
+}
+
+//drop the ID, MTYPE, PLEN, SEQ (if applicable) and CRC around the payload
+size_t Parser::pack_vitals(	const uint8_t id, const MessageType_t message_type, const size_t plen,
+							const Message_Format_t& format, const uint8_t seq,
+							std::span<uint8_t, std::dynamic_extent> tx_packet)
+{
+	tx_packet[ID_INDEX] = id; //message is coming from this device address
+	tx_packet[MTYPE_INDEX] = (uint8_t)message_type | format.flags; //we're sending this kinda message, formatted the same way as what we received
+	if(format.flags & MTYPE_FLAG_EXTENDED) {
+		tx_packet[PLEN_INDEX] = (uint8_t)(plen >> 8); //and the payload contains this many bytes, high byte first
+		tx_packet[PLEN_LOW_INDEX_EXTENDED] = (uint8_t)(plen & 0xFF);
+	}
+	else
+		tx_packet[PLEN_INDEX] = (uint8_t)plen; //and the payload contains this many bytes
+	if(format.flags & MTYPE_FLAG_SEQUENCED)
+		tx_packet[format.prefix_overhead - SEQ_OVERHEAD] = seq; //echo the sequence number back
+	size_t length_with_prefix = plen + format.prefix_overhead;
 
 	//compute the CRC of the message accordingly
-	uint16_t tx_crc = crc_comp.compute_crc(tx_packet.subspan(0, response_length_with_prefix));
+	uint16_t tx_crc = crc_comp.compute_crc(tx_packet.subspan(0, length_with_prefix));
 	//put the bytes of the crc at the end of the message, high-byte first (Big Endian)
-	tx_packet[response_length_with_prefix] = (uint8_t)(0xFF & (tx_crc >> 8));
-	tx_packet[response_length_with_prefix + 1] = (uint8_t)(0xFF & (tx_crc));
+	tx_packet[length_with_prefix] = (uint8_t)(0xFF & (tx_crc >> 8));
+	tx_packet[length_with_prefix + 1] = (uint8_t)(0xFF & (tx_crc));
+	return length_with_prefix + 2;
+}
 
-	//return the length of our response; but don't respond in the case of ALL_DEVICES command
-	if(message_code == (uint8_t)HOST_COMMAND_ALL_DEVICES) return 0;
-	return (int16_t)response_plen + PACKET_VITALS_OVERHEAD;
+bool Parser::replay_response(	const uint8_t seq, const uint16_t message_crc,
+								std::span<uint8_t, std::dynamic_extent> tx_packet, size_t& response_length)
+{
+	//see if we've got a response to this exact message
+	Cached_Response_t& entry = response_cache[seq % RESPONSE_CACHE_DEPTH];
+	if(!entry.valid || entry.seq != seq || entry.message_crc != message_crc) return false;
+	if(tx_packet.size() < entry.length) return false;
+
+	//and send it right back
+	std::copy(entry.packet.begin(), entry.packet.begin() + entry.length, tx_packet.begin());
+	response_length = entry.length;
+	return true;
 }
 
-//quick method to initialize the address of the device
-//need to happen outside of the constructor
-void Parser::set_address(uint8_t address) {
-	device_address = (size_t)address;
+void Parser::cache_response(	const uint8_t seq, const uint16_t message_crc,
+								const std::span<uint8_t, std::dynamic_extent> response)
+{
+	//overwrite whatever was in the slot--that message is outside the window by now
+	Cached_Response_t& entry = response_cache[seq % RESPONSE_CACHE_DEPTH];
+	entry.valid = response.size() <= RESPONSE_CACHE_SLOT_SIZE; //too long to remember, so it'll get recomputed if the host asks again
+	if(!entry.valid) return;
+	entry.seq = seq;
+	entry.message_crc = message_crc;
+	entry.length = response.size();
+	std::copy(response.begin(), response.end(), entry.packet.begin());
+}
+
+//run the command or request handler corresponding to the particular message
+//NACKs if the message type or command/request code is unknown
+std::pair<Parser::MessageType_t, size_t> Parser::dispatch(	const uint8_t message_code,
+															const std::span<uint8_t, std::dynamic_extent> rx_payload,
+															std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	//need at least a byte to NACK with
+	if(tx_payload.empty()) return std::make_pair(DEVICE_NACK_HOST_MESSAGE, 0);
+
+	//command or request code is found at the beginning of the payload
+	uint8_t command_request_code = rx_payload[0];
+
+	//act slightly differently based on the possible message response types
+	switch(message_code) {
+
+		//handle an ALL_DEVICES and SINGLE_DEVICE message the same way
+		case HOST_COMMAND_ALL_DEVICES:
+		case HOST_COMMAND_TO_DEVICE:
+			//if the command is mapped, run it and return the function responses
+			if(command_table[command_request_code] != nullptr)
+				return command_table[command_request_code](rx_payload, tx_payload);
+
+			//if it wasn't mapped, respond with a NACK
+			tx_payload[0] = (uint8_t)NACK_ERROR_UNKNOWN_COMMAND_CODE;
+			return std::make_pair(DEVICE_NACK_HOST_MESSAGE, 1);
+
+		//handle a request code
+		case HOST_REQUEST_FROM_DEVICE:
+			//if the request is mapped, run it and return the function responses
+			if(request_table[command_request_code] != nullptr)
+				return request_table[command_request_code](rx_payload, tx_payload);
+
+			//if it wasn't mapped, respond with a NACK
+			tx_payload[0] = (uint8_t)NACK_ERROR_UNKNOWN_REQUEST_CODE;
+			return std::make_pair(DEVICE_NACK_HOST_MESSAGE, 1);
+
+		//if we're here, we received an invalid message code
+		//send a NACK back with the appropriate error code
+		default:
+			tx_payload[0] = (uint8_t)NACK_ERROR_UNKNOWN_MSG_TYPE;
+			return std::make_pair(DEVICE_NACK_HOST_MESSAGE, 1);
+	}
 }
 
-//bounds check the command code
-//and if that checks out, store that in the command handler map
-void Parser::attach_command_cb(const size_t command_code, const command_handler_t command_handler) {
-	if(command_code < Parser::COMMAND_CODE_MIN) return;
-	if(command_code > Parser::COMMAND_CODE_MAX) return;
-	//ASSERT(command_handler_map[command_code] == nullptr); //this would be useful to ensure all commands map to unique values
-	Parser::command_handler_map[command_code] = command_handler;
+//walk through all the sub-messages in a batch, dispatching each one and packing its response right after the previous
+std::pair<Parser::MessageType_t, size_t> Parser::parse_batch(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	size_t rx_index = 0; //where the next sub-message starts in the received payload
+	size_t tx_index = 0; //where the next sub-response goes in the transmit payload
+
+	while(rx_index < rx_payload.size()) {
+		//make sure we have room for a sub-response header and at least one byte of payload (enough for a NACK)
+		//if we don't, stop here--host can tell which sub-messages weren't executed by counting the sub-responses
+		if(tx_payload.size() - tx_index < BATCH_SUB_OVERHEAD + 1) break;
+		std::span<uint8_t, std::dynamic_extent> sub_tx = tx_payload.subspan(tx_index);
+
+		//check that the sub-message header is there, the sub-message has a payload, and it doesn't run past the batch
+		size_t rx_remaining = rx_payload.size() - rx_index;
+		size_t sub_plen = (rx_remaining >= BATCH_SUB_OVERHEAD) ? rx_payload[rx_index + BATCH_SUB_PLEN_INDEX] : 0;
+		if(sub_plen < MIN_PAYLOAD_LENGTH || sub_plen > rx_remaining - BATCH_SUB_OVERHEAD) {
+			//NACK this sub-message and bail--we can't tell where the next one would start
+			sub_tx[BATCH_SUB_TYPE_INDEX] = (uint8_t)DEVICE_NACK_HOST_MESSAGE;
+			sub_tx[BATCH_SUB_PLEN_INDEX] = 1;
+			sub_tx[BATCH_SUB_PL_START_INDEX] = (uint8_t)NACK_ERROR_INVALID_MSG_SIZE;
+			tx_index += BATCH_SUB_OVERHEAD + 1;
+			break;
+		}
+
+		MessageType_t sub_response_type;
+		size_t sub_response_plen;
+		uint8_t sub_type = rx_payload[rx_index + BATCH_SUB_TYPE_INDEX];
+
+		//only single-device commands and requests are allowed inside a batch
+		if(sub_type != (uint8_t)HOST_COMMAND_TO_DEVICE && sub_type != (uint8_t)HOST_REQUEST_FROM_DEVICE) {
+			sub_response_type = DEVICE_NACK_HOST_MESSAGE;
+			sub_response_plen = 1;
+			sub_tx[BATCH_SUB_PL_START_INDEX] = (uint8_t)NACK_ERROR_UNKNOWN_MSG_TYPE;
+		}
+
+		//dispatch the sub-message, letting the handler write its payload after the sub-response header
+		//giving it only the space we have left (and no more than a single-byte SUBPLEN can describe), so handlers can bounds check as usual
+		else {
+			std::tie(sub_response_type, sub_response_plen) = dispatch(	sub_type,
+																		rx_payload.subspan(rx_index + BATCH_SUB_PL_START_INDEX, sub_plen),
+																		sub_tx.subspan(BATCH_SUB_PL_START_INDEX,
+																				std::min<size_t>(sub_tx.size() - BATCH_SUB_PL_START_INDEX, UINT8_MAX)));
+		}
+
+		//and stick the header on the sub-response
+		sub_tx[BATCH_SUB_TYPE_INDEX] = (uint8_t)sub_response_type;
+		sub_tx[BATCH_SUB_PLEN_INDEX] = (uint8_t)sub_response_plen;
+
+		//move onto the next sub-message
+		rx_index += BATCH_SUB_OVERHEAD + sub_plen;
+		tx_index += BATCH_SUB_OVERHEAD + sub_response_plen;
+	}
+
+	return std::make_pair(DEVICE_RESPONSE_HOST_BATCH, tx_index);
 }
 
-//bounds check the request code
-//and if that checks out, store that in the request handler map
-void Parser::attach_request_cb(const size_t request_code, const request_handler_t request_handler) {
-	if(request_code < Parser::REQUEST_CODE_MIN) return;
-	if(request_code > Parser::REQUEST_CODE_MAX) return;
-	//ASSERT(request_handler_map[request_code] == nullptr); //this would be useful to ensure all requests map to unique values
-	Parser::request_handler_map[request_code] = request_handler;
+//quick method to initialize the address of the device
+//need to happen outside of the constructor
+void Parser::set_address(uint8_t address) {
+	device_address = (size_t)address;
 }
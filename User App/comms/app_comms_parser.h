@@ -33,18 +33,28 @@
  *   		as of now the protocol can support 256 nodes
  *
  *   	- MTYPE
- *   		...top 5 bits of this message are RESERVED - will either expand this to more ID bits or other message types (or who knows that's why they're reserved i guess)
+ *   		...top bit flags an EXTENDED frame (see below)
+ *   		...next bit flags a SEQUENCED message (see below)
+ *   		...the 2 bits under that are RESERVED - will either expand this to more ID bits or other message types (or who knows that's why they're reserved i guess)
  *   		Message types are as follows:
  *   			0x0 --> HOST_COMMAND_ALL_DEVICES: host writes this ADDRESSING ALL DEVICES ON BUS; useful for ARMing all amplifiers on the bus
  *   				\--> NO DEVICES WILL ACK OR NACK THIS MESSAGE!
  *   				\--> formatted just like any other command message
  *   			0x1 --> HOST_COMMAND_TO_DEVICE: host writes this to write parameters to the device; payload contains the particular command and the parameter values associated with the command
  *   			0x2 --> HOST_REQUEST_FROM_DEVICE: host writes this to read parameters to device; payload contains a code corresponding to a value the host wants to read
- *   			0x3 --> reserved
+ *   			0x3 --> HOST_BATCH_TO_DEVICE: host writes this to send a bunch of commands and/or requests in a single frame (see below)
  *   			0x4 --> DEVICE_NACK_HOST_MESSAGE: node responds with this message type when there was some issue with the previous packet (payload will contain message descrption)
  *   			0x5 --> DEVICE_ACK_HOST_COMMAND: node responds with this message when host command successfully received/written; payload mirrors payload written to device
  *   			0x6 --> DEVICE_RESPONSE_HOST_REQUEST:node responds with this message with the data host requested; data delivered in message payload
- *   			0x7 --> reserved
+ *   			0x7 --> DEVICE_RESPONSE_HOST_BATCH: node responds with this to a batch; payload contains a response to each message in the batch
+ *   			0x8 --> DEVICE_TELEMETRY: node sends this UNPROMPTED while the host is subscribed to telemetry (see `app_comms_telemetry.h` for the payload)
+ *   				\--> the host never sends this, and never responds to it
+ *   			0x9 --> DEVICE_TRACE: node sends this UNPROMPTED while the host has trace streaming on (see `app_utils_trace.h` for the payload)
+ *   				\--> same deal as telemetry; the host never sends this, and never responds to it
+ *   			0xA --> DEVICE_PARAM_CHANGE: node sends this UNPROMPTED when a parameter the host subscribed to changes (see `app_comms_param_notify.h` for the payload)
+ *   				\--> same deal as telemetry; the host never sends this, and never responds to it
+ *   			0xB --> DEVICE_DEBUG_TEXT: node sends this UNPROMPTED when firmware prints debug text (see `app_utils_debug_print.h` for the payload)
+ *   				\--> same deal as telemetry; the host never sends this, and never responds to it
  *
  *   	- PLEN
  *   		...payload length of the particular message packet--all messages have a payload length between 1-248 bytes
@@ -84,6 +94,52 @@
  *		- The payload of all RESPONSE messages will have the REQUEST CODE at payload[0] and the rest of the payload message following appropriately (payload[1:n-1]) for n payload bytes
  *		- The payload of all COMMAND messages will have the COMMAND CODE at payload[0] and that's it
  *
+ *	EXTENDED FRAMES:
+ *		For bulk transfers, set the top bit of MTYPE (MTYPE_FLAG_EXTENDED) and PLEN grows to two bytes:
+ *			[0]		ID
+ *			[1]		MTYPE | 0x80
+ *			[2]		PLENh		payload length high byte
+ *			[3]		PLENl		payload length low byte
+ *			[4...]	payload, then CRCh and CRCl like usual
+ *		These get sent in extended COBS frames (see `app_comms_cobs.h`), so payloads can run up to MAX_PAYLOAD_LENGTH_EXTENDED bytes
+ *		The response to an extended message is extended as well; everything else about the message is exactly the same
+ *		Short frames are unaffected, so hosts that don't care about any of this can keep doing what they've been doing
+ *
+ *	SEQUENCED MESSAGES:
+ *		To keep more than one message in flight, set bit 6 of MTYPE (MTYPE_FLAG_SEQUENCED); a SEQ byte then follows the PLEN field(s):
+ *			[0]		ID
+ *			[1]		MTYPE | 0x40
+ *			[2]		PLEN		(or PLENh, PLENl for an extended message)
+ *			[3]		SEQ			0x0 - 0xFF, host increments this for every new message
+ *			[4...]	payload, then CRCh and CRCl like usual
+ *		The response carries the same SEQ, so the host can match responses to messages no matter how late they show up
+ *		The device remembers its responses to the last RESPONSE_CACHE_DEPTH sequenced messages
+ *			\--> if the host retransmits a message (i.e. the response got lost or mangled), the device re-sends the original response
+ *				  WITHOUT running the command again; so retrying a command is always safe
+ *			\--> a message counts as a retransmission if both its SEQ and CRC match one we've already handled
+ *			\--> responses too long to remember (i.e. long extended responses) just get recomputed on retransmission
+ *		So a host can keep up to RESPONSE_CACHE_DEPTH messages in flight, retransmitting any that time out or get a CRC NACK
+ *		Flags can be combined; an extended sequenced message has both PLEN bytes and then SEQ
+ *
+ *	BATCHES:
+ *		The payload of a HOST_BATCH_TO_DEVICE message is just a bunch of sub-messages back to back, each formatted as:
+ *			[0]			SUBTYPE		HOST_COMMAND_TO_DEVICE (0x1) or HOST_REQUEST_FROM_DEVICE (0x2)
+ *			[1]			SUBPLEN		payload length of the sub-message (at least 1)
+ *			[2:n+1]		SUBPL		payload of the sub-message, exactly as it would be in a standalone message
+ *		Each sub-message is dispatched in order, just as if it arrived in its own frame
+ *		The payload of the DEVICE_RESPONSE_HOST_BATCH response holds one sub-response per sub-message, in the same order, formatted the same way
+ *			\--> SUBTYPE of each sub-response is the ACK/NACK/RESPONSE type the handler would've responded with standalone
+ *		If a sub-message header is malformed, it's NACKed with an invalid message size error and the rest of the batch is skipped
+ *		If the response runs out of room, the rest of the batch is skipped; count the sub-responses to see how far we got
+ *
+ *	BROADCASTS:
+ *		A command, request or batch sent to ID BROADCAST_ADDRESS (0xFF) is handled by every device on the bus, and every device responds
+ *			\--> unlike HOST_COMMAND_ALL_DEVICES, which nobody responds to
+ *		Responses always carry the ID of the device sending them, so the host can tell who said what
+ *		On a multi-drop bus the responses would all land on top of each other, so each device holds its response back to its own reply slot
+ *		(see `Comms_Exec_Subsystem::Multidrop_Config_t`); the host just has to wait out every slot before sending anything else
+ *		NOTE: this makes 0xFF unusable as a device address
+ *
  */
 
 #ifndef COMMS_APP_COMMS_PARSER_H_
@@ -92,11 +148,9 @@
 #include <stddef.h> //for size_t
 #include <span> //for stl interfaces
 #include <utility> //for pair (for responses from command and request handlers
-
-extern "C" {
-	#include "stm32g474xx.h" //for uint8_t type
-}
-
+#include <array> //for the response cache and dispatch tables
+#include <initializer_list> //for building dispatch tables out of a bunch of handler lists
+#include <stdint.h> //for uint8_t type; no device headers here so this builds for the host too
 
 #include "app_comms_cobs.h" //for message lengths and such
 #include "app_comms_crc.h" //so we can hang onto a CRC instance
@@ -111,11 +165,28 @@ public:
 		HOST_COMMAND_ALL_DEVICES = 		(uint8_t)0x0,
 		HOST_COMMAND_TO_DEVICE = 		(uint8_t)0x1,
 		HOST_REQUEST_FROM_DEVICE = 		(uint8_t)0x2,
+		HOST_BATCH_TO_DEVICE =			(uint8_t)0x3,
 		DEVICE_NACK_HOST_MESSAGE = 		(uint8_t)0x4,
 		DEVICE_ACK_HOST_MESSAGE = 		(uint8_t)0x5,
 		DEVICE_RESPONSE_HOST_REQUEST =	(uint8_t)0x6,
+		DEVICE_RESPONSE_HOST_BATCH =	(uint8_t)0x7,
+		DEVICE_TELEMETRY =				(uint8_t)0x8,
+		DEVICE_TRACE =					(uint8_t)0x9,
+		DEVICE_PARAM_CHANGE =			(uint8_t)0xA,
+		DEVICE_DEBUG_TEXT =				(uint8_t)0xB,
 	} ;
-	static constexpr uint8_t MESSAGE_TYPE_MASK = 0x07; //mask the MTYPE packet with this to look up the message type
+	static constexpr uint8_t MESSAGE_TYPE_MASK = 0x0F; //mask the MTYPE packet with this to look up the message type
+	static constexpr uint8_t MTYPE_FLAG_EXTENDED = 0x80; //set in MTYPE for messages with a two-byte PLEN
+	static constexpr uint8_t MTYPE_FLAG_SEQUENCED = 0x40; //set in MTYPE for messages carrying a SEQ byte
+
+	//every device acts on (and responds to) messages sent here
+	static constexpr uint8_t BROADCAST_ADDRESS = 0xFF;
+
+	//would a device at `address` act on a message with this ID and MTYPE
+	//no CRC involved, so this works on the first couple bytes of a frame (i.e. to throw away other devices' traffic as it streams in)
+	static constexpr bool addressed_to(const uint8_t dest_id, const uint8_t mtype, const uint8_t address) {
+		return dest_id == address || dest_id == BROADCAST_ADDRESS || (mtype & MESSAGE_TYPE_MASK) == (uint8_t)HOST_COMMAND_ALL_DEVICES;
+	}
 
 	//enum type for not-acknowledge responses
 	enum NACKErrorTypes_t {
@@ -143,13 +214,32 @@ public:
 	static constexpr size_t MAX_PAYLOAD_LENGTH = Cobs::MSG_MAX_UNENCODED_LENGTH - PACKET_OVERHEAD; //maximum length of a packet payload
 	static constexpr size_t MIN_PAYLOAD_LENGTH = 1; //every packet has to have at least a single payload byte
 
+	//same as above, but for extended messages--the extra PLEN byte pushes everything back by one
+	static constexpr size_t PLEN_LOW_INDEX_EXTENDED = 3;
+	static constexpr size_t PACKET_PREFIX_OVERHEAD_EXTENDED = PACKET_PREFIX_OVERHEAD + 1;
+	static constexpr size_t PL_START_INDEX_EXTENDED = PL_START_INDEX + 1;
+	static constexpr size_t PACKET_OVERHEAD_EXTENDED = PACKET_OVERHEAD + 1;
+	static constexpr size_t MAX_PAYLOAD_LENGTH_EXTENDED = Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH - PACKET_OVERHEAD_EXTENDED;
+
+	//sequenced messages carry one more byte (SEQ) right before the payload; costs a byte of payload
+	static constexpr size_t SEQ_OVERHEAD = 1;
+
+	//how many sequenced responses we remember for retransmissions, i.e. how many messages the host can have in flight
+	static constexpr size_t RESPONSE_CACHE_DEPTH = 8;
+
+	//layout of a sub-message within a batch
+	static constexpr size_t BATCH_SUB_TYPE_INDEX = 0;
+	static constexpr size_t BATCH_SUB_PLEN_INDEX = 1;
+	static constexpr size_t BATCH_SUB_PL_START_INDEX = 2;
+	static constexpr size_t BATCH_SUB_OVERHEAD = 2; //type and length bytes
+
 	//for our current set of commands, we can handle this range of codes
-	//useful for bounds checking the callback attachement functions
+	//useful for bounds checking the dispatch table generation
 	static constexpr size_t COMMAND_CODE_MIN = 0;
 	static constexpr size_t COMMAND_CODE_MAX = 0xFF;
 
 	//for our current set of requests, we can handle this range of codes
-	//useful for bounds-checking the callback attachement functions
+	//useful for bounds-checking the dispatch table generation
 	static constexpr size_t REQUEST_CODE_MIN = 0;
 	static constexpr size_t REQUEST_CODE_MAX = 0xFF;
 
@@ -182,9 +272,34 @@ public:
 	typedef std::pair<size_t, command_handler_t> command_mapping_t;
 	typedef std::pair<size_t, request_handler_t> request_mapping_t;
 
+	//every command/request code indexes straight into one of these to find its handler (nullptr if nothing's mapped to that code)
+	//one entry per possible code, so any code byte we receive is in bounds
+	//command and request handlers have the same signature, so one table type does for both
+	typedef std::array<command_handler_t, COMMAND_CODE_MAX + 1> dispatch_table_t;
+	static_assert(REQUEST_CODE_MAX + 1 == std::tuple_size<dispatch_table_t>::value, "request codes need to fit in a dispatch table too");
+
+	//build a dispatch table out of a handful of handler lists (i.e. `X_Command_Handlers::command_handlers()`)
+	//`consteval` --> this ONLY ever runs in the compiler; the resulting table gets stored in flash
+	//two handlers mapped to the same code, or a code outside of the table, is a COMPILE ERROR
+	//	\--> the compiler complains about a call to `ERROR_DUPLICATE_HANDLER_CODE` or `ERROR_HANDLER_CODE_OUT_OF_RANGE`
+	//	\--> look for the handler lists passed in at the bottom of the error message to see where the collision is
+	static consteval dispatch_table_t make_dispatch_table(std::initializer_list<std::span<const command_mapping_t, std::dynamic_extent>> handler_lists) {
+		dispatch_table_t table{};
+		for(auto& handler_list : handler_lists) {
+			for(auto& [code, handler] : handler_list) {
+				if(code > COMMAND_CODE_MAX) ERROR_HANDLER_CODE_OUT_OF_RANGE();
+				if(table[code] != nullptr) ERROR_DUPLICATE_HANDLER_CODE();
+				table[code] = handler;
+			}
+		}
+		return table;
+	}
+
 	//==============================================================================================================
 
-	Parser(Comms_CRC& _crc_comp);
+	//hang onto the command and request dispatch tables (see `make_dispatch_table()`)
+	//tables need to outlive the parser; i.e. `static constexpr` tables
+	Parser(Comms_CRC& _crc_comp, const dispatch_table_t& _command_table, const dispatch_table_t& _request_table);
 
 	//set the device address on the multi-drop serial bus
 	//can't be passed in via constructor since this is read from dip switches during boot
@@ -196,23 +311,80 @@ public:
 	size_t parse_buffer(	const std::span<uint8_t, std::dynamic_extent> rx_packet,
 							std::span<uint8_t, std::dynamic_extent> tx_packet);
 
-	//attach command and request handlers to particular command and request codes
-	void attach_command_cb(const size_t command_code, const command_handler_t command_handler);
-	void attach_request_cb(const size_t request_code, const request_handler_t request_handler);
+	//same as above, but for packets whose CRC has already been checked (i.e. by the streaming decoder as the packet arrived)
+	size_t parse_buffer(	const std::span<uint8_t, std::dynamic_extent> rx_packet,
+							std::span<uint8_t, std::dynamic_extent> tx_packet,
+							const bool crc_good);
+
+	//wrap a device-initiated message (i.e. telemetry) whose payload is already sitting at `PL_START_INDEX` of `tx_packet`
+	//(or `PL_START_INDEX_EXTENDED` for an extended message)
+	//fills in the vitals and CRC; returns how many bytes the packet contains
+	size_t pack_message(	const MessageType_t message_type, const size_t plen,
+							std::span<uint8_t, std::dynamic_extent> tx_packet,
+							const bool extended = false);
 
 private:
 	//know the address of the particular device on the
 	size_t device_address = -1;
 
+	//where everything sits in a message, depending on which MTYPE flags are set
+	struct Message_Format_t {
+		uint8_t flags; //just the flag bits of MTYPE
+		size_t prefix_overhead; //bytes before the payload
+		size_t packet_overhead; //bytes that aren't payload (with the same margin as PACKET_OVERHEAD)
+		size_t max_plen; //longest payload that fits
+	};
+	static Message_Format_t message_format(const uint8_t flags);
+
+	//responses to recent sequenced messages, slotted by SEQ
+	//the CRC of the message is stored alongside so a new message that just happens to reuse an old SEQ isn't mistaken for a retransmission
+	static constexpr size_t RESPONSE_CACHE_SLOT_SIZE = Cobs::MSG_MAX_UNENCODED_LENGTH;
+	struct Cached_Response_t {
+		bool valid;
+		uint8_t seq;
+		uint16_t message_crc;
+		size_t length;
+		std::array<uint8_t, RESPONSE_CACHE_SLOT_SIZE> packet;
+	};
+	std::array<Cached_Response_t, RESPONSE_CACHE_DEPTH> response_cache = {};
+
+	//copy the remembered response to a message into `tx_packet`, if we have one; returns false if this message is new to us
+	bool replay_response(	const uint8_t seq, const uint16_t message_crc,
+							std::span<uint8_t, std::dynamic_extent> tx_packet, size_t& response_length);
+
+	//remember the response to a message; forgets the slot if the response doesn't fit
+	void cache_response(	const uint8_t seq, const uint16_t message_crc,
+							const std::span<uint8_t, std::dynamic_extent> response);
+
 	//have access to a crc instance to compute and validate our CRCs
 	//owned and initialized by a higher level class
 	Comms_CRC crc_comp;
 
-	//have an array of callback functions that map a command/request code to a firmware callback function
-	//technically not the most memory efficiency way to map command/requests to firmware functions
-	//but I think this is pretty elegant, and we have a decent amount of memory to access
-	command_handler_t command_handler_map[COMMAND_CODE_MAX] = {NULL};
-	request_handler_t request_handler_map[REQUEST_CODE_MAX] = {NULL};
+	//tables that map a command/request code to a firmware callback function
+	//technically not the most memory efficient way to map command/requests to firmware functions
+	//but it's just a single lookup, and they're generated at compile time so they sit in flash rather than RAM
+	const dispatch_table_t& command_table;
+	const dispatch_table_t& request_table;
+
+	//deliberately NOT constexpr (and never defined)--`make_dispatch_table()` calls these when it finds a bad mapping
+	//which the compiler refuses to do at compile time, so they show up by name in the compile error
+	static void ERROR_DUPLICATE_HANDLER_CODE();
+	static void ERROR_HANDLER_CODE_OUT_OF_RANGE();
+
+	//fill in the ID, MTYPE, PLEN and CRC around a payload that's already in place
+	//returns how many bytes the packet contains
+	size_t pack_vitals(	const uint8_t id, const MessageType_t message_type, const size_t plen,
+						const Message_Format_t& format, const uint8_t seq,
+						std::span<uint8_t, std::dynamic_extent> tx_packet);
+
+	//run the appropriate handler for a single command or request
+	std::pair<MessageType_t, size_t> dispatch(	const uint8_t message_code,
+												const std::span<uint8_t, std::dynamic_extent> rx_payload,
+												std::span<uint8_t, std::dynamic_extent> tx_payload);
+
+	//unpack a batch message, dispatching every sub-message and packing all their responses together
+	std::pair<MessageType_t, size_t> parse_batch(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+													std::span<uint8_t, std::dynamic_extent> tx_payload);
 
 };
 
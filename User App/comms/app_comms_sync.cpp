@@ -0,0 +1,165 @@
+/*
+ * app_comms_sync.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#include "app_comms_sync.h"
+
+#include <algorithm> //for copy
+
+#include "app_hal_timing.h" //for the cycle counter
+#include "app_cmhand_mapping.h" //for the commands we're willing to schedule
+#include "app_utils_trace.h" //to log when scheduled commands run
+
+Comms_Sync_Scheduler::Comms_Sync_Scheduler(const Parser::dispatch_table_t& _command_table):
+	command_table(_command_table)
+{}
+
+//================================== MAIN LOOP ==================================
+
+Comms_Sync_Scheduler::Schedule_Result_t Comms_Sync_Scheduler::schedule(	const std::span<const uint8_t, std::dynamic_extent> command,
+																		const uint32_t arrival_cycles, const uint32_t delay_us)
+{
+	//sanity check the command itself
+	if(command.empty() || command.size() > SLOT_COMMAND_LENGTH || delay_us > MAX_DELAY_US) return OUT_OF_RANGE;
+	Parser::command_handler_t handler = command_table[command[0]];
+	if(handler == nullptr) return UNKNOWN_COMMAND;
+
+	//only let through commands we know are fine to run from the regulator ISR
+	if(!schedulable(command[0])) return OUT_OF_RANGE;
+
+	//grab a free slot; only the main loop ever takes slots out of FREE, so nobody can sneak in between the check and the store
+	for(Slot_t& slot : slots) {
+		if(slot.state.load(std::memory_order_acquire) != FREE) continue;
+		slot.state.store(FILLING, std::memory_order_relaxed);
+
+		//fill it in, then arm it--release ordering so the ISR sees everything we wrote before it sees ARMED
+		slot.due_cycles = arrival_cycles + delay_us * (Timer::get_cycles_per_second() / 1000000);
+		slot.handler = handler;
+		slot.length = command.size();
+		std::copy(command.begin(), command.end(), slot.command.begin());
+		pending.fetch_add(1, std::memory_order_relaxed);
+		slot.state.store(ARMED, std::memory_order_release);
+
+		stats.scheduled.fetch_add(1, std::memory_order_relaxed);
+		return SCHEDULED;
+	}
+
+	return BUSY;
+}
+
+size_t Comms_Sync_Scheduler::cancel() {
+	size_t cancelled = 0;
+	for(Slot_t& slot : slots) {
+		//race the ISR for the slot; if it's already firing, it's too late to cancel
+		uint8_t expected = ARMED;
+		if(!slot.state.compare_exchange_strong(expected, FREE, std::memory_order_acq_rel)) continue;
+		pending.fetch_sub(1, std::memory_order_relaxed);
+		cancelled++;
+	}
+	stats.cancelled.fetch_add(cancelled, std::memory_order_relaxed);
+	return cancelled;
+}
+
+void Comms_Sync_Scheduler::loop() {
+	if(pending.load(std::memory_order_relaxed) == 0) return;
+
+	//leave everything to the regulator ISR if it's been checking in; it'll land the command on a control cycle boundary
+	uint32_t now = Timer::get_cycles();
+	uint32_t isr_timeout_cycles = ISR_TIMEOUT_US * (Timer::get_cycles_per_second() / 1000000);
+	if(serviced.load(std::memory_order_relaxed) && now - last_service_cycles.load(std::memory_order_relaxed) < isr_timeout_cycles) return;
+
+	fire_due(now);
+}
+
+//================================== REGULATOR ISR ==================================
+
+void Comms_Sync_Scheduler::service_forwarder(void* context) {
+	static_cast<Comms_Sync_Scheduler*>(context)->service();
+}
+
+void Comms_Sync_Scheduler::service() {
+	//check in so the main loop knows to leave things to us, then bail as quick as possible if nothing's scheduled
+	uint32_t now = Timer::get_cycles();
+	last_service_cycles.store(now, std::memory_order_relaxed);
+	serviced.store(true, std::memory_order_relaxed);
+	if(pending.load(std::memory_order_relaxed) == 0) return;
+
+	fire_due(now);
+}
+
+//================================== EITHER ==================================
+
+size_t Comms_Sync_Scheduler::get_pending_count() { return pending.load(std::memory_order_relaxed); }
+
+Comms_Sync_Scheduler::Sync_Stats_t Comms_Sync_Scheduler::get_stats() {
+	return {
+		.scheduled = stats.scheduled.load(std::memory_order_relaxed),
+		.applied = stats.applied.load(std::memory_order_relaxed),
+		.failed = stats.failed.load(std::memory_order_relaxed),
+		.cancelled = stats.cancelled.load(std::memory_order_relaxed),
+		.late = stats.late.load(std::memory_order_relaxed),
+		.lateness_last_us = stats.lateness_last_us.load(std::memory_order_relaxed),
+		.lateness_max_us = stats.lateness_max_us.load(std::memory_order_relaxed),
+	};
+}
+
+//================================== PRIVATE METHODS ==================================
+
+bool Comms_Sync_Scheduler::schedulable(const uint8_t code) {
+	//ALLOWLIST--these only poke at a stage's mode, its drive, or its setpoint, all of which the regulator ISR already touches
+	//anything new has to be checked against the ISR before it goes in here; everything else runs from the main loop only
+	switch(code) {
+		case CM_Mapping::STAGE_DISABLE:
+		case CM_Mapping::STAGE_ENABLE_MANUAL:
+		case CM_Mapping::STAGE_ENABLE_REGULATOR:
+		case CM_Mapping::STAGE_MANUAL_DRIVE_OFF:
+		case CM_Mapping::STAGE_MANUAL_SET_DRIVE:
+		case CM_Mapping::STAGE_MANUAL_SET_DUTIES:
+		case CM_Mapping::SETPOINT_SOFT_TRIGGER:
+		case CM_Mapping::SETPOINT_DISARM:
+		case CM_Mapping::SETPOINT_RESET:
+		case CM_Mapping::SETPOINT_DRIVE_DC:
+			return true;
+		default:
+			return false;
+	}
+}
+
+void Comms_Sync_Scheduler::fire_due(const uint32_t now) {
+	for(Slot_t& slot : slots) {
+		//only look at armed slots that are due; signed difference so this holds up across the cycle counter wrapping
+		if(slot.state.load(std::memory_order_acquire) != ARMED) continue;
+		if((int32_t)(now - slot.due_cycles) < 0) continue;
+
+		//whoever wins the slot runs it; if we lost, the command either already ran or got cancelled
+		uint8_t expected = ARMED;
+		if(!slot.state.compare_exchange_strong(expected, FIRING, std::memory_order_acq_rel)) continue;
+
+		//run the command just like the parser would, and just keep track of how it went
+		auto [response_type, response_length] = slot.handler(	std::span<uint8_t, std::dynamic_extent>(slot.command.data(), slot.length),
+																slot.response);
+		(void)response_length;
+		uint32_t lateness_us = Timer::cycles_to_us(now - slot.due_cycles);
+		uint32_t code = slot.command[0];
+
+		if(response_type == Parser::DEVICE_ACK_HOST_MESSAGE) {
+			stats.applied.fetch_add(1, std::memory_order_relaxed);
+			Trace::log<Trace::SYNC_APPLIED>(code, lateness_us);
+		}
+		else {
+			stats.failed.fetch_add(1, std::memory_order_relaxed);
+			Trace::log<Trace::SYNC_FAILED>(code, (uint32_t)slot.response[0], lateness_us);
+		}
+
+		stats.lateness_last_us.store(lateness_us, std::memory_order_relaxed);
+		if(lateness_us > stats.lateness_max_us.load(std::memory_order_relaxed)) stats.lateness_max_us.store(lateness_us, std::memory_order_relaxed);
+		if(lateness_us > LATE_THRESHOLD_US) stats.late.fetch_add(1, std::memory_order_relaxed);
+
+		//hand the slot back to the main loop
+		pending.fetch_sub(1, std::memory_order_relaxed);
+		slot.state.store(FREE, std::memory_order_release);
+	}
+}
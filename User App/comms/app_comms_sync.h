@@ -0,0 +1,143 @@
+/*
+ * app_comms_sync.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Lets the host line up a command to run at a particular point in time, rather than whenever the main loop gets around to it
+ *
+ *  Several amplifiers sharing a bus all see the EOF of a broadcast frame at (practically) the same instant, but each one parses it
+ *  whenever its main loop happens to get there--that jitter turns straight into setpoint skew between channels
+ *  So instead the host broadcasts SYNC_SCHEDULE, which carries a delay and a regular command:
+ *  	- the frame's arrival time gets stamped in the receive ISR (see `Cobs_Stream_Decoder`), so main loop latency doesn't matter
+ *  	- the command gets checked against the dispatch table and copied into a pending slot, due `delay_us` after the frame landed
+ *  	- the regulator ISR checks the slots at the START of every regulation cycle, and runs whatever's due right there
+ *  		\--> every device applies the command at the first control cycle after the same instant, before that cycle reads its setpoint
+ *  	- that hook ONLY FIRES WHILE A REGULATOR IS ENABLED; with every regulator off (i.e. scheduling a stage enable, or anything in manual mode)
+ *  	  `loop()` takes over once the ISR hasn't checked in for ISR_TIMEOUT_US, and runs commands as soon as it sees they're due
+ *  		\--> so those land with main loop jitter rather than on a control cycle boundary; still lined up across devices to within that
+ *  Pick `delay_us` comfortably longer than the worst case main loop latency; a command that was already due when it got scheduled
+ *  still runs right away, but it's counted (and traced) as late
+ *
+ *  How the main loop and ISR share the slots without disabling interrupts:
+ *  	- only the main loop fills slots (FREE --> FILLING --> ARMED)
+ *  	- whoever wants to run a slot has to win ARMED --> FIRING with a compare-and-swap; the winner runs it and frees it
+ *  	- cancelling is the same race (ARMED --> FREE), so a command is either cancelled or runs exactly once
+ *
+ *  NOTE: scheduled commands RUN IN THE REGULATOR ISR, so only an ALLOWLIST of commands can be scheduled (see `schedulable()`):
+ *  setpoint changes, manual drive changes, and stage enables/disables--everything else gets rejected with OUT_OF_RANGE
+ *  (i.e. anything touching the comms links, telemetry/trace streaming, the parameter map, switching frequency, trims or this scheduler)
+ *  NOTE: the arrival stamp only keeps 16 bits of the cycle counter (see `Cobs_Stream_Decoder::age()`), so it wraps every ~98ms at 170MHz
+ *  a SYNC_SCHEDULE frame that sits in the receive queue longer than that looks younger than it is by a multiple of ~98ms
+ *  	\--> its due time comes out late by that much (never early); keep the main loop well clear of that, or the devices won't line up
+ */
+
+#ifndef COMMS_APP_COMMS_SYNC_H_
+#define COMMS_APP_COMMS_SYNC_H_
+
+extern "C" {
+	#include "stm32g474xx.h" //for uint32_t
+}
+
+#include <array>
+#include <span>
+#include <atomic> //for sharing slots with the regulator ISR
+
+#include "app_comms_parser.h" //for the dispatch table and handler types
+
+class Comms_Sync_Scheduler {
+public:
+	static constexpr size_t SLOT_COUNT = 4; //commands that can be pending at once
+	static constexpr size_t SLOT_COMMAND_LENGTH = 32; //longest command (code + arguments) a slot can hold
+	static constexpr uint32_t MAX_DELAY_US = 10000000; //keeps due times well inside half the cycle counter's range
+
+	//without a regulator ISR checking in for this long, `loop()` takes over running due commands
+	static constexpr uint32_t ISR_TIMEOUT_US = 1000;
+	//commands that run more than this long after they were due get counted (and traced) as late
+	static constexpr uint32_t LATE_THRESHOLD_US = 100;
+
+	enum Schedule_Result_t : uint8_t {
+		SCHEDULED,			//command is pending
+		UNKNOWN_COMMAND,	//nothing mapped to that command code
+		OUT_OF_RANGE,		//delay or command too long, or the command can't be scheduled
+		BUSY,				//every slot is already pending
+	};
+
+	//free-running counts since power up
+	struct Sync_Stats_t {
+		uint32_t scheduled;			//commands accepted into a slot
+		uint32_t applied;			//commands that ran and ACKed
+		uint32_t failed;			//commands that ran and NACKed
+		uint32_t cancelled;			//commands cancelled before they were due
+		uint32_t late;				//commands that ran more than LATE_THRESHOLD_US after they were due
+		uint32_t lateness_last_us;	//how long after its due time the most recent command ran
+		uint32_t lateness_max_us;	//worst case of the above
+	};
+
+	Comms_Sync_Scheduler(const Parser::dispatch_table_t& _command_table);
+
+	//delete copy constructor and assignment operator; handlers and the regulator ISR hang onto a pointer to this
+	Comms_Sync_Scheduler(Comms_Sync_Scheduler const&) = delete;
+	void operator=(Comms_Sync_Scheduler const&) = delete;
+
+	//================== MAIN LOOP ONLY ==================
+	//hold `command` ([CODE][args...], same as the payload of a regular command) until `delay_us` after `arrival_cycles`
+	Schedule_Result_t schedule(const std::span<const uint8_t, std::dynamic_extent> command, const uint32_t arrival_cycles, const uint32_t delay_us);
+
+	//drop everything that hasn't run yet; returns how many commands got cancelled
+	size_t cancel();
+
+	//runs anything due if the regulator ISR isn't around to do it
+	void loop();
+
+	//================== REGULATOR ISR ==================
+	//attach to the start of the regulation cycle with `Context_Callback_Function<>(&scheduler, Comms_Sync_Scheduler::service_forwarder)`
+	static void service_forwarder(void* context);
+	void service();
+
+	//================== EITHER ==================
+	size_t get_pending_count();
+	Sync_Stats_t get_stats(); //copy, since the ISR can bump these at any time
+
+private:
+	enum Slot_State_t : uint8_t {
+		FREE,		//up for grabs
+		FILLING,	//main loop is copying a command in
+		ARMED,		//waiting on its due time
+		FIRING,		//somebody won the slot and is running the command
+	};
+
+	struct Slot_t {
+		std::atomic<uint8_t> state{FREE};
+		uint32_t due_cycles = 0;
+		Parser::command_handler_t handler = nullptr;
+		size_t length = 0;
+		std::array<uint8_t, SLOT_COMMAND_LENGTH> command = {};
+		std::array<uint8_t, 4> response = {}; //somewhere for the handler to write its ACK/NACK; never goes out
+	};
+
+	//run any slot that's due (and that nobody else beat us to)
+	void fire_due(const uint32_t now);
+
+	//is this command safe to run from the regulator ISR (and from `loop()`, when there's no regulator running)
+	static bool schedulable(const uint8_t code);
+
+	const Parser::dispatch_table_t& command_table;
+	std::array<Slot_t, SLOT_COUNT> slots;
+
+	std::atomic<size_t> pending{0}; //armed slots; lets the ISR skip everything when nothing's scheduled
+	std::atomic<uint32_t> last_service_cycles{0}; //when the regulator ISR last checked in
+	std::atomic<bool> serviced{false}; //...if it ever has
+
+	struct {
+		std::atomic<uint32_t> scheduled{0};
+		std::atomic<uint32_t> applied{0};
+		std::atomic<uint32_t> failed{0};
+		std::atomic<uint32_t> cancelled{0};
+		std::atomic<uint32_t> late{0};
+		std::atomic<uint32_t> lateness_last_us{0};
+		std::atomic<uint32_t> lateness_max_us{0};
+	} stats;
+};
+
+#endif /* COMMS_APP_COMMS_SYNC_H_ */
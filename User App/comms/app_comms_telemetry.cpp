@@ -0,0 +1,143 @@
+/*
+ * app_comms_telemetry.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#include "app_comms_telemetry.h"
+
+#include <string.h> //for memcpy
+#include <bit> //for popcount, has_single_bit
+#include <algorithm> //for min
+
+#include "app_comms_parser.h" //for maximum payload length
+#include "app_hal_timing.h" //for flush timeout
+#include "app_utils.h" //for packing functions
+#include "app_utils_trace.h" //to log subscriptions
+
+//the sample queue only uses a power-of-two number of slots (see `Frame_Queue`)
+static_assert(std::has_single_bit(Comms_Telemetry::SAMPLE_QUEUE_DEPTH), "sample queue depth needs to be a power of two");
+
+Comms_Telemetry::Comms_Telemetry():
+	samples(sample_storage, sample_lengths)
+{}
+
+//======================================== MAIN LOOP SIDE ========================================
+
+bool Comms_Telemetry::start(Regulator_Wrapper& _source, const uint8_t _channel, const uint8_t _signals, const uint32_t _decimation) {
+	//sanity check the subscription
+	if(_signals == 0 || (_signals & ~SIGNAL_MASK_ALL)) return false;
+	if(_decimation == 0) return false;
+
+	//detach from whatever we were streaming before, and throw away anything it left behind
+	//once the tap is off, nothing else pushes into the queue, so it's safe to drain from here
+	stop();
+	while(!samples.empty()) samples.pop();
+
+	//take on the new subscription
+	source = &_source;
+	channel = _channel;
+	signals = _signals;
+	decimation = _decimation;
+	decimation_count = _decimation;
+	next_seq = 0;
+	last_frame_ms = Timer::get_ms();
+	active = true;
+
+	//and start listening in on the regulator
+	source->attach_tap_cb(Context_Callback_Function<>(this, sample_forwarder));
+	source->enable_tap();
+	Trace::log<Trace::TELEMETRY_START>(channel, signals, decimation);
+	return true;
+}
+
+void Comms_Telemetry::stop() {
+	//stop the ISR from feeding us any more samples; anything still queued gets sent out as usual
+	if(source != nullptr) source->disable_tap();
+	active = false;
+}
+
+bool Comms_Telemetry::is_active() { return active; }
+
+bool Comms_Telemetry::frame_ready() {
+	if(samples.empty()) return false;
+
+	//send as soon as we can fill a frame, or if the samples we have have been waiting a while
+	size_t sample_size = sizeof(float) * std::popcount(signals);
+	size_t samples_per_frame = std::min<size_t>((Parser::MAX_PAYLOAD_LENGTH - SAMPLES_START_INDEX) / sample_size, UINT8_MAX);
+	if(samples.size() >= samples_per_frame) return true;
+	return (Timer::get_ms() - last_frame_ms) >= FLUSH_TIMEOUT_MS;
+}
+
+size_t Comms_Telemetry::pack_frame(std::span<uint8_t, std::dynamic_extent> tx_payload) {
+	//figure out how many samples we can fit
+	size_t sample_size = sizeof(float) * std::popcount(signals);
+	if(sample_size == 0 || tx_payload.size() < SAMPLES_START_INDEX + sample_size) return 0;
+	size_t max_count = std::min<size_t>((tx_payload.size() - SAMPLES_START_INDEX) / sample_size, UINT8_MAX);
+
+	//pull samples out of the queue and pack the signals we care about
+	//stop early if there's a gap in the sequence numbers (i.e. the ISR dropped some) so samples in a frame are always consecutive
+	size_t count = 0;
+	uint32_t first_seq = 0;
+	size_t tx_index = SAMPLES_START_INDEX;
+	while(count < max_count) {
+		std::span<uint8_t, std::dynamic_extent> slot = samples.front();
+		if(slot.empty()) break;
+
+		Sample_t sample;
+		memcpy(&sample, slot.data(), sizeof(Sample_t));
+		if(count == 0) first_seq = sample.seq;
+		else if(sample.seq != first_seq + count) break;
+
+		if(signals & SIGNAL_SETPOINT) { pack(sample.setpoint, tx_payload.subspan(tx_index, 4)); tx_index += 4; }
+		if(signals & SIGNAL_CURRENT) { pack(sample.current, tx_payload.subspan(tx_index, 4)); tx_index += 4; }
+		if(signals & SIGNAL_DRIVE) { pack(sample.drive, tx_payload.subspan(tx_index, 4)); tx_index += 4; }
+
+		samples.pop();
+		count++;
+	}
+	if(count == 0) return 0;
+
+	//and throw the header on the front
+	tx_payload[CHANNEL_INDEX] = channel;
+	tx_payload[SIGNALS_INDEX] = signals;
+	pack(first_seq, tx_payload.subspan(SEQ_INDEX, 4));
+	tx_payload[COUNT_INDEX] = (uint8_t)count;
+
+	last_frame_ms = Timer::get_ms();
+	return tx_index;
+}
+
+uint32_t Comms_Telemetry::get_dropped_count() { return dropped_count; }
+
+//======================================== ISR SIDE ========================================
+
+void Comms_Telemetry::sample_forwarder(void* context) {
+	static_cast<Comms_Telemetry*>(context)->sample();
+}
+
+void Comms_Telemetry::sample() {
+	//only grab every `decimation`-th regulation cycle
+	if(--decimation_count) return;
+	decimation_count = decimation;
+
+	//sequence number counts every sample we meant to take, so dropped ones show up as gaps
+	uint32_t seq = next_seq++;
+
+	//drop the raw values straight into the queue; if it's full, just count the loss and move on
+	std::span<uint8_t, std::dynamic_extent> slot = samples.write_slot();
+	if(slot.empty()) {
+		dropped_count = dropped_count + 1;
+		return;
+	}
+
+	Sample_t sample = {
+		.seq = seq,
+		.setpoint = source->get_last_setpoint(),
+		.current = source->get_last_current(),
+		.drive = source->get_last_output(),
+	};
+	memcpy(slot.data(), &sample, sizeof(Sample_t));
+	samples.push(sizeof(Sample_t));
+}
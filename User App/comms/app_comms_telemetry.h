@@ -0,0 +1,117 @@
+/*
+ * app_comms_telemetry.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Streams regulation loop signals (setpoint, current, drive) to the host without the host having to poll for them
+ *
+ *  The host subscribes to a channel, a set of signals and a decimation factor (via command handlers)
+ *  From then on:
+ *  	- the regulator ISR calls into `sample()` every cycle (through the regulator's tap)
+ *  		\--> every `decimation`-th cycle, the latest values get dropped into a queue along with a sequence number
+ *  		\--> a handful of stores, no packing, no CRC, no waiting--so the ISR budget stays tiny and fixed
+ *  		\--> if the queue is full, the sample is dropped (and counted); the host sees the gap in the sequence numbers
+ *  	- the comms loop packs queued samples into DEVICE_TELEMETRY frames (at most one per loop pass) whenever the UART has room
+ *
+ *  Telemetry frame payload (all values big endian, like everything else):
+ *  	[0]			CHANNEL		power stage the samples came from
+ *  	[1]			SIGNALS		bitmask of signals included in each sample (see `Signal_t`)
+ *  	[2:5]		SEQ			sequence number of the first sample in the frame (counts decimated samples since subscribing)
+ *  	[6]			COUNT		number of samples in the frame
+ *  	[7:...]		SAMPLES		COUNT samples back to back; each holds the selected signals as floats, in bit order
+ *  Samples in a frame are always consecutive; i.e. sample k has sequence number SEQ + k
+ */
+
+#ifndef COMMS_APP_COMMS_TELEMETRY_H_
+#define COMMS_APP_COMMS_TELEMETRY_H_
+
+#include <stddef.h> //for size_t
+#include <stdint.h> //for uint8_t
+#include <span> //for passing buffers around
+#include <array> //for queue storage
+
+#include "app_utils_frame_queue.h" //to hand samples from the ISR to the main loop
+#include "app_control_regulator.h" //to tap into the regulation loop
+
+class Comms_Telemetry {
+public:
+	//signals that can be streamed; OR these together to subscribe to more than one
+	enum Signal_t : uint8_t {
+		SIGNAL_SETPOINT =	(uint8_t)0x01,
+		SIGNAL_CURRENT =	(uint8_t)0x02,
+		SIGNAL_DRIVE =		(uint8_t)0x04,
+	};
+	static constexpr uint8_t SIGNAL_MASK_ALL = 0x07;
+
+	//layout of a telemetry frame payload
+	static constexpr size_t CHANNEL_INDEX = 0;
+	static constexpr size_t SIGNALS_INDEX = 1;
+	static constexpr size_t SEQ_INDEX = 2;
+	static constexpr size_t COUNT_INDEX = 6;
+	static constexpr size_t SAMPLES_START_INDEX = 7;
+
+	//how many samples we can buffer between the ISR and the main loop
+	static constexpr size_t SAMPLE_QUEUE_DEPTH = 256;
+
+	//send a partially filled frame if samples have been waiting this long
+	//keeps the stream flowing at high decimation factors
+	static constexpr uint32_t FLUSH_TIMEOUT_MS = 10;
+
+	Comms_Telemetry();
+
+	//delete copy constructor and assignment operator; the regulator ISR hangs onto a pointer to this
+	Comms_Telemetry(Comms_Telemetry const&) = delete;
+	void operator=(Comms_Telemetry const&) = delete;
+
+	//================== CALL FROM MAIN LOOP ==================
+	//start streaming `signals` from the regulator of power stage `channel`, taking a sample every `decimation` regulation cycles
+	//replaces any existing subscription; returns false if the subscription parameters don't make sense
+	bool start(Regulator_Wrapper& source, const uint8_t channel, const uint8_t signals, const uint32_t decimation);
+	void stop();
+	bool is_active();
+
+	//returns true if we've got enough samples waiting to make it worth sending a frame
+	bool frame_ready();
+
+	//pack as many waiting samples as fit into a telemetry frame payload; returns the payload length (0 if nothing to send)
+	size_t pack_frame(std::span<uint8_t, std::dynamic_extent> tx_payload);
+
+	//free-running count of samples lost because the queue was full
+	uint32_t get_dropped_count();
+
+private:
+	//================== CALLED FROM REGULATOR ISR ==================
+	static void __attribute__((optimize("O3"))) sample_forwarder(void* context);
+	void __attribute__((optimize("O3"))) sample();
+
+	//how a sample sits in its queue slot; just raw values, packing happens in the main loop
+	struct Sample_t {
+		uint32_t seq;
+		float setpoint;
+		float current;
+		float drive;
+	};
+
+	//where we're pulling samples from
+	Regulator_Wrapper* source = nullptr;
+	uint8_t channel = 0;
+	uint8_t signals = 0;
+	bool active = false;
+
+	//ISR-side bookkeeping
+	uint32_t decimation = 1;
+	uint32_t decimation_count = 1;
+	uint32_t next_seq = 0;
+	volatile uint32_t dropped_count = 0;
+
+	//main loop side bookkeeping
+	uint32_t last_frame_ms = 0; //when we last sent a frame
+
+	//queue of samples from the ISR
+	std::array<uint8_t, SAMPLE_QUEUE_DEPTH * sizeof(Sample_t)> sample_storage;
+	std::array<size_t, SAMPLE_QUEUE_DEPTH> sample_lengths;
+	Frame_Queue samples;
+};
+
+#endif /* COMMS_APP_COMMS_TELEMETRY_H_ */
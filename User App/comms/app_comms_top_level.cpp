@@ -7,6 +7,8 @@
 
 #include "app_comms_top_level.h"
 #include "app_utils.h" //for span indexing utils
+#include "app_hal_timing.h" //for timestamping requests
+#include "app_utils_trace.h" //for streaming the trace log
 
 //================ REQUEST HANDLER INCLUDES ==============
 #include "app_rqhand_test.h"
@@ -14,6 +16,10 @@
 #include "app_rqhand_setpoint.h"
 #include "app_rqhand_control.h"
 #include "app_rqhand_sampler.h"
+#include "app_rqhand_link.h"
+#include "app_rqhand_sync.h"
+#include "app_rqhand_params.h"
+#include "app_rqhand_estop.h"
 
 //================ COMMAND HANDLER INCLUDES ==============
 #include "app_cmhand_test.h"
@@ -21,91 +27,349 @@
 #include "app_cmhand_setpoint.h"
 #include "app_cmhand_control.h"
 #include "app_cmhand_sampler.h"
+#include "app_cmhand_telemetry.h"
+#include "app_cmhand_link.h"
+#include "app_cmhand_sync.h"
+#include "app_cmhand_params.h"
+#include "app_cmhand_estop.h"
 
+//================================= DISPATCH TABLES ==============================
+//generated at compile time from every handler class' list of handlers; sit in flash
+//two handlers mapped to the same code won't compile (see `Parser::make_dispatch_table()`)
+static constexpr Parser::dispatch_table_t REQUEST_TABLE = Parser::make_dispatch_table({
+		Test_Request_Handlers::request_handlers(),
+		Power_Stage_Request_Handlers::request_handlers(),
+		Setpoint_Request_Handlers::request_handlers(),
+		Controller_Request_Handlers::request_handlers(),
+		Sampler_Request_Handlers::request_handlers(),
+		Link_Request_Handlers::request_handlers(),
+		Sync_Request_Handlers::request_handlers(),
+		Param_Request_Handlers::request_handlers(),
+		Estop_Request_Handlers::request_handlers(),
+});
+
+static constexpr Parser::dispatch_table_t COMMAND_TABLE = Parser::make_dispatch_table({
+		Test_Command_Handlers::command_handlers(),
+		Power_Stage_Command_Handlers::command_handlers(),
+		Setpoint_Command_Handlers::command_handlers(),
+		Controller_Command_Handlers::command_handlers(),
+		Sampler_Command_Handlers::command_handlers(),
+		Telemetry_Command_Handlers::command_handlers(),
+		Link_Command_Handlers::command_handlers(),
+		Sync_Command_Handlers::command_handlers(),
+		Param_Command_Handlers::command_handlers(),
+		Estop_Command_Handlers::command_handlers(),
+});
 
 //================================= DEFINING STANDARD CONFIGURATION ==============================
 
+//the control link only ever carries short frames, so it gets short slots; only the bulk link pays for extended ones
+static std::array<uint8_t, UART::TX_QUEUE_DEPTH * Cobs::MSG_MAX_ENCODED_LENGTH> control_tx_buffer;
+static std::array<uint8_t, UART::RX_QUEUE_DEPTH * Cobs::MSG_MAX_ENCODED_LENGTH> control_rx_buffer;
+static std::array<uint8_t, UART::TX_QUEUE_DEPTH * Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH> bulk_tx_buffer;
+static std::array<uint8_t, UART::RX_QUEUE_DEPTH * Cobs::MSG_MAX_EXTENDED_ENCODED_LENGTH> bulk_rx_buffer;
+
 Comms_Exec_Subsystem::Configuration_Details Comms_Exec_Subsystem::COMMS_CHANNEL_0 = {
 		//run the main communication system off of LPUART
 		.uart_channel = UART::LPUART,
+		.role = LINK_CONTROL,
+		//point-to-point for now; to hang this off a shared RS-485 bus, enable this and size the slot to fit the longest broadcast response
+		.multidrop = {.enabled = false, .driver_enable = false, .reply_slot_bytes = Cobs::MSG_MAX_ENCODED_LENGTH},
+		.tx_buffer = control_tx_buffer,
+		.rx_buffer = control_rx_buffer,
+};
+
+//bulk transfers and telemetry go over USART3
+Comms_Exec_Subsystem::Configuration_Details Comms_Exec_Subsystem::COMMS_CHANNEL_1 = {
+		.uart_channel = UART::UART3,
+		.role = LINK_BULK,
+		.multidrop = {.enabled = false, .driver_enable = false, .reply_slot_bytes = Cobs::MSG_MAX_ENCODED_LENGTH},
+		.tx_buffer = bulk_tx_buffer,
+		.rx_buffer = bulk_rx_buffer,
 };
 
 //======================================= PUBLIC METHODS =====================================
 
 //Constructor
 Comms_Exec_Subsystem::Comms_Exec_Subsystem(Configuration_Details& config_details):
-		serial_comms(config_details.uart_channel, Cobs::CHAR_START_OF_FRAME, Cobs::CHAR_END_OF_FRAME, serial_tx_buffer, serial_rx_buffer),
-		cobs(),
+		role(config_details.role),
+		multidrop(config_details.multidrop),
 		crc(), //use default CRC parameters (CRC-16/AUG-CCITT)
-		parser(crc)
+		stream_decoder(crc, Timer::get_cycles), //stamp frames as they land so we can tell how long they waited
+		serial_comms(	config_details.uart_channel, Cobs::CHAR_START_OF_FRAME, Cobs::CHAR_END_OF_FRAME,
+						config_details.tx_buffer, config_details.rx_buffer, &stream_decoder),
+		baud(serial_comms),
+		cobs(),
+		parser(crc, COMMAND_TABLE, REQUEST_TABLE),
+		telemetry()
 {}
 
 //call this in `app_init()`
 void Comms_Exec_Subsystem::init(uint8_t device_address) {
+	//on a shared bus, have the receive ISR throw away other devices' traffic before it ever starts listening
+	address = device_address;
+	stream_decoder.set_address(device_address, multidrop.enabled);
+
+	//the host gets its first heartbeat window from when we came up
+	last_rx_ms = Timer::get_ms();
+
 	//initialize the serial communications
 	serial_comms.init();
+	if(multidrop.enabled && multidrop.driver_enable) serial_comms.enable_driver_enable();
+
+	//don't let the host slow the link down so much our reply slot runs off the end of the cycle counter
+	//and if we're already that slow, say so up front--broadcasts won't get answered (see `service_request()`)
+	slot_min_baud = min_reply_slot_baud();
+	baud.set_min_baud_rate(slot_min_baud);
+	if(serial_comms.get_baud_rate() < slot_min_baud)
+		Trace::log<Trace::REPLY_SLOT_UNFIT>(address, serial_comms.get_baud_rate(), slot_min_baud);
 	//TODO: attach any serial error handlers
 
 	//forward the device address to the parser
 	parser.set_address(device_address);
 
-	//TODO: register all command and request callbacks here
-	for(auto& [rq_code, rq_callback] : Test_Request_Handlers::request_handlers()) parser.attach_request_cb(rq_code, rq_callback);
-	for(auto& [rq_code, rq_callback] : Power_Stage_Request_Handlers::request_handlers()) parser.attach_request_cb(rq_code, rq_callback);
-	for(auto& [rq_code, rq_callback] : Setpoint_Request_Handlers::request_handlers()) parser.attach_request_cb(rq_code, rq_callback);
-	for(auto& [rq_code, rq_callback] : Controller_Request_Handlers::request_handlers()) parser.attach_request_cb(rq_code, rq_callback);
-	for(auto& [rq_code, rq_callback] : Sampler_Request_Handlers::request_handlers()) parser.attach_request_cb(rq_code, rq_callback);
-
-	for(auto& [cm_code, cm_callback] : Test_Command_Handlers::command_handlers()) parser.attach_command_cb(cm_code, cm_callback);
-	for(auto& [cm_code, cm_callback] : Power_Stage_Command_Handlers::command_handlers()) parser.attach_command_cb(cm_code, cm_callback);
-	for(auto& [cm_code, cm_callback] : Setpoint_Command_Handlers::command_handlers()) parser.attach_command_cb(cm_code, cm_callback);
-	for(auto& [cm_code, cm_callback] : Controller_Command_Handlers::command_handlers()) parser.attach_command_cb(cm_code, cm_callback);
-	for(auto& [cm_code, cm_callback] : Sampler_Command_Handlers::command_handlers()) parser.attach_command_cb(cm_code, cm_callback);
+	//NOTE: command and request handlers are mapped at compile time (see the dispatch tables above)
 
+	//telemetry is owned by the bulk link, so hand it to its command handlers here
+	//a telemetry command coming in over any link controls the stream on the bulk link
+	//NOTE: the baud rate negotiator gets attached right before each request is parsed instead, so the command switches the link it came in on
+	if(role == LINK_BULK) Telemetry_Command_Handlers::attach_telemetry(&telemetry);
 }
 
 //call this in `app_loop()`
 //NOTE: CODE MAY BLOCK IF ANY OF THE COMMAND OR REQUEST HANDLERS BLOCK
 void Comms_Exec_Subsystem::loop() {
+	//a broadcast response waiting on its reply slot has the transmit queue's write slot, so nothing else can go out until it does
+	if(service_slot_reply()) {
+		//host messages first; control links get through everything that's waiting, bulk links just one request per pass
+		size_t request_budget = (role == LINK_CONTROL) ? UART::RX_QUEUE_DEPTH : 1;
+		while(request_budget-- > 0 && service_request());
+
+		//then let the host know about any parameters that changed, fill any leftover bandwidth with telemetry,
+		//whatever's left after that with trace records, and whatever's left after THAT with debug text
+		if(role == LINK_BULK && !slot_reply.waiting) {
+			service_param_changes();
+			service_telemetry();
+			service_trace();
+			service_debug_text();
+		}
+	}
+
+	//and take care of any baud rate switching once everything's gone out (including a response still waiting on its reply slot)
+	if(!slot_reply.waiting) baud.loop();
+}
+
+const Parser::dispatch_table_t& Comms_Exec_Subsystem::command_table() { return COMMAND_TABLE; }
+
+const Comms_Exec_Subsystem::Link_Stats_t& Comms_Exec_Subsystem::get_stats() { return stats; }
+Comms_Exec_Subsystem::Link_Role_t Comms_Exec_Subsystem::get_role() { return role; }
+UART& Comms_Exec_Subsystem::get_uart() { return serial_comms; }
+uint32_t Comms_Exec_Subsystem::get_rx_filtered_count() { return stream_decoder.get_filtered_count(); }
+uint32_t Comms_Exec_Subsystem::get_last_rx_ms() { return last_rx_ms; }
+
+void Comms_Exec_Subsystem::attach_emergency_stop_cb(void* const context, const Cobs_Stream_Decoder::emergency_stop_func_t func) {
+	stream_decoder.attach_emergency_stop_cb(context, func);
+}
+
+void Comms_Exec_Subsystem::attach_param_notifier(Comms_Param_Notifier* notifier) {
+	param_notifier = notifier;
+}
+
+void Comms_Exec_Subsystem::attach_debug_printer(Debug_Print* printer) {
+	debug_printer = printer;
+}
+
+//====================================== PRIVATE METHODS ====================================
+
+bool Comms_Exec_Subsystem::service_request() {
 	/*
-	 * Implement the simplest of state machines --> two different states to allow for non-blocking transmit
-	 * if IS_WAITING_RECEIVE is true, we're waiting for some packet to be received over UART
-	 * if IS_WAITING_RECEIVE is false, we're waiting for the transmitter to finish transmitting its previous packet; can only transmit once transmit is complete
+	 * Responses get queued up in the UART and chained out by the TX complete interrupt
+	 * as such, we can go straight on to parsing the next request while the previous response is still on the wire
+	 * the only thing to be careful of is not pulling a request out of the RX queue if we won't have anywhere to put its response
+	 * 		\--> in that case, just leave the request queued up and try again next time around
+	 *
+	 * Everything happens in the UART's queue memory; no copies of the frame are made:
+	 * 		- the request was already COBS decoded and CRC checked in its receive slot by the receive ISR
+	 * 		- the parser writes the response directly into the payload section of a transmit slot
+	 * 		- the response is COBS encoded in place around it, and the slot handed straight to the DMA
 	 */
 
-	static bool IS_WAITING_RECEIVE = true; //remember this for successive function calls
-	static int16_t tx_encoded_packet_length; //need to save this across the two states; save between successive function calls too
-
-	if(IS_WAITING_RECEIVE) {
-		//check if we have a packet
-		size_t rx_encoded_packet_length = serial_comms.get_packet(rx_encoded_packet);
-		if(!rx_encoded_packet_length) return; //if we don't have a packet, exit the function
-
-		//we have a packet - decode it
-		//TODO: handle COBS decoding error maybe
-		int16_t decoded_packet_length = cobs.decode(spn(rx_encoded_packet, rx_encoded_packet_length), rx_decoded_packet);
-		if(decoded_packet_length < 0) return; //ran into an error decoding the packet, don't continue
-
-		//if the cobs decode was successful
-		//parse the decoded packet, execute the corresponding command or request (if applicable) and respond as necessary
-		size_t response_packet_length = parser.parse_buffer(spn(rx_decoded_packet, (size_t)decoded_packet_length), tx_unencoded_packet);
-		if(!response_packet_length) return; //if we don't need to respond with anything, then just return
-
-		//encode the response packet
-		//TODO: handle COBS encoding error maybe
-		tx_encoded_packet_length = cobs.encode(spn(tx_unencoded_packet, response_packet_length), tx_encoded_packet);
-		if(tx_encoded_packet_length < 0) return; //ran into an error encoding the packet, don't continue
-		IS_WAITING_RECEIVE = false; //waiting to transmit
+	//grab a transmit slot to build the response in; if every transmit slot is still occupied, don't take on more work
+	//same goes if a response is still waiting on its reply slot, since it's sitting in the slot we'd get
+	if(slot_reply.waiting) return false;
+	std::span<uint8_t, std::dynamic_extent> tx_encoded_packet = serial_comms.reserve_transmit();
+	if(tx_encoded_packet.size() < Cobs::MSG_MAX_ENCODED_LENGTH) return false;
+
+	//check if we have a packet
+	//frames with broken COBS never make it into the queue, so anything here has been decoded successfully
+	std::span<uint8_t, std::dynamic_extent> rx_decoded_frame = serial_comms.peek_packet();
+	if(rx_decoded_frame.empty()) return false; //if we don't have a packet, exit the function
+
+	//note how long the packet's been waiting on us, and start the clock on handling it
+	uint32_t start_cycles = Timer::get_cycles();
+	uint32_t queued_cycles = Cobs_Stream_Decoder::age(rx_decoded_frame, start_cycles);
+	stats.rx_frames++;
+	if(!Cobs_Stream_Decoder::crc_good(rx_decoded_frame)) stats.rx_crc_errors++;
+
+	//any baud rate change should apply to the link this packet came in on
+	//and scheduled commands count their delay from when this packet landed, not from when we got around to it
+	Link_Command_Handlers::attach_baud_negotiator(&baud);
+	Sync_Command_Handlers::set_frame_arrival(start_cycles - queued_cycles);
+
+	//parse the decoded packet, execute the corresponding command or request (if applicable) and respond as necessary
+	//the CRC was already computed as the packet streamed in, so just forward the result
+	//the response gets built right where the encoder expects its payload in the transmit slot
+	//leave room for an extended response if the slot can fit one; the parser caps short responses to the short frame limit on its own
+	size_t tx_unencoded_length = std::min(Cobs::MSG_MAX_EXTENDED_UNENCODED_LENGTH, Cobs::decoded_length(tx_encoded_packet.size()));
+	auto tx_unencoded_packet = tx_encoded_packet.subspan(Cobs::IDX_START_OF_PAYLOAD, tx_unencoded_length);
+	size_t response_packet_length = parser.parse_buffer(	Cobs_Stream_Decoder::packet(rx_decoded_frame), tx_unencoded_packet,
+															Cobs_Stream_Decoder::crc_good(rx_decoded_frame));
+
+	//a good frame means the host is talking to us at whatever rate we're on (i.e. confirms a baud rate switch)
+	//and if it was meant for us, that the host is still around (see `Comms_Heartbeat`)
+	std::span<uint8_t, std::dynamic_extent> rx_packet = Cobs_Stream_Decoder::packet(rx_decoded_frame);
+	if(Cobs_Stream_Decoder::crc_good(rx_decoded_frame)) {
+		baud.frame_received();
+		if(rx_packet.size() > Parser::MTYPE_INDEX && Parser::addressed_to(rx_packet[Parser::ID_INDEX], rx_packet[Parser::MTYPE_INDEX], address))
+			last_rx_ms = Timer::get_ms();
 	}
 
-	//splitting the `false` case into a separate conditional so we can try the transmit in the same function call
-	//allows us to receive and dispatch a message in a single call if the transmit isn't blocking
-	if(!IS_WAITING_RECEIVE) {
-		if(!serial_comms.ready_to_send()) return; //if we're busy transmitting something, just return
+	//on a shared bus, every device answers a broadcast at once--so ours has to wait for its turn
+	bool broadcast = multidrop.enabled && rx_packet[Parser::ID_INDEX] == Parser::BROADCAST_ADDRESS;
+
+	//done with the received packet, free up its slot for the ISR
+	serial_comms.release_packet();
+	if(!response_packet_length) return true; //if we don't need to respond with anything, then just return
 
-		//if we're able to transmit, send the encoded packet
-		serial_comms.transmit(spn(tx_encoded_packet, tx_encoded_packet_length));
-		IS_WAITING_RECEIVE = true; //go back to waiting for a packet
+	//encode the response packet in place
+	//TODO: handle COBS encoding error maybe
+	int16_t tx_encoded_packet_length = cobs.encode_in_place(tx_encoded_packet, response_packet_length);
+	if(tx_encoded_packet_length < 0) { //ran into an error encoding the packet, don't continue
+		stats.tx_encode_errors++;
+		return true;
 	}
+
+	//leave a broadcast response in the write slot until our reply slot comes up
+	//slots are counted from when the broadcast landed, so every device on the bus agrees on where they fall
+	uint32_t latency_us = Timer::cycles_to_us(queued_cycles + (Timer::get_cycles() - start_cycles));
+	if(broadcast) {
+		//link came up too slow for our slot to be timed reliably (see `init()`); leave the response in the write slot to get written over
+		if(serial_comms.get_baud_rate() < slot_min_baud) return true;
+
+		//64-bit math, since address * slot length easily runs past 32 bits of cycles at low baud rates
+		//fits back in 32 bits once we're above the floor
+		uint64_t slot_offset_cycles = (uint64_t)address * reply_slot_us(serial_comms.get_baud_rate()) * (Timer::get_cycles_per_second() / 1000000);
+		slot_reply.waiting = true;
+		slot_reply.length = (size_t)tx_encoded_packet_length;
+		slot_reply.due_cycles = (start_cycles - queued_cycles) + (uint32_t)slot_offset_cycles;
+		slot_reply.latency_us = latency_us;
+		stats.tx_slot_replies++;
+		service_slot_reply(); //might already be our turn
+		return true;
+	}
+
+	//hand the encoded packet over to the transmitter
+	serial_comms.commit_transmit((size_t)tx_encoded_packet_length);
+	stats.tx_responses++;
+	record_latency(latency_us);
+	return true;
+}
+
+bool Comms_Exec_Subsystem::service_slot_reply() {
+	if(!slot_reply.waiting) return true;
+
+	//signed difference so this holds up across the cycle counter wrapping
+	uint32_t now = Timer::get_cycles();
+	int32_t cycles_past_due = (int32_t)(now - slot_reply.due_cycles);
+	if(cycles_past_due < 0) return false;
+
+	//our turn; anything more than the guard time late risks running into the next device's slot
+	if(Timer::cycles_to_us((uint32_t)cycles_past_due) > REPLY_SLOT_GUARD_US) stats.tx_slot_late++;
+	serial_comms.commit_transmit(slot_reply.length);
+	slot_reply.waiting = false;
+	stats.tx_responses++;
+	record_latency(slot_reply.latency_us);
+	return true;
+}
+
+uint32_t Comms_Exec_Subsystem::reply_slot_us(const uint32_t baud) {
+	if(baud == 0) return UINT32_MAX;
+	uint64_t wire_us = (uint64_t)multidrop.reply_slot_bytes * 10 * 1000000 / baud;
+	return (uint32_t)std::min<uint64_t>(wire_us + REPLY_SLOT_GUARD_US, UINT32_MAX);
+}
+
+uint32_t Comms_Exec_Subsystem::min_reply_slot_baud() {
+	if(!multidrop.enabled) return 0;
+
+	//our slot ends (address + 1) slots after the broadcast's EOF; work out how much wire time each slot can afford
+	uint64_t cycles_per_us = Timer::get_cycles_per_second() / 1000000;
+	uint64_t max_slot_us = MAX_REPLY_SLOT_WAIT_CYCLES / (((uint64_t)address + 1) * cycles_per_us);
+	if(max_slot_us <= REPLY_SLOT_GUARD_US) return UINT32_MAX;
+
+	//and the slowest rate that gets a slot's worth of bytes out in that time (rounding up, to match `reply_slot_us()` rounding down)
+	uint64_t max_wire_us = max_slot_us - REPLY_SLOT_GUARD_US;
+	uint64_t wire_bit_us = (uint64_t)multidrop.reply_slot_bytes * 10 * 1000000;
+	return (uint32_t)std::min<uint64_t>((wire_bit_us + max_wire_us - 1) / max_wire_us, UINT32_MAX);
+}
+
+void Comms_Exec_Subsystem::service_telemetry() {
+	if(!telemetry.frame_ready()) return;
+	send_unsolicited(Parser::DEVICE_TELEMETRY, [this](auto payload) { return telemetry.pack_frame(payload); }, stats.tx_telemetry);
+}
+
+void Comms_Exec_Subsystem::service_trace() {
+	if(!Trace::frame_ready()) return;
+	send_unsolicited(Parser::DEVICE_TRACE, Trace::pack_frame, stats.tx_trace);
 }
 
+void Comms_Exec_Subsystem::service_param_changes() {
+	if(param_notifier == nullptr || !param_notifier->frame_ready()) return;
+	send_unsolicited(Parser::DEVICE_PARAM_CHANGE, [this](auto payload) { return param_notifier->pack_frame(payload); }, stats.tx_param_changes);
+}
+
+void Comms_Exec_Subsystem::service_debug_text() {
+	//any message has to fit in a single frame, otherwise it'd sit at the front of the ring forever
+	static_assert(Debug_Print::MESSAGES_START_INDEX + 1 + Debug_Print::MESSAGE_MAX_LENGTH <= Parser::MAX_PAYLOAD_LENGTH, "debug messages don't fit in a frame");
+
+	if(debug_printer == nullptr || !debug_printer->frame_ready()) return;
+	send_unsolicited(Parser::DEVICE_DEBUG_TEXT, [this](auto payload) { return debug_printer->pack_frame(payload); }, stats.tx_debug_text);
+}
+
+template<typename Pack_Func>
+void Comms_Exec_Subsystem::send_unsolicited(const Parser::MessageType_t message_type, Pack_Func pack, uint32_t& sent_count) {
+	/*
+	 * At most one frame per call, so the time spent here is bounded no matter how fast things are piling up
+	 * 	\--> if the link can't keep up, whatever's feeding the frames fills up and drops (and counts) on its end
+	 * 		  e.g. the regulator ISR drops telemetry samples, with a gap in sequence numbers
+	 * Also never take the last free transmit slot(s)--those are kept for responses to the host
+	 */
+	if(baud.switch_pending()) return; //let the transmitter drain so we can switch baud rates
+	if(serial_comms.tx_slots_free() <= TX_SLOTS_RESERVED_FOR_RESPONSES) return;
+
+	std::span<uint8_t, std::dynamic_extent> tx_encoded_packet = serial_comms.reserve_transmit();
+	if(tx_encoded_packet.size() < Cobs::MSG_MAX_ENCODED_LENGTH) return;
+
+	//pack straight into the payload section of the transmit slot, then wrap it up like any other message
+	auto tx_unencoded_packet = tx_encoded_packet.subspan(Cobs::IDX_START_OF_PAYLOAD, Cobs::MSG_MAX_UNENCODED_LENGTH);
+	size_t plen = pack(tx_unencoded_packet.subspan(Parser::PL_START_INDEX, Parser::MAX_PAYLOAD_LENGTH));
+	size_t packet_length = parser.pack_message(message_type, plen, tx_unencoded_packet);
+	if(!packet_length) return;
+
+	//encode in place and send it off
+	int16_t tx_encoded_packet_length = cobs.encode_in_place(tx_encoded_packet, packet_length);
+	if(tx_encoded_packet_length < 0) {
+		stats.tx_encode_errors++;
+		return;
+	}
+	serial_comms.commit_transmit((size_t)tx_encoded_packet_length);
+	sent_count++;
+}
+
+void Comms_Exec_Subsystem::record_latency(const uint32_t latency_us) {
+	stats.latency_last_us = latency_us;
+	stats.latency_max_us = std::max(stats.latency_max_us, latency_us);
+
+	//first request seeds the average; after that just nudge it towards the newest one
+	if(stats.tx_responses <= 1) stats.latency_avg_us = latency_us;
+	else stats.latency_avg_us = stats.latency_avg_us - (stats.latency_avg_us >> LATENCY_AVG_SHIFT) + (latency_us >> LATENCY_AVG_SHIFT);
+}
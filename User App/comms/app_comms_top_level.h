@@ -10,6 +10,29 @@
  *  This class will own all the statically allocated data structures and class instances
  *  Configuration changes to each of the comms systems must take place here
  *
+ *  UPDATE: one of these runs per serial link, all sharing the same (compile-time) command and request tables
+ *  Each link gets a role that decides how much of each `loop()` it's allowed to take up:
+ *  	- CONTROL links drain every request that's waiting, and never carry telemetry
+ *  		\--> service these first in the main loop, so something like a STAGE_DISABLE never waits behind bulk traffic
+ *  	- BULK links handle a single request per pass, and carry the telemetry stream
+ *  		\--> a long transfer on here costs the control link at most one handler's worth of latency
+ *  		\--> only bulk links get queue slots big enough for extended frames (see `Configuration_Details`)
+ *  			 an extended frame sent over a control link overflows its receive slot and gets dropped, so the host just times out
+ *  		\--> parameter change notifications (see `Comms_Param_Notifier`) go out on here too, ahead of telemetry since they're rare and short
+ *  		\--> as does debug text (see `Debug_Print`), after everything else since it's only ever there for bring-up
+ *  Every link keeps its own counters and latency stats (see `Link_Stats_t`), queryable over either link
+ *
+ *  UPDATE: a link can sit on a multi-drop RS-485 bus shared with other devices (see `Multidrop_Config_t`):
+ *  	- the UART drives the transceiver's DE pin, so we only hold the bus while we're actually transmitting
+ *  	- frames for other devices get thrown away by the receive ISR as soon as their ID lands (see `Cobs_Stream_Decoder::filter_address()`)
+ *  	- responses to broadcasts (see `Parser::BROADCAST_ADDRESS`) are held back until this device's reply slot:
+ *  		slot n starts n * <slot length> after the broadcast's EOF, where n is the device address
+ *  		\--> size the slot to fit the longest response you plan on broadcasting for, and expect up to <address> slots of silence before a reply
+ *  		\--> while a reply is waiting on its slot, the link doesn't take on any more requests (or send telemetry), so nothing can jump the queue
+ *  		\--> slots are timed off the 32-bit cycle counter, so our slot has to end well inside half its range (see `MAX_REPLY_SLOT_WAIT_CYCLES`)
+ *  			 that puts a floor on the baud rate for a given address and slot length; the host can't switch below it, and if the link
+ *  			 comes up below it, broadcasts just don't get answered (and a REPLY_SLOT_UNFIT trace event says why)
+ *
  */
 
 #ifndef COMMS_APP_COMMS_TOP_LEVEL_H_
@@ -28,18 +51,59 @@ extern "C" {
 //include libraries for all the submodules within the comms subsystem
 #include "app_hal_uart.h"
 #include "app_comms_cobs.h"
+#include "app_comms_cobs_stream.h"
 #include "app_comms_crc.h"
 #include "app_comms_parser.h"
+#include "app_comms_telemetry.h"
+#include "app_comms_baud.h"
+#include "app_comms_param_notify.h"
+#include "app_utils_debug_print.h"
 
 class Comms_Exec_Subsystem {
 
 public:
 	//======================================================= CONFIGURATION DETAILS STRUCT =======================================================
 	//following the paradigm of passing pre-instantiated configuration information to the constructor
+	enum Link_Role_t : uint8_t {
+		LINK_CONTROL =	(uint8_t)0x00, //low latency; drain every waiting request each pass, no telemetry
+		LINK_BULK =		(uint8_t)0x01, //one request per pass, and carries the telemetry stream
+	};
+
+	struct Multidrop_Config_t {
+		bool enabled; //filter out other devices' frames, and answer broadcasts in our own reply slot
+		bool driver_enable; //have the UART drive the transceiver's DE pin (see `UART::enable_driver_enable()`)
+		size_t reply_slot_bytes; //length of a reply slot, in bytes on the wire at the current baud rate (10 bit times each)
+	};
+
+	//the UART queues split `tx_buffer`/`rx_buffer` evenly between their slots (see `UART`)
+	//size them as <queue depth> * <longest frame the link carries>; i.e. short frames for a control link, extended frames for a bulk link
+	//slots need to fit at least a short frame
 	struct Configuration_Details {
 		UART::UART_Hardware_Channel& uart_channel;
+		const Link_Role_t role;
+		const Multidrop_Config_t multidrop;
+		std::span<uint8_t, std::dynamic_extent> tx_buffer;
+		std::span<uint8_t, std::dynamic_extent> rx_buffer;
+	};
+	static Configuration_Details COMMS_CHANNEL_0; //our main source of configuration information; control link
+	static Configuration_Details COMMS_CHANNEL_1; //same thing, but running off USART3; bulk link
+
+	//per-link diagnostics; counts are free-running since power up, so compare against a previous read to see what happened in between
+	struct Link_Stats_t {
+		uint32_t rx_frames;				//frames handed to the parser
+		uint32_t rx_crc_errors;			//...of which failed their CRC check
+		uint32_t tx_responses;			//responses queued up for transmission
+		uint32_t tx_telemetry;			//telemetry frames queued up for transmission
+		uint32_t tx_encode_errors;		//frames of any kind we couldn't encode (and so never went out)
+		uint32_t latency_last_us;		//how long the most recent request took from its EOF landing to its response being queued
+		uint32_t latency_max_us;		//worst case of the above
+		uint32_t latency_avg_us;		//moving average of the above (weighted 1/2^LATENCY_AVG_SHIFT towards the newest request)
+		uint32_t tx_slot_replies;		//responses to broadcasts held back to our reply slot
+		uint32_t tx_slot_late;			//...of which went out after our slot had already started (main loop was too slow getting to them)
+		uint32_t tx_trace;				//trace frames queued up for transmission
+		uint32_t tx_param_changes;		//parameter change frames queued up for transmission
+		uint32_t tx_debug_text;			//debug text frames queued up for transmission
 	};
-	static Configuration_Details COMMS_CHANNEL_0; //our main source of configuration information
 
 	//======================================================= PUBLIC METHODS =======================================================
 
@@ -53,27 +117,115 @@ public:
 	//read in the serial device address and initialize the parser with it
 	void init(uint8_t device_address);
 	void loop();
+
+	//every command this device knows about; for anything that needs to run commands outside of a link (i.e. the sync scheduler)
+	static const Parser::dispatch_table_t& command_table();
+
+	//diagnostics for this link
+	const Link_Stats_t& get_stats();
+	Link_Role_t get_role();
+	UART& get_uart(); //for the receive-side counters the UART keeps on its own
+	uint32_t get_rx_filtered_count(); //frames thrown away since they were for another device on the bus
+	uint32_t get_last_rx_ms(); //when we last heard from the host (a good frame meant for us), in `Timer::get_ms()` time
+
+	//run this straight from the receive ISR when an emergency stop frame lands on this link (see `Comms_Emergency_Stop`)
+	//gets handed the cycle count (see `Timer::get_cycles()`) of when the stop frame's EOF landed
+	void attach_emergency_stop_cb(void* const context, const Cobs_Stream_Decoder::emergency_stop_func_t func);
+
+	//have the bulk link send out changes to parameters the host subscribed to (see `Comms_Param_Notifier`)
+	void attach_param_notifier(Comms_Param_Notifier* notifier);
+
+	//have the bulk link send out anything printed to `printer` (see `Debug_Print`)
+	void attach_debug_printer(Debug_Print* printer);
+
 private:
+	//the two halves of `loop()`
+	bool service_request(); //respond to a single thing the host sent us; returns false if there was nothing we could handle
+	void service_telemetry(); //send along any telemetry that's piled up
+	void service_trace(); //send along any trace records that have piled up
+	void service_param_changes(); //send along any changes to subscribed parameters
+	void service_debug_text(); //send along any debug text that's been printed
+	bool service_slot_reply(); //send a broadcast response once its reply slot comes up; returns false if it's still waiting
+
+	//queue up a single frame the device sends of its own accord (telemetry, trace, etc.) and count it in `sent_count`
+	//`pack` fills the payload it's handed and returns how many bytes it used; only gets called if there's a transmit slot to spare
+	template<typename Pack_Func>
+	void send_unsolicited(const Parser::MessageType_t message_type, Pack_Func pack, uint32_t& sent_count);
+
+	//fold the latency of a request we just serviced into the stats
+	void record_latency(const uint32_t latency_us);
+
+	//how hard the moving average of the request latency leans on the newest request
+	static constexpr size_t LATENCY_AVG_SHIFT = 3;
+
+	//how much dead time to leave at the end of every reply slot, for the previous device's DE to drop and our main loop to get around to it
+	static constexpr uint32_t REPLY_SLOT_GUARD_US = 200;
+
+	//furthest out (from the broadcast's EOF) our reply slot is allowed to end
+	//`service_slot_reply()` compares against the due time with a signed 32-bit difference, so stay well inside half the counter's range
+	//	\--> ~6.3s at 170MHz
+	static constexpr uint32_t MAX_REPLY_SLOT_WAIT_CYCLES = INT32_MAX / 2;
+
+	//slowest baud rate at which our reply slot still ends inside `MAX_REPLY_SLOT_WAIT_CYCLES`; 0 if we don't use reply slots
+	//UINT32_MAX if there's no such rate (i.e. the guard times alone push us out too far)
+	uint32_t min_reply_slot_baud();
+
+	//how long a single reply slot is at a particular baud rate
+	uint32_t reply_slot_us(const uint32_t baud);
+
+	const Link_Role_t role;
+	const Multidrop_Config_t multidrop;
+	uint8_t address = 0;
+	uint32_t slot_min_baud = 0; //see `min_reply_slot_baud()`; worked out once we know our address
+	Link_Stats_t stats = {};
+	uint32_t last_rx_ms = 0;
+
+	//a broadcast response sitting in the transmit queue's write slot, waiting on our reply slot
+	//nothing else touches the write slot until it's committed
+	struct {
+		bool waiting = false;
+		size_t length = 0; //encoded length
+		uint32_t due_cycles = 0;
+		uint32_t latency_us = 0; //how long the request took to handle, not counting the wait for the slot
+	} slot_reply;
+
 	//##### all these objects will be initialized in the constructor of `Comms_Exec_Subsystem` #####
 
+	//=========================== EVERYTHING CRC COMPUTATION ==============================
+	//up top since the receive ISR uses this (via the stream decoder) as soon as the UART is up
+	Comms_CRC crc;
+
 	//============================= EVERYTHING SERIAL COMMUNICATION ==================================
-	std::array<uint8_t, Cobs::MSG_MAX_ENCODED_LENGTH> serial_tx_buffer; //place for UART to put outgoing serial data
-	std::array<uint8_t, Cobs::MSG_MAX_ENCODED_LENGTH> serial_rx_buffer; //place for UART to put incoming serial data
+	//frames get COBS decoded and CRC checked byte-by-byte in the receive ISR, so they're ready to parse when they land in the queue
+	//the UART queues up frames in the buffers passed in through `Configuration_Details`
+	Cobs_Stream_Decoder stream_decoder;
 	UART serial_comms;
+	Comms_Baud_Negotiator baud; //lets the host change the baud rate of `serial_comms` on the fly
 
 	//=========================== EVERYTHING COBS ENCODING ===========================
-	std::array<uint8_t, Cobs::MSG_MAX_ENCODED_LENGTH> rx_encoded_packet; //place to keep packet received over serial comms
-	std::array<uint8_t, Cobs::MSG_MAX_ENCODED_LENGTH> tx_encoded_packet; //place to keep packet to be sent over serial comms
+	//packets get decoded as they stream into the UART's receive queue, and responses get encoded in place in its transmit queue
+	//so no intermediate buffers necessary here
 	Cobs cobs; //instantiate a cobs instance; nothing to construct really
 
-	//=========================== EVERYTHING CRC COMPUTATION ==============================
-	Comms_CRC crc;
-
 	//============================= EVERYTHING PARSER ===========================
-	std::array<uint8_t, Cobs::MSG_MAX_UNENCODED_LENGTH> rx_decoded_packet; //place to put the received packet after decoding
-	std::array<uint8_t, Cobs::MSG_MAX_UNENCODED_LENGTH> tx_unencoded_packet; //place to put the response packet to be transmitted back to host (before encoding)
 	Parser parser;
 
+	//============================= EVERYTHING TELEMETRY ===========================
+	//samples get queued up by the regulator ISR, and sent in the background whenever the UART has room
+	//only used on BULK links
+	Comms_Telemetry telemetry;
+
+	//============================= EVERYTHING PARAMETER CHANGES ===========================
+	//owned by the top level (it watches every parameter on the device); only used on BULK links
+	Comms_Param_Notifier* param_notifier = nullptr;
+
+	//============================= EVERYTHING DEBUG TEXT ===========================
+	//owned by the top level (anything on the device can print to it); only used on BULK links
+	Debug_Print* debug_printer = nullptr;
+
+	//always leave this many transmit slots free for responses, so streaming telemetry never holds up the host
+	static constexpr size_t TX_SLOTS_RESERVED_FOR_RESPONSES = 1;
+
 };
 
 
@@ -0,0 +1,54 @@
+/*
+ * app_comms_typed_handler.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#include "app_comms_typed_handler.h"
+
+//same set of checks as `CM_Mapping::VALIDATE_COMMAND` and `RQ_Mapping::VALIDATE_REQUEST`
+bool Typed_Handler::validate(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+								std::span<uint8_t, std::dynamic_extent> tx_payload,
+								const size_t tx_min_size, const size_t rx_exact_size, const uint8_t code,
+								response_t& nack_response)
+{
+	//check if TX payload size exists at all
+	if(tx_payload.size() <= 0) {
+		nack_response = std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 0); //can't even send a NACK message
+		return false;
+	}
+
+	//check if TX buffer can support a response of this length
+	if(tx_payload.size() < tx_min_size) {
+		nack_response = nack(tx_payload, Parser::NACK_ERROR_INTERNAL_FW);
+		return false;
+	}
+
+	//check if we've received the correct number of bytes
+	if(rx_payload.size() != rx_exact_size) {
+		nack_response = nack(tx_payload, Parser::NACK_ERROR_INVALID_MSG_SIZE);
+		return false;
+	}
+
+	//check if we've been redirected to the correct handler
+	if(rx_payload[0] != code) {
+		nack_response = nack(tx_payload, Parser::NACK_ERROR_INTERNAL_FW);
+		return false;
+	}
+
+	//all checks pass
+	return true;
+}
+
+//single-byte NACK with the reason as the payload
+std::pair<Parser::MessageType_t, size_t> Typed_Handler::nack(std::span<uint8_t, std::dynamic_extent> tx_payload, const Parser::NACKErrorTypes_t reason) {
+	tx_payload[0] = (uint8_t)reason;
+	return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+}
+
+//single-byte ACK with the command code as the payload
+std::pair<Parser::MessageType_t, size_t> Typed_Handler::ack(std::span<uint8_t, std::dynamic_extent> tx_payload, const uint8_t code) {
+	tx_payload[0] = code;
+	return std::make_pair(Parser::DEVICE_ACK_HOST_MESSAGE, 1);
+}
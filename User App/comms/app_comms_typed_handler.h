@@ -0,0 +1,277 @@
+/*
+ * app_comms_typed_handler.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Most command/request handlers do the exact same thing:
+ *  	- validate the payload size and code (`VALIDATE_COMMAND`/`VALIDATE_REQUEST`)
+ *  	- bounds check a channel index
+ *  	- unpack a couple of arguments, call a single `*_Wrapper` method
+ *  	- NACK if that failed, otherwise ACK or pack the returned value(s)
+ *  This file lets the compiler write those handlers for us. The types of the arguments and return value come straight from the
+ *  signature of the function/method we bind to, so a handler turns into a single line in a handler class' mapping list:
+ *
+ *  	Typed_Handler::channel_command<CM_Mapping::CONTROL_SET_DC_GAIN, regulator, &Regulator_Wrapper::update_gain>()
+ *
+ *  where `regulator` is a static function of the handler class that turns a channel index into a `Regulator_Wrapper*` (nullptr if out of range)
+ *  The code lives in exactly one spot (the descriptor), so a handler can't be mapped to a code it doesn't validate against
+ *
+ *  Four flavors of descriptors:
+ *  	- command<CODE, FN>()							rx: [CODE][args...]				--> `bool FN(args...)`				--> ACK [CODE]
+ *  	- channel_command<CODE, RESOLVE, METHOD>()		rx: [CODE][CHANNEL][args...]	--> `bool (target->*METHOD)(args...)`	--> ACK [CODE]
+ *  	- request<CODE, FN>()							rx: [CODE]						--> `R FN()`						--> [CODE][R]
+ *  	- channel_request<CODE, RESOLVE, METHOD>()		rx: [CODE][CHANNEL]				--> `R (target->*METHOD)()`			--> [CODE][CHANNEL][R]
+ *  NACKs work the same way the hand-written handlers did:
+ *  	- INVALID_MSG_SIZE/INTERNAL_FW from validation, COMMAND_OUT_OF_RANGE for a bad channel, COMMAND_EXEC_FAILED if a command returns false
+ *
+ *  Values travel the same way as everywhere else (big endian; see `pack()`/`unpack_*()` in `app_utils.h`):
+ *  	- uint8_t, bool, enums: 1 byte
+ *  	- uint16_t, uint32_t, int32_t, float: 4 bytes (16-bit values get widened to 32 bits, same as the hand-written handlers did)
+ *  	- std::pair<A, B>: A then B
+ *
+ *  All the type-dependent stuff collapses at compile time; the validation and ACK/NACK packing is shared (non-template) code
+ *  so every generated handler is basically: call validate --> resolve channel --> unpack --> call --> pack
+ *  Anything with extra logic (confirmation strings, lockouts, mode switches) should stay hand-written
+ */
+
+#ifndef COMMS_APP_COMMS_TYPED_HANDLER_H_
+#define COMMS_APP_COMMS_TYPED_HANDLER_H_
+
+#include <stddef.h> //for size_t
+#include <span> //for payload buffers
+#include <utility> //for pair, index_sequence
+#include <array> //for argument offsets
+#include <tuple> //for argument lists
+#include <type_traits> //for decay, is_enum
+
+#include "app_comms_parser.h" //for handler signatures and message types
+#include "app_utils.h" //for packing functions
+
+class Typed_Handler {
+public:
+	//================================ HOW VALUES GET PACKED ON THE WIRE ================================
+
+	template<typename T, typename Enable = void>
+	struct Wire; //deliberately undefined--binding a function with an unsupported type fails to compile here
+
+	//================================ DESCRIPTORS ================================
+
+	//command that applies to the whole device; `FN` is `bool (*)(args...)`
+	template<uint8_t CODE, auto FN>
+	static constexpr Parser::command_mapping_t command() {
+		return std::make_pair((size_t)CODE, &Global_Command<CODE, FN>::handle);
+	}
+
+	//command targeting a particular channel; `RESOLVE` is `T* (*)(size_t channel)`, `METHOD` is `bool (T::*)(args...)`
+	template<uint8_t CODE, auto RESOLVE, auto METHOD>
+	static constexpr Parser::command_mapping_t channel_command() {
+		return std::make_pair((size_t)CODE, &Channel_Command<CODE, RESOLVE, METHOD>::handle);
+	}
+
+	//request that applies to the whole device; `FN` is `R (*)()`
+	template<uint8_t CODE, auto FN>
+	static constexpr Parser::request_mapping_t request() {
+		return std::make_pair((size_t)CODE, &Global_Request<CODE, FN>::handle);
+	}
+
+	//request targeting a particular channel; `RESOLVE` is `T* (*)(size_t channel)`, `METHOD` is `R (T::*)()`
+	template<uint8_t CODE, auto RESOLVE, auto METHOD>
+	static constexpr Parser::request_mapping_t channel_request() {
+		return std::make_pair((size_t)CODE, &Channel_Request<CODE, RESOLVE, METHOD>::handle);
+	}
+
+	//delete any constructors
+	Typed_Handler() = delete;
+	Typed_Handler(Typed_Handler const&) = delete;
+
+private:
+	typedef std::pair<Parser::MessageType_t, size_t> response_t;
+
+	//================================ SHARED (NON-TEMPLATE) PIECES ================================
+	//live in the .cpp so every generated handler calls into the same code
+
+	//same checks as `VALIDATE_COMMAND`/`VALIDATE_REQUEST`; fills in `nack_response` if the checks fail
+	static bool validate(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+							std::span<uint8_t, std::dynamic_extent> tx_payload,
+							const size_t tx_min_size, const size_t rx_exact_size, const uint8_t code,
+							response_t& nack_response);
+
+	static response_t nack(std::span<uint8_t, std::dynamic_extent> tx_payload, const Parser::NACKErrorTypes_t reason);
+	static response_t ack(std::span<uint8_t, std::dynamic_extent> tx_payload, const uint8_t code);
+
+	//================================ SIGNATURE INTROSPECTION ================================
+
+	template<typename F> struct Signature;
+
+	//free/static functions
+	template<typename R, typename... Args>
+	struct Signature<R (*)(Args...)> {
+		typedef R return_t;
+		typedef void object_t;
+		typedef std::tuple<std::decay_t<Args>...> args_t;
+	};
+
+	//member functions (const or not)
+	template<typename R, typename T, typename... Args>
+	struct Signature<R (T::*)(Args...)> {
+		typedef R return_t;
+		typedef T object_t;
+		typedef std::tuple<std::decay_t<Args>...> args_t;
+	};
+	template<typename R, typename T, typename... Args>
+	struct Signature<R (T::*)(Args...) const> : Signature<R (T::*)(Args...)> {};
+
+	//where each argument starts in the payload, and how many bytes they take up all together (the last element)
+	template<typename Tuple> struct Args_Layout;
+	template<typename... Args>
+	struct Args_Layout<std::tuple<Args...>> {
+		static constexpr std::array<size_t, sizeof...(Args) + 1> OFFSETS = [] {
+			std::array<size_t, sizeof...(Args) + 1> offsets{};
+			std::array<size_t, sizeof...(Args)> sizes = {Wire<Args>::SIZE...};
+			for(size_t i = 0; i < sizeof...(Args); i++) offsets[i + 1] = offsets[i] + sizes[i];
+			return offsets;
+		}();
+		static constexpr size_t SIZE = OFFSETS[sizeof...(Args)];
+
+		//unpack every argument out of `buf` and hand them to `fn`
+		template<typename Fn, size_t... I>
+		static inline auto apply(Fn&& fn, std::span<const uint8_t, std::dynamic_extent> buf, std::index_sequence<I...>) {
+			return fn(Wire<Args>::unpack(buf.subspan(OFFSETS[I], Wire<Args>::SIZE))...);
+		}
+		template<typename Fn>
+		static inline auto apply(Fn&& fn, std::span<const uint8_t, std::dynamic_extent> buf) {
+			return apply(fn, buf, std::index_sequence_for<Args...>{});
+		}
+	};
+
+	//================================ GENERATED HANDLERS ================================
+
+	template<uint8_t CODE, auto FN>
+	struct Global_Command {
+		typedef Args_Layout<typename Signature<decltype(FN)>::args_t> layout;
+		static_assert(std::is_same_v<typename Signature<decltype(FN)>::return_t, bool>, "commands need to return whether they succeeded");
+
+		static response_t handle(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+									std::span<uint8_t, std::dynamic_extent> tx_payload)
+		{
+			response_t nack_response;
+			if(!validate(rx_payload, tx_payload, 1, 1 + layout::SIZE, CODE, nack_response)) return nack_response;
+			if(!layout::apply([](auto... args) { return FN(args...); }, rx_payload.subspan(1)))
+				return nack(tx_payload, Parser::NACK_ERROR_COMMAND_EXEC_FAILED);
+			return ack(tx_payload, CODE);
+		}
+	};
+
+	template<uint8_t CODE, auto RESOLVE, auto METHOD>
+	struct Channel_Command {
+		typedef Args_Layout<typename Signature<decltype(METHOD)>::args_t> layout;
+		static_assert(std::is_same_v<typename Signature<decltype(METHOD)>::return_t, bool>, "commands need to return whether they succeeded");
+
+		static response_t handle(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+									std::span<uint8_t, std::dynamic_extent> tx_payload)
+		{
+			response_t nack_response;
+			if(!validate(rx_payload, tx_payload, 1, 2 + layout::SIZE, CODE, nack_response)) return nack_response;
+
+			auto* target = RESOLVE(rx_payload[1]);
+			if(target == nullptr) return nack(tx_payload, Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE);
+
+			if(!layout::apply([target](auto... args) { return (target->*METHOD)(args...); }, rx_payload.subspan(2)))
+				return nack(tx_payload, Parser::NACK_ERROR_COMMAND_EXEC_FAILED);
+			return ack(tx_payload, CODE);
+		}
+	};
+
+	template<uint8_t CODE, auto FN>
+	struct Global_Request {
+		typedef typename Signature<decltype(FN)>::return_t value_t;
+		static_assert(std::tuple_size_v<typename Signature<decltype(FN)>::args_t> == 0, "requests don't take arguments");
+
+		static response_t handle(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+									std::span<uint8_t, std::dynamic_extent> tx_payload)
+		{
+			response_t nack_response;
+			if(!validate(rx_payload, tx_payload, 1 + Wire<value_t>::SIZE, 1, CODE, nack_response)) return nack_response;
+
+			tx_payload[0] = CODE; //this is the request we serviced
+			Wire<value_t>::pack(FN(), tx_payload.subspan(1, Wire<value_t>::SIZE));
+			return std::make_pair(Parser::DEVICE_RESPONSE_HOST_REQUEST, 1 + Wire<value_t>::SIZE);
+		}
+	};
+
+	template<uint8_t CODE, auto RESOLVE, auto METHOD>
+	struct Channel_Request {
+		typedef typename Signature<decltype(METHOD)>::return_t value_t;
+		static_assert(std::tuple_size_v<typename Signature<decltype(METHOD)>::args_t> == 0, "requests don't take arguments");
+
+		static response_t handle(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+									std::span<uint8_t, std::dynamic_extent> tx_payload)
+		{
+			response_t nack_response;
+			if(!validate(rx_payload, tx_payload, 2 + Wire<value_t>::SIZE, 2, CODE, nack_response)) return nack_response;
+
+			auto* target = RESOLVE(rx_payload[1]);
+			if(target == nullptr) return nack(tx_payload, Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE);
+
+			tx_payload[0] = CODE; //this is the request we serviced
+			tx_payload[1] = rx_payload[1]; //and the channel it corresponds to
+			Wire<value_t>::pack((target->*METHOD)(), tx_payload.subspan(2, Wire<value_t>::SIZE));
+			return std::make_pair(Parser::DEVICE_RESPONSE_HOST_REQUEST, 2 + Wire<value_t>::SIZE);
+		}
+	};
+};
+
+//================================ WIRE FORMATS ================================
+
+template<> struct Typed_Handler::Wire<uint8_t> {
+	static constexpr size_t SIZE = 1;
+	static inline uint8_t unpack(std::span<const uint8_t, std::dynamic_extent> buf) { return buf[0]; }
+	static inline void pack(const uint8_t val, std::span<uint8_t, std::dynamic_extent> buf) { buf[0] = val; }
+};
+
+template<> struct Typed_Handler::Wire<bool> {
+	static constexpr size_t SIZE = 1;
+	static inline bool unpack(std::span<const uint8_t, std::dynamic_extent> buf) { return buf[0] != 0; }
+	static inline void pack(const bool val, std::span<uint8_t, std::dynamic_extent> buf) { buf[0] = val ? 1 : 0; }
+};
+
+template<typename T> struct Typed_Handler::Wire<T, std::enable_if_t<std::is_enum_v<T>>> {
+	static constexpr size_t SIZE = 1;
+	static inline T unpack(std::span<const uint8_t, std::dynamic_extent> buf) { return (T)buf[0]; }
+	static inline void pack(const T val, std::span<uint8_t, std::dynamic_extent> buf) { buf[0] = (uint8_t)val; }
+};
+
+template<> struct Typed_Handler::Wire<uint16_t> {
+	static constexpr size_t SIZE = 4;
+	static inline uint16_t unpack(std::span<const uint8_t, std::dynamic_extent> buf) { return (uint16_t)unpack_uint32(buf); }
+	static inline void pack(const uint16_t val, std::span<uint8_t, std::dynamic_extent> buf) { ::pack((uint32_t)val, buf); }
+};
+
+template<> struct Typed_Handler::Wire<uint32_t> {
+	static constexpr size_t SIZE = 4;
+	static inline uint32_t unpack(std::span<const uint8_t, std::dynamic_extent> buf) { return unpack_uint32(buf); }
+	static inline void pack(const uint32_t val, std::span<uint8_t, std::dynamic_extent> buf) { ::pack(val, buf); }
+};
+
+template<> struct Typed_Handler::Wire<int32_t> {
+	static constexpr size_t SIZE = 4;
+	static inline int32_t unpack(std::span<const uint8_t, std::dynamic_extent> buf) { return unpack_int32(buf); }
+	static inline void pack(const int32_t val, std::span<uint8_t, std::dynamic_extent> buf) { ::pack(val, buf); }
+};
+
+template<> struct Typed_Handler::Wire<float> {
+	static constexpr size_t SIZE = 4;
+	static inline float unpack(std::span<const uint8_t, std::dynamic_extent> buf) { return unpack_float(buf); }
+	static inline void pack(const float val, std::span<uint8_t, std::dynamic_extent> buf) { ::pack(val, buf); }
+};
+
+template<typename A, typename B> struct Typed_Handler::Wire<std::pair<A, B>> {
+	static constexpr size_t SIZE = Wire<A>::SIZE + Wire<B>::SIZE;
+	static inline void pack(const std::pair<A, B>& val, std::span<uint8_t, std::dynamic_extent> buf) {
+		Wire<A>::pack(val.first, buf.subspan(0, Wire<A>::SIZE));
+		Wire<B>::pack(val.second, buf.subspan(Wire<A>::SIZE, Wire<B>::SIZE));
+	}
+};
+
+#endif /* COMMS_APP_COMMS_TYPED_HANDLER_H_ */
@@ -52,6 +52,10 @@ const Configuration::Configuration_Params Configuration::DEFAULT_CONFIG = {
 				DEFAULT_CONFIG_PS_CHANNEL_0
 		},
 
+		//host link supervision; off by default, so a host that doesn't know about it keeps working like it always has
+		.HEARTBEAT_WINDOW_MS = 0,
+		.HEARTBEAT_RAMP_MS = 50,
+
 		.CONFIG_CRC = 0,
 };
 
@@ -67,6 +67,10 @@ public:
 		static const size_t NUM_POWER_STAGES = POWER_STAGE_COUNT;
 		std::array<Power_Stage_Channel_Config, POWER_STAGE_COUNT> POWER_STAGE_CONFIGS;
 
+		//host link supervision (see `Comms_Heartbeat`)
+		uint32_t HEARTBEAT_WINDOW_MS; //how long the host can go quiet before we shut the stages down; 0 turns the watchdog off
+		uint32_t HEARTBEAT_RAMP_MS; //how long to take ramping setpoints to zero before disabling
+
 		//have a configuration checksum--useful to validate memory corruption/successful loads
 		//a correctly loaded config should have a CRC of 0
 		uint16_t CONFIG_CRC;
@@ -0,0 +1,237 @@
+/*
+ * app_config_param_map.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#include "app_config_param_map.h"
+
+#include <bit> //for bit_cast
+
+//shorthands to keep the descriptor tables below readable
+static inline uint32_t from_float(const float val) { return std::bit_cast<uint32_t>(val); }
+static inline float to_float(const uint32_t val) { return std::bit_cast<float>(val); }
+
+//================================================= DESCRIPTOR TABLES =================================================
+//same order as `Global_Param_t` and `Channel_Param_t`
+//{type, min, max, read, apply}
+
+const std::array<Param_Map::Param_Descriptor_t, 6> Param_Map::GLOBAL_PARAMS = {{
+		//SWITCHING_FREQUENCY; power stage does the real bounds checking
+		{TYPE_FLOAT, 10e3f, 10e6f,
+				[](Param_Map& map, const size_t) { return from_float(map.config.DESIRED_SWITCHING_FREQUENCY); },
+				[](Param_Map&, const size_t, const uint32_t value) { return Power_Stage_Subsystem::set_switching_frequency(to_float(value)); }},
+
+		//SAMPLING_FREQUENCY
+		{TYPE_FLOAT, 1e3f, 1e6f,
+				[](Param_Map& map, const size_t) { return from_float(map.config.DESIRED_SAMPLING_FREQUENCY); },
+				[](Param_Map&, const size_t, const uint32_t value) { return Power_Stage_Subsystem::set_controller_frequency(to_float(value)); }},
+
+		//SETPOINT_TICK_FREQUENCY
+		{TYPE_FLOAT, 0, 0,
+				[](Param_Map& map, const size_t) { return from_float(map.config.DESIRED_SETPOINT_TICK_FREQUENCY); },
+				nullptr},
+
+		//CONFIG_STORE_VERSION
+		{TYPE_UINT32, 0, 0,
+				[](Param_Map& map, const size_t) { return map.config.CONFIG_STORE_VERSION; },
+				nullptr},
+
+		//HEARTBEAT_WINDOW_MS; the watchdog reads these straight out of the config every pass, so just write them in
+		{TYPE_UINT32, 0, 3600000,
+				[](Param_Map& map, const size_t) { return map.config.HEARTBEAT_WINDOW_MS; },
+				[](Param_Map& map, const size_t, const uint32_t value) { map.config.HEARTBEAT_WINDOW_MS = value; return true; }},
+
+		//HEARTBEAT_RAMP_MS
+		{TYPE_UINT32, 0, 10000,
+				[](Param_Map& map, const size_t) { return map.config.HEARTBEAT_RAMP_MS; },
+				[](Param_Map& map, const size_t, const uint32_t value) { map.config.HEARTBEAT_RAMP_MS = value; return true; }},
+}};
+
+const std::array<Param_Map::Param_Descriptor_t, 15> Param_Map::CHANNEL_PARAMS = {{
+		//STAGE_MODE; can only be written to DISABLED--enabling a stage has to go through the enable commands and their confirmation strings
+		//the bounds also keep a bulk write's rollback from ever switching a stage back on (see `set_range()`)
+		{TYPE_UINT32, Power_Stage_Subsystem::DISABLED, Power_Stage_Subsystem::DISABLED,
+				[](Param_Map& map, const size_t channel) { return (uint32_t)map.stages[channel]->get_mode(); },
+				[](Param_Map& map, const size_t channel, const uint32_t) {
+					return map.stages[channel]->set_mode(Power_Stage_Subsystem::DISABLED); }},
+
+		//K_DC; regulator refuses all of these while it's running
+		{TYPE_FLOAT, 1e-3f, 1e7f,
+				[](Param_Map& map, const size_t channel) { return from_float(map.config.POWER_STAGE_CONFIGS[channel].K_DC); },
+				[](Param_Map& map, const size_t channel, const uint32_t value) {
+					return map.stages[channel]->get_regulator_instance().update_gain(to_float(value)); }},
+
+		//F_CROSSOVER
+		{TYPE_FLOAT, 1, 1e6f,
+				[](Param_Map& map, const size_t channel) { return from_float(map.config.POWER_STAGE_CONFIGS[channel].F_CROSSOVER); },
+				[](Param_Map& map, const size_t channel, const uint32_t value) {
+					return map.stages[channel]->get_regulator_instance().update_crossover_freq(to_float(value)); }},
+
+		//LOAD_RESISTANCE
+		{TYPE_FLOAT, 1e-4f, 1e3f,
+				[](Param_Map& map, const size_t channel) { return from_float(map.config.POWER_STAGE_CONFIGS[channel].LOAD_RESISTANCE); },
+				[](Param_Map& map, const size_t channel, const uint32_t value) {
+					return map.stages[channel]->get_regulator_instance().update_load_resistance(to_float(value)); }},
+
+		//LOAD_CHARACTERISTIC_FREQ
+		{TYPE_FLOAT, 1, 1e7f,
+				[](Param_Map& map, const size_t channel) { return from_float(map.config.POWER_STAGE_CONFIGS[channel].LOAD_CHARACTERISTIC_FREQ); },
+				[](Param_Map& map, const size_t channel, const uint32_t value) {
+					return map.stages[channel]->get_regulator_instance().update_load_natural_freq(to_float(value)); }},
+
+		//FINE_GAIN_TRIM; sampler trims are relative, so trim by whatever gets us from the current total to the new one
+		{TYPE_FLOAT, 0.5f, 2.0f,
+				[](Param_Map& map, const size_t channel) { return from_float(map.config.POWER_STAGE_CONFIGS[channel].FINE_GAIN_TRIM); },
+				[](Param_Map& map, const size_t channel, const uint32_t value) {
+					float total = map.config.POWER_STAGE_CONFIGS[channel].FINE_GAIN_TRIM;
+					return map.stages[channel]->get_sampler_instance().trim_fine(to_float(value) / total, 0); }},
+
+		//FINE_OFFSET_TRIM
+		{TYPE_FLOAT, -1000, 1000,
+				[](Param_Map& map, const size_t channel) { return from_float(map.config.POWER_STAGE_CONFIGS[channel].FINE_OFFSET_TRIM); },
+				[](Param_Map& map, const size_t channel, const uint32_t value) {
+					float total = map.config.POWER_STAGE_CONFIGS[channel].FINE_OFFSET_TRIM;
+					return map.stages[channel]->get_sampler_instance().trim_fine(1, to_float(value) - total); }},
+
+		//COARSE_GAIN_TRIM
+		{TYPE_FLOAT, 0.5f, 2.0f,
+				[](Param_Map& map, const size_t channel) { return from_float(map.config.POWER_STAGE_CONFIGS[channel].COARSE_GAIN_TRIM); },
+				[](Param_Map& map, const size_t channel, const uint32_t value) {
+					float total = map.config.POWER_STAGE_CONFIGS[channel].COARSE_GAIN_TRIM;
+					return map.stages[channel]->get_sampler_instance().trim_coarse(to_float(value) / total, 0); }},
+
+		//COARSE_OFFSET_TRIM
+		{TYPE_FLOAT, -1000, 1000,
+				[](Param_Map& map, const size_t channel) { return from_float(map.config.POWER_STAGE_CONFIGS[channel].COARSE_OFFSET_TRIM); },
+				[](Param_Map& map, const size_t channel, const uint32_t value) {
+					float total = map.config.POWER_STAGE_CONFIGS[channel].COARSE_OFFSET_TRIM;
+					return map.stages[channel]->get_sampler_instance().trim_coarse(1, to_float(value) - total); }},
+
+		//FINE_RANGE_VALID_LOW; sampler makes sure low stays below high
+		{TYPE_UINT32, 0, 0xFFFF,
+				[](Param_Map& map, const size_t channel) { return (uint32_t)map.config.POWER_STAGE_CONFIGS[channel].FINE_RANGE_VALID_LOW; },
+				[](Param_Map& map, const size_t channel, const uint32_t value) {
+					return map.stages[channel]->get_sampler_instance().set_limits_fine(value, map.config.POWER_STAGE_CONFIGS[channel].FINE_RANGE_VALID_HIGH); }},
+
+		//FINE_RANGE_VALID_HIGH
+		{TYPE_UINT32, 0, 0xFFFF,
+				[](Param_Map& map, const size_t channel) { return (uint32_t)map.config.POWER_STAGE_CONFIGS[channel].FINE_RANGE_VALID_HIGH; },
+				[](Param_Map& map, const size_t channel, const uint32_t value) {
+					return map.stages[channel]->get_sampler_instance().set_limits_fine(map.config.POWER_STAGE_CONFIGS[channel].FINE_RANGE_VALID_LOW, value); }},
+
+		//SETPOINT_RECON_BANDWIDTH; nothing reads this live (reconstruction filter's gone, see `app_setpoint_controller.h`), so just store it
+		{TYPE_FLOAT, 1, 1e6f,
+				[](Param_Map& map, const size_t channel) { return from_float(map.config.POWER_STAGE_CONFIGS[channel].SETPOINT_RECON_BANDWIDTH); },
+				[](Param_Map& map, const size_t channel, const uint32_t value) {
+					map.config.POWER_STAGE_CONFIGS[channel].SETPOINT_RECON_BANDWIDTH = to_float(value);
+					return true; }},
+
+		//SHUNT_RESISTANCE; hardware, so no writing these
+		{TYPE_FLOAT, 0, 0,
+				[](Param_Map& map, const size_t channel) { return from_float(map.config.POWER_STAGE_CONFIGS[channel].SHUNT_RESISTANCE); },
+				nullptr},
+
+		//FINE_AMP_GAIN
+		{TYPE_FLOAT, 0, 0,
+				[](Param_Map& map, const size_t channel) { return from_float(map.config.POWER_STAGE_CONFIGS[channel].FINE_AMP_GAIN_VpV); },
+				nullptr},
+
+		//COARSE_AMP_GAIN
+		{TYPE_FLOAT, 0, 0,
+				[](Param_Map& map, const size_t channel) { return from_float(map.config.POWER_STAGE_CONFIGS[channel].COARSE_AMP_GAIN_VpV); },
+				nullptr},
+}};
+
+//================================================= PUBLIC METHODS =================================================
+
+Param_Map::Param_Map(Configuration::Configuration_Params& _config, std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages):
+	config(_config), stages(_stages)
+{}
+
+const Param_Map::Param_Descriptor_t* Param_Map::describe(const uint16_t id) {
+	size_t channel;
+	return lookup(id, channel);
+}
+
+Param_Map::Param_Result_t Param_Map::get(const uint16_t id, uint32_t& value) {
+	size_t channel;
+	const Param_Descriptor_t* descriptor = lookup(id, channel);
+	if(descriptor == nullptr) return PARAM_UNKNOWN_ID;
+
+	value = descriptor->read(*this, channel);
+	return PARAM_OK;
+}
+
+Param_Map::Param_Result_t Param_Map::set(const uint16_t id, const uint32_t value) {
+	size_t channel;
+	const Param_Descriptor_t* descriptor = lookup(id, channel);
+	Param_Result_t result = check(descriptor, value);
+	if(result != PARAM_OK) return result;
+
+	if(!descriptor->apply(*this, channel, value)) return PARAM_APPLY_FAILED;
+	return PARAM_OK;
+}
+
+Param_Map::Param_Result_t Param_Map::get_range(const uint16_t first, std::span<uint32_t, std::dynamic_extent> values) {
+	if(values.size() > MAX_RANGE_COUNT) return PARAM_OUT_OF_BOUNDS;
+
+	for(size_t i = 0; i < values.size(); i++) {
+		Param_Result_t result = get((uint16_t)(first + i), values[i]);
+		if(result != PARAM_OK) return result;
+	}
+	return PARAM_OK;
+}
+
+Param_Map::Param_Result_t Param_Map::set_range(const uint16_t first, const std::span<const uint32_t, std::dynamic_extent> values) {
+	if(values.size() > MAX_RANGE_COUNT) return PARAM_OUT_OF_BOUNDS;
+
+	//check everything first, and remember what we're overwriting while we're at it
+	std::array<uint32_t, MAX_RANGE_COUNT> previous;
+	for(size_t i = 0; i < values.size(); i++) {
+		size_t channel;
+		const Param_Descriptor_t* descriptor = lookup((uint16_t)(first + i), channel);
+		Param_Result_t result = check(descriptor, values[i]);
+		if(result != PARAM_OK) return result;
+		previous[i] = descriptor->read(*this, channel);
+	}
+
+	//then apply in order; if anything gets refused, put back whatever we already changed (newest first)
+	//putting things back goes through the same checks as any other write, so nothing gets restored to a value a host couldn't write itself
+	//	\--> i.e. a stage this write disabled STAYS disabled, even if it was running before
+	for(size_t i = 0; i < values.size(); i++) {
+		if(set((uint16_t)(first + i), values[i]) == PARAM_OK) continue;
+		while(i-- > 0) set((uint16_t)(first + i), previous[i]);
+		return PARAM_APPLY_FAILED;
+	}
+	return PARAM_OK;
+}
+
+//================================================= PRIVATE METHODS =================================================
+
+const Param_Map::Param_Descriptor_t* Param_Map::lookup(const uint16_t id, size_t& channel) {
+	size_t block = id / BLOCK_SIZE;
+	size_t index = id % BLOCK_SIZE;
+
+	//device-wide parameters
+	if(block == 0) {
+		channel = 0;
+		return (index < GLOBAL_PARAMS.size()) ? &GLOBAL_PARAMS[index] : nullptr;
+	}
+
+	//channel parameters; make sure we actually have that channel
+	channel = block - 1;
+	if(channel >= stages.size() || index >= CHANNEL_PARAMS.size()) return nullptr;
+	return &CHANNEL_PARAMS[index];
+}
+
+Param_Map::Param_Result_t Param_Map::check(const Param_Descriptor_t* descriptor, const uint32_t value) {
+	if(descriptor == nullptr) return PARAM_UNKNOWN_ID;
+	if(descriptor->apply == nullptr) return PARAM_READ_ONLY;
+
+	//written this way around so a NaN fails the check too
+	float as_float = (descriptor->type == TYPE_FLOAT) ? to_float(value) : (float)value;
+	if(!(as_float >= descriptor->min && as_float <= descriptor->max)) return PARAM_OUT_OF_BOUNDS;
+	return PARAM_OK;
+}
@@ -0,0 +1,144 @@
+/*
+ * app_config_param_map.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Register-map style access to every tunable on the device
+ *
+ *  Every parameter gets a 16-bit ID, and a descriptor saying:
+ *  	- its type (how the 4 bytes it travels in should be read)
+ *  	- the bounds a new value has to fall within
+ *  	- how to read it, and how to apply a new value (through the same subsystem methods the dedicated handlers use, so all
+ *  	  the usual safety checks still happen, i.e. no changing the crossover frequency while the regulator's running)
+ *  		\--> no apply hook means the parameter is read-only
+ *  		\--> checks that live in the HANDLERS rather than the subsystems don't come along, so anything guarded that way has to be
+ *  			 bounded here instead (i.e. STAGE_MODE only takes DISABLED, since enabling a stage needs the enable commands' confirmation string)
+ *  Adding a tunable is just adding a line to one of the descriptor tables in the .cpp--no new handlers necessary
+ *
+ *  IDs are split into blocks of 256:
+ *  	- block 0:			device-wide parameters (`Global_Param_t`)
+ *  	- block 1 + n:		parameters of channel n (`Channel_Param_t`), same layout for every channel
+ *  so a contiguous run of IDs inside a block can be read or written in one go
+ *
+ *  Bulk writes are all-or-nothing, as far as we can manage:
+ *  	- every value gets checked (exists, writable, in bounds) before anything is applied
+ *  	- values are applied in ID order; if one gets refused, the ones already applied are put back the way they were
+ *  		\--> as long as the old value passes the usual checks, i.e. a stage that got disabled stays disabled
+ *  		\--> order matters for a few pairs (i.e. FINE_RANGE_VALID_LOW/HIGH), since each one gets applied on its own
+ *
+ *  NOTE: bounds are stored as floats, so they're only exact for integer parameters below 2^24
+ *  NOTE: only to be used from the main loop
+ */
+
+#ifndef CONFIG_APP_CONFIG_PARAM_MAP_H_
+#define CONFIG_APP_CONFIG_PARAM_MAP_H_
+
+#include <stddef.h> //for size_t
+#include <array>
+#include <span>
+
+extern "C" {
+	#include "stm32g474xx.h" //for uint types
+}
+
+#include "app_config.h" //the configuration the parameters live in
+#include "app_power_stage_top_level.h" //the subsystems that apply them
+
+class Param_Map {
+public:
+	//======================================================= PARAMETER DESCRIPTIONS =======================================================
+	enum Param_Type_t : uint8_t {
+		TYPE_FLOAT	= (uint8_t)0x00, //IEEE 754 single precision
+		TYPE_UINT32	= (uint8_t)0x01,
+	};
+
+	//values always travel as their raw 4 bytes; `type` says how to read them
+	struct Param_Descriptor_t {
+		Param_Type_t type;
+		float min; //inclusive
+		float max; //inclusive
+		uint32_t (*read)(Param_Map& map, const size_t channel);
+		bool (*apply)(Param_Map& map, const size_t channel, const uint32_t value); //nullptr if read-only
+	};
+
+	enum Param_Result_t : uint8_t {
+		PARAM_OK,
+		PARAM_UNKNOWN_ID,		//nothing mapped to (one of) the ID(s)
+		PARAM_READ_ONLY,		//tried to write something without an apply hook
+		PARAM_OUT_OF_BOUNDS,	//new value outside the parameter's bounds (or too many values at once)
+		PARAM_APPLY_FAILED,		//the subsystem refused the new value
+	};
+
+	//======================================================= PARAMETER IDS =======================================================
+	//ONLY APPEND to these; the host addresses parameters by their position here
+	static constexpr size_t BLOCK_SIZE = 256;
+
+	enum Global_Param_t : uint8_t {
+		SWITCHING_FREQUENCY,		//float, Hz
+		SAMPLING_FREQUENCY,			//float, Hz (i.e. controller update rate)
+		SETPOINT_TICK_FREQUENCY,	//float, Hz; read-only
+		CONFIG_STORE_VERSION,		//uint32; read-only
+		HEARTBEAT_WINDOW_MS,		//uint32, ms; 0 turns the host heartbeat watchdog off
+		HEARTBEAT_RAMP_MS,			//uint32, ms
+	};
+
+	enum Channel_Param_t : uint8_t {
+		STAGE_MODE,					//uint32, see `Power_Stage_Subsystem::Stage_Mode`; can only be written to DISABLED
+		K_DC,						//float, controller DC gain
+		F_CROSSOVER,				//float, Hz
+		LOAD_RESISTANCE,			//float, ohms
+		LOAD_CHARACTERISTIC_FREQ,	//float, Hz
+		FINE_GAIN_TRIM,				//float, total gain trim (not relative, unlike SAMPLER_TRIM_FINE)
+		FINE_OFFSET_TRIM,			//float, total offset trim
+		COARSE_GAIN_TRIM,			//float, total gain trim
+		COARSE_OFFSET_TRIM,			//float, total offset trim
+		FINE_RANGE_VALID_LOW,		//uint32, ADC code
+		FINE_RANGE_VALID_HIGH,		//uint32, ADC code
+		SETPOINT_RECON_BANDWIDTH,	//float, Hz
+		SHUNT_RESISTANCE,			//float, ohms; read-only
+		FINE_AMP_GAIN,				//float, V/V; read-only
+		COARSE_AMP_GAIN,			//float, V/V; read-only
+	};
+
+	static constexpr uint16_t global_param(const Global_Param_t param) { return (uint16_t)param; }
+	static constexpr uint16_t channel_param(const size_t channel, const Channel_Param_t param) { return (uint16_t)((channel + 1) * BLOCK_SIZE + param); }
+
+	//most values a single bulk read/write can cover
+	static constexpr size_t MAX_RANGE_COUNT = 64;
+
+	//======================================================= PUBLIC METHODS =======================================================
+
+	Param_Map(Configuration::Configuration_Params& _config, std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages);
+
+	//delete copy constructor and assignment operator; handlers hang onto a pointer to this
+	Param_Map(Param_Map const&) = delete;
+	void operator=(Param_Map const&) = delete;
+
+	//descriptor for a particular ID; nullptr if nothing's mapped there
+	const Param_Descriptor_t* describe(const uint16_t id);
+
+	//single parameter access
+	Param_Result_t get(const uint16_t id, uint32_t& value);
+	Param_Result_t set(const uint16_t id, const uint32_t value);
+
+	//bulk access over `first`, `first + 1`, ... (as many as there are values)
+	Param_Result_t get_range(const uint16_t first, std::span<uint32_t, std::dynamic_extent> values);
+	Param_Result_t set_range(const uint16_t first, const std::span<const uint32_t, std::dynamic_extent> values);
+
+private:
+	//figure out which channel (if any) an ID belongs to
+	const Param_Descriptor_t* lookup(const uint16_t id, size_t& channel);
+
+	//check a new value against its descriptor without applying it
+	static Param_Result_t check(const Param_Descriptor_t* descriptor, const uint32_t value);
+
+	//for the read/apply hooks
+	Configuration::Configuration_Params& config;
+	std::span<Power_Stage_Subsystem*, std::dynamic_extent> stages;
+
+	static const std::array<Param_Descriptor_t, 6> GLOBAL_PARAMS;
+	static const std::array<Param_Descriptor_t, 15> CHANNEL_PARAMS;
+};
+
+#endif /* CONFIG_APP_CONFIG_PARAM_MAP_H_ */
@@ -169,6 +169,29 @@ void Regulator::disable() {
 	enabled = false;
 }
 
+//###### REGULATION LOOP TAP ######
+
+void Regulator::attach_tap_cb(Context_Callback_Function<> _tap_cb) {
+	//ISR preempts us (not the other way around), so once the flag is cleared the ISR won't touch the callback until we set it again
+	tap_enabled = false;
+	tap_cb = _tap_cb;
+}
+
+void Regulator::enable_tap() { tap_enabled = true; }
+void Regulator::disable_tap() { tap_enabled = false; }
+
+void Regulator::attach_cycle_start_cb(Context_Callback_Function<> _cycle_start_cb) {
+	//same deal as the tap; just re-enable it straight away since there's no separate enable for this one
+	cycle_start_enabled = false;
+	cycle_start_cb = _cycle_start_cb;
+	cycle_start_enabled = true;
+}
+
+float Regulator::get_last_setpoint() { return last_setpoint; }
+float Regulator::get_last_current() { return last_current; }
+float Regulator::get_last_output() { return last_output; }
+uint32_t Regulator::get_cycle_count() { return cycle_count.load(std::memory_order_acquire); }
+
 //====================================== PRIVATE METHODS ====================================
 void Regulator::regulate_forwarder(void* context) {
 	static_cast<Regulator*>(context)->regulate();
@@ -176,6 +199,16 @@ void Regulator::regulate_forwarder(void* context) {
 
 //avoid enable sanity checking to reduce overhead
 void Regulator::regulate() {
+	//let anyone reading our outputs know they might've changed under them
+	cycle_count.store(cycle_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	//run anything that has to land on this exact cycle first
+	//it might've shut us down (i.e. a scheduled STAGE_DISABLE), in which case don't touch the stage again
+	if(cycle_start_enabled) {
+		cycle_start_cb();
+		if(!enabled) return;
+	}
+
 	//grab the next band-limited setpoint target
 	float sp = setpoint.next();
 
@@ -190,4 +223,11 @@ void Regulator::regulate() {
 
 	//throw the output to the power stage (stage will constrain this output)
 	stage.set_drive_raw(output);
+
+	//stash everything from this cycle and let anyone listening in have a look
+	//keep the tap last so it doesn't add any latency to the control path
+	last_setpoint = sp;
+	last_current = current;
+	last_output = output;
+	if(tap_enabled) tap_cb();
 }
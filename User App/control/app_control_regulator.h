@@ -13,9 +13,11 @@
 #define CONTROL_APP_CONTROL_REGULATOR_H_
 
 #include <stddef.h> //for size_t
+#include <atomic> //for the cycle counter
 
 #include "app_config.h" //access the configuration information
 #include "app_control_compensator.h"
+#include "app_utils.h" //for callback functions
 
 #include "app_power_stage_drive.h" //grab stuff related to the output
 #include "app_power_stage_sampler.h" //grab stuff related to the input
@@ -54,6 +56,27 @@ public:
 	float get_load_resistance();
 	float get_load_natural_freq();
 
+	//hook into the regulation loop, i.e. for telemetry
+	//the tap callback runs at the tail end of every `regulate()` call while the tap is enabled--SO IT RUNS IN THE REGULATOR ISR
+	//attaching a callback disables the tap, so the ISR never sees a half-written callback; enable it again once attached
+	void attach_tap_cb(Context_Callback_Function<> _tap_cb);
+	void enable_tap();
+	void disable_tap();
+
+	//hook into the START of every regulation cycle, i.e. for commands scheduled to land on a particular cycle
+	//runs IN THE REGULATOR ISR before the setpoint is read, so anything it changes takes effect this very cycle
+	//if the callback ends up disabling the regulator, the rest of the cycle gets skipped
+	void attach_cycle_start_cb(Context_Callback_Function<> _cycle_start_cb);
+
+	//values from the most recent regulation cycle; meant to be read from the tap callback
+	float get_last_setpoint();
+	float get_last_current();
+	float get_last_output();
+
+	//free-running count of regulation cycles, bumped at the very start of every `regulate()`
+	//read it before and after reading anything the regulator ISR writes--if it didn't move, everything read came from the same cycle
+	uint32_t get_cycle_count();
+
 private:
 	//================= MAIN REGULATION FUNCTION; CALLED BY SAMPLER ==================
 	static void __attribute__((optimize("O3"))) regulate_forwarder(void* context);
@@ -69,6 +92,20 @@ private:
 	//============================ OTHER MEMBER VARIABLES ============================
 	const size_t index; //which power stage this regulator corresponds to
 	bool enabled = false; //local variable to hold whether the regulator is enabled or not
+
+	//snapshot of the most recent regulation cycle
+	float last_setpoint = 0;
+	float last_current = 0;
+	float last_output = 0;
+	std::atomic<uint32_t> cycle_count{0};
+
+	//optional callback at the end of every regulation cycle
+	Context_Callback_Function<> tap_cb = {};
+	volatile bool tap_enabled = false;
+
+	//optional callback at the start of every regulation cycle
+	Context_Callback_Function<> cycle_start_cb = {};
+	volatile bool cycle_start_enabled = false;
 };
 
 //=================================================== WRAPPER INTERFACE TO LIMIT ACCESS =========================================================
@@ -96,6 +133,15 @@ public:
 	inline float get_crossover_freq() {return regulator.get_crossover_freq();}
 	inline float get_load_resistance() {return regulator.get_load_resistance();}
 	inline float get_load_natural_freq() {return regulator.get_load_natural_freq();}
+
+	inline void attach_tap_cb(Context_Callback_Function<> cb) {regulator.attach_tap_cb(cb);}
+	inline void enable_tap() {regulator.enable_tap();}
+	inline void disable_tap() {regulator.disable_tap();}
+	inline void attach_cycle_start_cb(Context_Callback_Function<> cb) {regulator.attach_cycle_start_cb(cb);}
+	inline float get_last_setpoint() {return regulator.get_last_setpoint();}
+	inline float get_last_current() {return regulator.get_last_current();}
+	inline float get_last_output() {return regulator.get_last_output();}
+	inline uint32_t get_cycle_count() {return regulator.get_cycle_count();}
 };
 
 #endif /* CONTROL_APP_CONTROL_REGULATOR_H_ */
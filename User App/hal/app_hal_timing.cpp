@@ -25,3 +25,26 @@ void Timer::delay_ms(uint32_t ms) {
 uint32_t Timer::get_ms(){
 	return HAL_GetTick();
 }
+
+//turn on the DWT cycle counter
+//needs the trace block enabled first, otherwise writes to the DWT are ignored
+void Timer::init_cycle_counter() {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+//raw cycle count
+uint32_t Timer::get_cycles() {
+	return DWT->CYCCNT;
+}
+
+//convert a cycle count (i.e. a difference of two `get_cycles()` calls) to microseconds
+uint32_t Timer::cycles_to_us(uint32_t cycles) {
+	return cycles / (SystemCoreClock / 1000000);
+}
+
+//how fast the cycle counter ticks
+uint32_t Timer::get_cycles_per_second() {
+	return SystemCoreClock;
+}
@@ -21,6 +21,13 @@ public:
 	static void delay_ms(uint32_t ms);
 	static uint32_t get_ms();
 
+	//free-running CPU cycle counter (DWT); good for timing things well below a millisecond
+	//call `init_cycle_counter()` once at start up; wraps every 2^32 cycles (~25s at 170MHz), so only ever look at differences
+	static void init_cycle_counter();
+	static uint32_t get_cycles();
+	static uint32_t cycles_to_us(uint32_t cycles);
+	static uint32_t get_cycles_per_second();
+
 private:
 	Timer(); //don't allow instantiation of a timer class just yet
 };
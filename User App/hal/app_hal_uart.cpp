@@ -8,6 +8,10 @@
 #include "app_hal_uart.h"
 
 #include <algorithm> //for stl versions of memcpy
+#include <bit> //for has_single_bit
+
+//frame queues only use a power-of-two number of slots (see `Frame_Queue`); make sure we aren't quietly losing any
+static_assert(std::has_single_bit(UART::RX_QUEUE_DEPTH) && std::has_single_bit(UART::TX_QUEUE_DEPTH), "UART queue depths need to be powers of two");
 
 ///========================= initialization of static fields ========================
 //don't need to worry about the null pointer really--UART instance will be initialized before it has a chance to be called
@@ -15,22 +19,32 @@ UART::UART_Hardware_Channel UART::LPUART = {
 		.huart = &hlpuart1,
 		.init_func = Callback_Function(MX_LPUART1_UART_Init),
 		.rx_interrupt = Instance_Callback_Function<UART>(),
+		.tx_interrupt = Instance_Callback_Function<UART>(),
+		.error_interrupt = Instance_Callback_Function<UART>(),
 };
 
 UART::UART_Hardware_Channel UART::UART3 = {
 		.huart = &huart3,
 		.init_func = Callback_Function(MX_USART3_UART_Init),
 		.rx_interrupt = Instance_Callback_Function<UART>(),
+		.tx_interrupt = Instance_Callback_Function<UART>(),
+		.error_interrupt = Instance_Callback_Function<UART>(),
 };
 
 //===================================================================================
 
 UART::UART(	UART_Hardware_Channel& _hardware, const uint8_t _START_OF_FRAME, const uint8_t _END_OF_FRAME,
-			std::span<uint8_t, std::dynamic_extent> _txbuf, std::span<uint8_t, std::dynamic_extent> _rxbuf):
-	hardware(_hardware), START_OF_FRAME(_START_OF_FRAME), END_OF_FRAME(_END_OF_FRAME), txbuf(_txbuf), rxbuf(_rxbuf)
+			std::span<uint8_t, std::dynamic_extent> _txbuf, std::span<uint8_t, std::dynamic_extent> _rxbuf,
+			UART_Frame_Decoder* const _rx_decoder):
+	hardware(_hardware), START_OF_FRAME(_START_OF_FRAME), END_OF_FRAME(_END_OF_FRAME), txbuf(_txbuf), rxbuf(_rxbuf),
+	rx_frames(_rxbuf, rx_frame_lengths),
+	rx_extractor(_START_OF_FRAME, _END_OF_FRAME, rx_dma_ring, rx_frames, _rx_decoder),
+	tx_frames(_txbuf, tx_frame_lengths)
 {
-	//register the instance callback function with the particular hardware channel
+	//register the instance callback functions with the particular hardware channel
 	hardware.rx_interrupt = Instance_Callback_Function<UART>(this, &UART::RX_interrupt_handler);
+	hardware.tx_interrupt = Instance_Callback_Function<UART>(this, &UART::TX_interrupt_handler);
+	hardware.error_interrupt = Instance_Callback_Function<UART>(this, &UART::ERROR_interrupt_handler);
 }
 
 void UART::init() {
@@ -38,97 +52,190 @@ void UART::init() {
 	//this is done by cubeMX
 	hardware.init_func();
 
-	//start listening for received packets over interrupt
-	HAL_UART_Receive_IT(hardware.huart, &received_char, 1);
+	//start listening for received packets over circular DMA
+	start_receive();
 }
 
-void UART::transmit(const std::span<uint8_t, std::dynamic_extent> bytes_to_tx) {
-	//if our transmit buffer isn't big enough to transmit the message, don't even try sending
-	if(bytes_to_tx.size() > txbuf.size()) return;
+bool UART::transmit(const std::span<uint8_t, std::dynamic_extent> bytes_to_tx) {
+	//if a transmit slot isn't big enough to transmit the message, don't even try sending
+	if(bytes_to_tx.size() > tx_frames.slot_size()) return false;
+
+	//grab the next free slot in the transmit queue; if there isn't one, let the caller decide what to do
+	auto slot = reserve_transmit();
+	if(slot.empty()) return false;
 
-	//only copy over when the previous transmit has finished
-	while(hardware.huart->gState != HAL_UART_STATE_READY); //wait for the UART to be ready for transmit
+	//copy over the message using stl conventions and hand it to the queue
+	std::copy(bytes_to_tx.begin(), bytes_to_tx.end(), slot.begin());
+	return commit_transmit(bytes_to_tx.size());
+}
 
-	//copy over the message using stl conventions
-	std::copy(bytes_to_tx.begin(), bytes_to_tx.end(), txbuf.begin());
+std::span<uint8_t, std::dynamic_extent> UART::reserve_transmit() { return tx_frames.write_slot(); }
 
-	//fire off a transmit over DMA with the amount of bytes corresponding to the input message
-	HAL_UART_Transmit_DMA(hardware.huart, txbuf.data(), (uint16_t)bytes_to_tx.size());
+bool UART::commit_transmit(const size_t length) {
+	//publish the message to the queue
+	if(!tx_frames.push(length)) return false;
+
+	//if the transmitter is idle, get it going; otherwise the TX ISR will pick the message up when it gets to it
+	if(!tx_in_flight) start_transmit();
+	return true;
 }
 
 size_t UART::get_packet(std::span<uint8_t, std::dynamic_extent> rx_packet) {
-	//if we don't have a packet, return 0
-	if(!received_packet_pending) return 0;
+	//grab the oldest packet in the queue; if we don't have one, return 0
+	auto buf_section = peek_packet();
+	if(buf_section.empty()) return 0;
 
 	//if we do have a packet
 
-	//compute the packet size
-	//the size will be rx_buffer_pointer + 1 since SOF will be at 0 and EOF will be at rx_buffer_pointer
-	size_t packet_size = rx_buffer_pointer + 1;
-
-	//ensure that we have enough space to put the RX buffer into the rx_packet
+	//ensure that we have enough space to put the packet into the rx_packet
 	//do this the canonical c++ way using
-	if(rx_packet.size() >= packet_size) {
-		auto buf_section = rxbuf.subspan(0, packet_size); //grab the relevant slice of the rx buffer
+	size_t packet_size = buf_section.size();
+	if(rx_packet.size() >= packet_size)
 		std::copy(buf_section.begin(), buf_section.end(), rx_packet.begin()); //copy it into the packet passed in
-	}
 
-	//indicate that we have serviced the packet and we can start listening again
-	received_packet_pending = false;
+	//indicate that we have serviced the packet and free up the slot for the ISR
+	release_packet();
 
 	return packet_size;
 }
 
-bool UART::ready_to_send() { return hardware.huart->gState == HAL_UART_STATE_READY; }
+std::span<uint8_t, std::dynamic_extent> UART::peek_packet() { return rx_frames.front(); }
+void UART::release_packet() { rx_frames.pop(); }
+
+bool UART::ready_to_send() { return !tx_frames.full(); }
+size_t UART::tx_slots_free() { return tx_frames.capacity() - tx_frames.size(); }
+bool UART::tx_idle() { return tx_frames.empty() && !tx_in_flight; }
+uint32_t UART::get_baud_rate() { return hardware.huart->Init.BaudRate; }
 bool UART::uart_ok() { return HAL_UART_GetError(hardware.huart) == HAL_UART_ERROR_NONE; }
-bool UART::available() { return received_packet_pending; }
+bool UART::available() { return !rx_frames.empty(); }
+uint32_t UART::get_rx_dropped_count() { return rx_extractor.get_dropped_count(); }
+uint32_t UART::get_rx_overflow_count() { return rx_extractor.get_overflow_count(); }
+uint32_t UART::get_rx_reject_count() { return rx_extractor.get_reject_count(); }
+
+bool UART::baud_rate_supported(const uint32_t baud) {
+	if(baud == 0) return false;
+
+	//same math the HAL uses to compute the baud rate register--just check that it lands in the legal range
+	//both of our UARTs are clocked off PCLK1 (configured in cubeMX)
+	UART_HandleTypeDef* huart = hardware.huart;
+	uint32_t pclk = HAL_RCC_GetPCLK1Freq();
+	if(IS_LPUART_INSTANCE(huart->Instance)) {
+		uint32_t brr = UART_DIV_LPUART(pclk, baud, huart->Init.ClockPrescaler);
+		return brr >= BRR_MIN_LPUART && brr <= BRR_MAX_LPUART;
+	}
+	uint32_t brr = 	(huart->Init.OverSampling == UART_OVERSAMPLING_8) ?
+					UART_DIV_SAMPLING8(pclk, baud, huart->Init.ClockPrescaler) :
+					UART_DIV_SAMPLING16(pclk, baud, huart->Init.ClockPrescaler);
+	return brr >= BRR_MIN_USART && brr <= BRR_MAX_USART;
+}
 
-void UART::RX_interrupt_handler() {
-	//we've received a packet and we're waiting for the main thread to process it
-	//as such, only modify the buffer once the pending packet has already been dispatched
-	if(!received_packet_pending) {
-
-		//check if we've received a start of frame (and that we're not waiting on a packet to be serviced)
-		if(received_char == START_OF_FRAME) {
-			rxbuf[0] = received_char; //put the SOF in the first spot in our receive buffer
-			rx_buffer_pointer = 1; //point to the next free index
-			received_sof_good_packet = true; //start listening to the rest of the message
-		}
-
-		//alternatively, check if we've received an end-of-frame
-		else if(received_char == END_OF_FRAME) {
-			//if we've received a start of frame and we have space to add the character to the buffer
-			//add the character to the buffer and notify the main thread
-			if(received_sof_good_packet) {
-				rxbuf[rx_buffer_pointer] = received_char;
-				received_packet_pending = true;
-			}
-
-			//wait for a new frame to roll in
-			received_sof_good_packet = false;
-		}
-
-		//in this case, any old character rolls in
-		else {
-			//write the character to the buffer
-			rxbuf[rx_buffer_pointer] = received_char;
-
-			//increment our buffer pointer if we can
-			//if we can't, it means we have a bad packet; prevent it from being dispatched
-			if(rx_buffer_pointer < rxbuf.size() - 1) rx_buffer_pointer++;
-			else received_sof_good_packet = false;
-		}
+bool UART::set_baud_rate(const uint32_t baud) {
+	//don't pull the rug out from under anything that's going out
+	if(!tx_idle()) return false;
+	if(!baud_rate_supported(baud)) return false;
+
+	//stop listening while we reconfigure
+	HAL_UART_AbortReceive(hardware.huart);
+
+	//re-running the HAL init reconfigures the baud rate (MSP init doesn't run again since the handle isn't in reset state)
+	//it also clobbers the FIFO thresholds though, so hang onto whatever cubeMX set them to
+	uint32_t fifo_config = hardware.huart->Instance->CR3;
+	uint32_t previous_baud = hardware.huart->Init.BaudRate;
+	hardware.huart->Init.BaudRate = baud;
+	bool success = HAL_UART_Init(hardware.huart) == HAL_OK;
+	if(!success) {
+		hardware.huart->Init.BaudRate = previous_baud;
+		HAL_UART_Init(hardware.huart);
 	}
+	HAL_UARTEx_SetTxFifoThreshold(hardware.huart, fifo_config & USART_CR3_TXFTCFG);
+	HAL_UARTEx_SetRxFifoThreshold(hardware.huart, fifo_config & USART_CR3_RXFTCFG);
+
+	//and pick up receiving where we left off
+	start_receive();
+	return success;
+}
+
+bool UART::enable_driver_enable() {
+	//same deal as changing the baud rate; make sure nothing's going out, and stop listening while we reconfigure
+	if(!tx_idle()) return false;
+	HAL_UART_AbortReceive(hardware.huart);
+
+	//the HAL re-runs the whole peripheral init with DE turned on, so put the FIFO thresholds back afterwards
+	uint32_t fifo_config = hardware.huart->Instance->CR3;
+	bool success = HAL_RS485Ex_Init(hardware.huart, UART_DE_POLARITY_HIGH, DE_ASSERTION_TIME, DE_DEASSERTION_TIME) == HAL_OK;
+	HAL_UARTEx_SetTxFifoThreshold(hardware.huart, fifo_config & USART_CR3_TXFTCFG);
+	HAL_UARTEx_SetRxFifoThreshold(hardware.huart, fifo_config & USART_CR3_RXFTCFG);
+
+	start_receive();
+	return success;
+}
+
+void UART::RX_interrupt_handler() {
+	//figure out where the DMA is in the ring buffer and pull out any frames that have arrived since the last event
+	//DMA counts down the remaining transfers, so the write index is just the difference from the ring size
+	rx_extractor.service(rx_dma_ring.size() - __HAL_DMA_GET_COUNTER(hardware.huart->hdmarx));
+}
+
+void UART::TX_interrupt_handler() {
+	//the oldest message in the queue just finished going out; free its slot and send the next one (if any)
+	tx_frames.pop();
+	tx_in_flight = false;
+	start_transmit();
+}
+
+void UART::ERROR_interrupt_handler() {
+	//blocking errors (i.e. overruns) make the HAL abort the receive DMA
+	//if that happened, restart the reception from the top of the ring
+	if(hardware.huart->RxState == HAL_UART_STATE_READY) start_receive();
+
+	//a transmit DMA error aborts the transmission without a TX complete callback
+	//drop the message that was on the wire and keep the queue moving
+	if(tx_in_flight && hardware.huart->gState == HAL_UART_STATE_READY) TX_interrupt_handler();
+}
+
+//==================================== PRIVATE FUNCTIONS ====================================
+
+void UART::start_receive() {
+	//start the extractor from the top of the ring since that's where the DMA will start writing
+	rx_extractor.reset();
 
-	//listen for more bytes over UART
-	HAL_UART_Receive_IT(hardware.huart, &received_char, 1);
+	//run the DMA in circular mode (configured in CubeMX) and ask for an event on idle line + half/full transfer
+	HAL_UARTEx_ReceiveToIdle_DMA(hardware.huart, rx_dma_ring.data(), (uint16_t)rx_dma_ring.size());
+}
+
+void UART::start_transmit() {
+	//NOTE: this runs from both the main thread (via `transmit()`) and the TX ISR
+	//that's fine since the main thread only ever gets here when nothing is in flight, i.e. when the TX ISR can't fire
+	if(tx_in_flight) return;
+
+	//nothing to send, just stay idle
+	auto message = tx_frames.front();
+	if(message.empty()) return;
+
+	//mark the transmitter busy *before* firing off the DMA so the completion ISR always sees a consistent state
+	//and fire off a transmit over DMA with the amount of bytes corresponding to the queued message
+	tx_in_flight = true;
+	HAL_UART_Transmit_DMA(hardware.huart, message.data(), (uint16_t)message.size());
 }
 
 //======================================= PROCESSOR ISRs ====================================
 //TODO: optimize the UART ISRs to be lighter weight and only use the functions we need; implement RX Fifo full callback
 
-//call the appropriate RX complete interrupt handler according to which UART caused the interrupt
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) {
+//call the appropriate RX event interrupt handler according to which UART caused the interrupt
+//fires on idle line, half transfer, and full transfer of the circular DMA; we read the DMA counter ourselves so ignore `Size`
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size) {
 	if(huart == UART::LPUART.huart) UART::LPUART.rx_interrupt();
 	if(huart == UART::UART3.huart) UART::UART3.rx_interrupt();
 }
+
+//call the appropriate TX complete handler according to which UART caused the interrupt
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
+	if(huart == UART::LPUART.huart) UART::LPUART.tx_interrupt();
+	if(huart == UART::UART3.huart) UART::UART3.tx_interrupt();
+}
+
+//call the appropriate error handler according to which UART caused the interrupt
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
+	if(huart == UART::LPUART.huart) UART::LPUART.error_interrupt();
+	if(huart == UART::UART3.huart) UART::UART3.error_interrupt();
+}
@@ -5,8 +5,18 @@
  *      Author: Ishaan
  *
  *  Notes to myself:
- *  	- Don't need to worry about DMA complete callback for transmit--just check about UART busy basically
- *  	- Call `service_RX_interrupt()` in the rx complete interrupt (wait this should 100% be called by the class itself
+ *  	- Transmit queues frames into a small SPSC `Frame_Queue` carved out of `txbuf`
+ *  		\--> the TX complete interrupt pops the frame that just finished and fires off DMA for the next one
+ *  		\--> so the caller never has to wait for the wire; it only gets turned away if every slot is occupied
+ *  		\--> size `txbuf` as TX_QUEUE_DEPTH * <longest frame> so every slot can hold a full frame
+ *  	- Receive runs DMA into a small circular buffer; we only get interrupted on idle line, half-transfer, and full-transfer events
+ *  		\--> frame extraction from that circular buffer lives in `UART_Frame_Extractor` (no HAL dependencies there)
+ *  		\--> this used to be one HAL_UART_Receive_IT() interrupt per byte, which got really expensive at higher baud rates
+ *  		\--> idle line events come in through the UART IRQ, half/full transfer events through the DMA channel IRQ
+ *  			 both end up in `RX_interrupt_handler()`, so the UART and its DMA channels MUST share an NVIC priority (see `UART_Frame_Extractor`)
+ *  	- Complete frames go into a small SPSC `Frame_Queue` carved out of `rxbuf`
+ *  		\--> the ISR is the only producer and `get_packet()` is the only consumer, so no locking necessary
+ *  		\--> size `rxbuf` as RX_QUEUE_DEPTH * <longest frame> so every slot can hold a full frame
  *  	- can technically get a segmentation fault if i pass a buffer that is less than size 2
  *  		- could catch this with a STATIC_ASSERT() or something but I'm making that a future-me problem
  *
@@ -25,6 +35,12 @@
  *
  *	A really cool byproduct of this is that std::arrays can automatically cast to a `std::span` increasing code readability and concise-ness
  *
+ *	RS-485:
+ *		For a half-duplex transceiver, `enable_driver_enable()` hands the transceiver's driver enable (DE) line over to the UART hardware
+ *			\--> the UART asserts DE a little before the first start bit and drops it a little after the last stop bit of every transmission
+ *			\--> no software timing involved, so the bus gets released right away no matter what the ISRs are up to
+ *		The DE pin has to be mapped to the UART's DE alternate function in cubeMX for this to do anything
+ *
  *	TODO maybe: Find a way to connect to the RX FIFO full interrupt and try to detect overruns or any time the FIFO gets FULL
  */
 
@@ -36,6 +52,8 @@
 #include <span> //for c++ style pointer+length data structures
 
 #include "app_hal_int_utils.h" //for ISRs
+#include "app_hal_uart_frame_extractor.h" //to pull frames out of the circular DMA buffer
+#include "app_utils_frame_queue.h" //to hold onto multiple received frames
 #include "app_utils.h" //for callback type
 
 extern "C" {
@@ -45,12 +63,20 @@ extern "C" {
 
 class UART {
 public:
+	//how many received frames can be waiting for `get_packet()` at once; `rxbuf` gets split evenly between these
+	static constexpr size_t RX_QUEUE_DEPTH = 4;
+
+	//how many frames can be waiting to go out on the wire at once; `txbuf` gets split evenly between these
+	static constexpr size_t TX_QUEUE_DEPTH = 4;
+
 	//======================================== HARDWARE MAPPING to PHYSICAL UART ====================================
 
 	struct UART_Hardware_Channel {
 		UART_HandleTypeDef* const huart;
 		const Callback_Function init_func;
 		Instance_Callback_Function<UART> rx_interrupt;
+		Instance_Callback_Function<UART> tx_interrupt;
+		Instance_Callback_Function<UART> error_interrupt;
 	};
 
 	static UART_Hardware_Channel LPUART;
@@ -58,25 +84,77 @@ public:
 
 	//===============================================================================================================
 
+	//optionally pass a decoder to process frames as they stream in; otherwise raw frames are queued up
 	UART(	UART_Hardware_Channel& _hardware, const uint8_t _START_OF_FRAME, const uint8_t _END_OF_FRAME,
-			std::span<uint8_t, std::dynamic_extent> _txbuf, std::span<uint8_t, std::dynamic_extent> _rxbuf);
+			std::span<uint8_t, std::dynamic_extent> _txbuf, std::span<uint8_t, std::dynamic_extent> _rxbuf,
+			UART_Frame_Decoder* const _rx_decoder = nullptr);
 	void init(); //initialize the uart peripheral
 
-	//copies bytes into local transmit buffer
-	//waits until transmitter is free, returns immediately when DMA is dispatched
-	void transmit(const std::span<uint8_t, std::dynamic_extent> bytes_to_tx);
+	//copies bytes into the next free slot of the transmit queue and kicks off DMA if the transmitter is idle
+	//never waits on the wire; returns false if the message doesn't fit in a slot or the queue is full
+	bool transmit(const std::span<uint8_t, std::dynamic_extent> bytes_to_tx);
 
-	//returns 0 if no packet received, otherwise copies packet over to rx_packet and returns length of packet
+	//returns 0 if no packet received, otherwise copies the oldest packet over to rx_packet and returns length of packet
 	size_t get_packet(std::span<uint8_t, std::dynamic_extent> rx_packet);
 
-	bool ready_to_send(); //return true if the transmitter is ready to send data
+	//zero-copy versions of the above
+	//`reserve_transmit()` hands out the next free transmit slot (empty span if the queue is full); fill it, then `commit_transmit()` it
+	//`peek_packet()` hands out the oldest received packet in place (empty span if none); `release_packet()` frees it once done
+	//	\--> the packet memory is owned by the queue, so don't hang onto these spans after committing/releasing
+	std::span<uint8_t, std::dynamic_extent> reserve_transmit();
+	bool commit_transmit(const size_t length);
+	std::span<uint8_t, std::dynamic_extent> peek_packet();
+	void release_packet();
+
+	bool ready_to_send(); //return true if the transmit queue has room for another message
+	size_t tx_slots_free(); //how many more messages the transmit queue can take right now
+	bool tx_idle(); //return true if nothing is queued up or on the wire
 	bool uart_ok(); //return true if there are no error states in the UART
 	bool available(); //return true if we have a packet waiting
 
+	//change the baud rate on the fly
+	//only allowed once the transmitter is idle (so nothing goes out half at one rate, half at another); any partially received frame is lost
+	//returns false if the rate couldn't be applied (the old rate stays in effect)
+	bool set_baud_rate(const uint32_t baud);
+	uint32_t get_baud_rate();
+	bool baud_rate_supported(const uint32_t baud); //can the hardware actually generate this baud rate
+
+	//let the UART drive an RS-485 transceiver's driver enable pin (active high) around every transmission
+	//call after `init()`; sticks through baud rate changes. Returns false if the peripheral couldn't be reconfigured
+	bool enable_driver_enable();
+
+	//receive diagnostics; free-running counts since power up
+	uint32_t get_rx_dropped_count(); //frames lost because the receive queue was full
+	uint32_t get_rx_overflow_count(); //frames lost because they were too long for a queue slot
+	uint32_t get_rx_reject_count(); //frames lost because the decoder rejected them
+
 	//these functions are just called by interrupts; USER SHOULDN'T INTERACT WITH THESE
 	void __attribute__((optimize("O3"))) RX_interrupt_handler();
+	void TX_interrupt_handler();
+	void ERROR_interrupt_handler();
 
 private:
+	//how big the circular buffer the RX DMA writes into is
+	//we'll get an interrupt at least every half of this, so keep it comfortably below a full frame
+	static constexpr size_t RX_DMA_RING_SIZE = 128;
+
+	//legal ranges of the baud rate register (from the reference manual)
+	static constexpr uint32_t BRR_MIN_LPUART = 0x300;
+	static constexpr uint32_t BRR_MAX_LPUART = 0xFFFFF;
+	static constexpr uint32_t BRR_MIN_USART = 0x10;
+	static constexpr uint32_t BRR_MAX_USART = 0xFFFF;
+
+	//how long DE leads the start bit and trails the stop bit
+	//in sample times (1/16th of a bit) on the USARTs, kernel clock cycles on the LPUART; 5 bits wide in either case
+	static constexpr uint32_t DE_ASSERTION_TIME = 16;
+	static constexpr uint32_t DE_DEASSERTION_TIME = 16;
+
+	//(re)start the circular DMA reception
+	void start_receive();
+
+	//fire off DMA for the oldest queued message if nothing is currently on the wire
+	void start_transmit();
+
 	//reference details relevant to the hardware channel (the class owns this, not the instance)
 	UART_Hardware_Channel& hardware;
 
@@ -85,14 +163,21 @@ private:
 	const uint8_t END_OF_FRAME;
 
 	//maintain a memory locations (and other variables) relevant to transmitting and receiving
-	uint8_t received_char; //character we received from the most recent RX interrupt
-	size_t rx_buffer_pointer = 0; //will point to the next free memory location in the buffer
 	std::span<uint8_t, std::dynamic_extent> txbuf; //instantiating with dynamic extent such that we don't need to know size at compile time
-	std::span<uint8_t, std::dynamic_extent> rxbuf; //same as above
+	std::span<uint8_t, std::dynamic_extent> rxbuf; //same as above; backing memory for the receive frame queue
+	std::array<uint8_t, RX_DMA_RING_SIZE> rx_dma_ring; //circular buffer the RX DMA writes into; fixed size so it doesn't need to be passed in
+	std::array<size_t, RX_QUEUE_DEPTH> rx_frame_lengths; //length of the frame sitting in each queue slot
+
+	//complete frames waiting for the main thread
+	Frame_Queue rx_frames;
+
+	//walks the circular buffer and assembles frames into `rx_frames`
+	UART_Frame_Extractor rx_extractor;
 
-	//variables relevant to receiving process
-	volatile bool received_sof_good_packet = false; //we've received a SOF character and waiting for an EOF character
-	volatile bool received_packet_pending = false; //flag to signal that an entire packet has been received and hasn't been serviced
+	//messages waiting to go out, oldest one is the one on the wire
+	std::array<size_t, TX_QUEUE_DEPTH> tx_frame_lengths;
+	Frame_Queue tx_frames;
+	volatile bool tx_in_flight = false; //set when DMA is dispatched, cleared by the TX ISR once the queue runs dry
 };
 
 #endif /* HAL_APP_HAL_UART_H_ */
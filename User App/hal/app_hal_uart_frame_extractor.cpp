@@ -0,0 +1,102 @@
+/*
+ * app_hal_uart_frame_extractor.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#include "app_hal_uart_frame_extractor.h"
+
+UART_Frame_Extractor::UART_Frame_Extractor(	const uint8_t _START_OF_FRAME, const uint8_t _END_OF_FRAME,
+											std::span<uint8_t, std::dynamic_extent> _dma_ring,
+											Frame_Queue& _frames, UART_Frame_Decoder* const _decoder):
+	START_OF_FRAME(_START_OF_FRAME), END_OF_FRAME(_END_OF_FRAME), dma_ring(_dma_ring), frames(_frames), decoder(_decoder)
+{}
+
+void UART_Frame_Extractor::service(size_t dma_write_index) {
+	//DMA reports the full ring size right at the transfer-complete event; that's the same spot as index 0
+	if(dma_write_index >= dma_ring.size()) dma_write_index = 0;
+
+	//walk every byte between where we left off and where the DMA currently is, wrapping around the ring
+	while(read_index != dma_write_index) {
+		consume(dma_ring[read_index]);
+		read_index++;
+		if(read_index >= dma_ring.size()) read_index = 0;
+	}
+}
+
+void UART_Frame_Extractor::reset() {
+	read_index = 0;
+	received_sof_good_packet = false; //anything half-received is garbage now
+}
+
+uint32_t UART_Frame_Extractor::get_dropped_count() { return dropped_count; }
+uint32_t UART_Frame_Extractor::get_overflow_count() { return overflow_count; }
+uint32_t UART_Frame_Extractor::get_reject_count() { return reject_count; }
+
+//==================================== PRIVATE FUNCTIONS ====================================
+
+void UART_Frame_Extractor::consume(const uint8_t received_char) {
+	//check if we've received a start of frame
+	if(received_char == START_OF_FRAME) {
+		//grab the next free slot in the queue to assemble the frame in
+		//if the main thread hasn't caught up and every slot is occupied, we have to throw this frame away
+		frame_buf = frames.write_slot();
+		if(frame_buf.size() < 2) {
+			dropped_count = dropped_count + 1;
+			received_sof_good_packet = false;
+			return;
+		}
+
+		//put the SOF in the first spot in our receive buffer (or let the decoder know it has a new frame)
+		if(decoder != nullptr) decoder->start(frame_buf);
+		else frame_buf[0] = received_char;
+		frame_index = 1; //point to the next free index
+		received_sof_good_packet = true; //start listening to the rest of the message
+	}
+
+	//alternatively, check if we've received an end-of-frame
+	else if(received_char == END_OF_FRAME) {
+		//if we've received a start of frame and we have space to add the character to the buffer
+		//add the character to the buffer and publish the frame to the main thread
+		//the size will be frame_index + 1 since SOF will be at 0 and EOF will be at frame_index
+		//unless the decoder's been looking after the frame--it knows how much of the slot to publish
+		if(received_sof_good_packet) {
+			if(decoder != nullptr) {
+				size_t decoded_length = decoder->finish(frame_index);
+				if(decoded_length) frames.push(decoded_length);
+				else reject_count = reject_count + 1;
+			}
+			else {
+				frame_buf[frame_index] = received_char;
+				frames.push(frame_index + 1);
+			}
+		}
+
+		//wait for a new frame to roll in
+		received_sof_good_packet = false;
+	}
+
+	//in this case, any old character rolls in
+	//only bother writing it if we're actually inside a frame
+	else if(received_sof_good_packet) {
+		//make sure we have space for the character and the EOF after it
+		//if we don't, it means we have a bad packet; prevent it from being dispatched
+		if(frame_index >= frame_buf.size() - 1) {
+			overflow_count = overflow_count + 1;
+			received_sof_good_packet = false;
+		}
+
+		//hand the character to the decoder, and bail on the frame if it says so
+		else if(decoder != nullptr && !decoder->feed(frame_index, received_char)) {
+			reject_count = reject_count + 1;
+			received_sof_good_packet = false;
+		}
+
+		//otherwise write the character to the buffer (if the decoder hasn't already) and increment our buffer pointer
+		else {
+			if(decoder == nullptr) frame_buf[frame_index] = received_char;
+			frame_index++;
+		}
+	}
+}
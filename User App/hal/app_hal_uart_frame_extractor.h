@@ -0,0 +1,109 @@
+/*
+ * app_hal_uart_frame_extractor.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Pulls SOF/EOF delimited frames out of a circular DMA receive buffer
+ *
+ *  The UART DMA writes incoming bytes into a circular buffer without any CPU involvement
+ *  We only get interrupted on an idle line, half-transfer, or full-transfer event
+ *  At that point, the UART hands this class the index the DMA will write to next, and we walk all bytes
+ *  that have arrived since the last event, running the exact same SOF/EOF state machine the per-byte ISR used to run
+ *
+ *  NOTE: this class deliberately has NO dependencies on the STM32 HAL
+ *  	\--> the DMA write pointer is just an index passed in, so the extraction logic can be exercised on a host build
+ *  		 by writing bytes into a plain array and calling `service()` with a fake write pointer
+ *
+ *  NOTE: `service()` is NOT reentrant--it walks `read_index` and the frame being assembled without any locking
+ *  	\--> on the G474 it runs from the UART IRQ (idle line) AND the RX DMA channel IRQ (half/full transfer)
+ *  	\--> so those two IRQs HAVE to sit at the same NVIC preemption priority (they're both at 1, see dma.c/usart.c and the .ioc)
+ *  		 same priority means neither can preempt the other; the second one just waits for the first to return
+ *  	\--> keep this in mind if either priority ever gets touched in cubeMX
+ *
+ *  Frames are assembled directly in the next free slot of a `Frame_Queue` and published on EOF
+ *  	\--> several frames can be waiting for the main thread at once, so back-to-back frames from the host aren't lost
+ *
+ *  Optionally, a `UART_Frame_Decoder` can be attached to process frame contents as they stream in
+ *  	\--> lets a protocol layer decode/validate a frame byte-by-byte so it's ready to go the moment its EOF arrives
+ *  	\--> without one, the raw frame (SOF and EOF inclusive) gets stored in the queue slot
+ *
+ *  Keeping the same framing behavior as the previous per-byte implementation:
+ *  	- a SOF character always (re)starts a frame
+ *  	- an EOF character completes a frame only if we've seen a SOF beforehand
+ *  	- a frame that overflows a queue slot is discarded (and counted as an overflow)
+ *  	- a frame that starts while every queue slot is occupied is discarded (and counted as a drop)
+ *  	- a frame the decoder doesn't like is discarded (and counted as a reject)
+ */
+
+#ifndef HAL_APP_HAL_UART_FRAME_EXTRACTOR_H_
+#define HAL_APP_HAL_UART_FRAME_EXTRACTOR_H_
+
+#include <stddef.h> //for size_t
+#include <stdint.h> //for uint8_t; not pulling in the device header so this can build on a host
+#include <span> //for c++ style pointer+length data structures
+
+#include "app_utils_frame_queue.h" //completed frames get assembled directly into queue slots
+
+//interface to process the contents of a frame as it arrives
+//all of these get called from interrupt context, so keep them quick
+class UART_Frame_Decoder {
+public:
+	//a new frame is starting; its contents should be written into `slot`
+	virtual void start(std::span<uint8_t, std::dynamic_extent> slot) = 0;
+
+	//a byte of the frame has arrived; `index` is its position in the frame (SOF being at 0)
+	//return false if the frame is no good and should be thrown away
+	virtual bool feed(const size_t index, const uint8_t byte) = 0;
+
+	//the EOF has arrived at `index`
+	//return how many bytes of the slot to publish to the queue, or 0 to throw the frame away
+	virtual size_t finish(const size_t index) = 0;
+};
+
+class UART_Frame_Extractor {
+public:
+	UART_Frame_Extractor(	const uint8_t _START_OF_FRAME, const uint8_t _END_OF_FRAME,
+							std::span<uint8_t, std::dynamic_extent> _dma_ring,
+							Frame_Queue& _frames, UART_Frame_Decoder* const _decoder = nullptr);
+
+	//walk through all the bytes the DMA has written into the ring since the last call
+	//NOT reentrant; every context that calls this has to share one interrupt priority (see above)
+	//`dma_write_index` is the index of the next location the DMA will write to (i.e. ring size - remaining transfer count)
+	//a value equal to the ring size is treated as a wrap back to index 0
+	void __attribute__((optimize("O3"))) service(size_t dma_write_index);
+
+	//start reading from the beginning of the ring again; call whenever the DMA is (re)started
+	//drops any partially received frame, but leaves completed frames in the queue alone
+	void reset();
+
+	//diagnostics; free-running counters, so compare against a previous read to see what happened in between
+	uint32_t get_dropped_count(); //frames thrown away because the queue was full
+	uint32_t get_overflow_count(); //frames thrown away because they didn't fit in a queue slot
+	uint32_t get_reject_count(); //frames thrown away by the decoder
+
+private:
+	//run the SOF/EOF state machine on a single byte
+	void __attribute__((optimize("O3"))) consume(const uint8_t received_char);
+
+	//maintain a definition of start-of-frame and end-of-frame characters
+	const uint8_t START_OF_FRAME;
+	const uint8_t END_OF_FRAME;
+
+	//circular buffer the DMA writes into and the queue we assemble frames in
+	std::span<uint8_t, std::dynamic_extent> dma_ring;
+	Frame_Queue& frames;
+	UART_Frame_Decoder* const decoder; //null if we're just storing raw frames
+
+	size_t read_index = 0; //next index in the ring we haven't looked at yet
+	std::span<uint8_t, std::dynamic_extent> frame_buf; //queue slot the current frame is being assembled in
+	size_t frame_index = 0; //will point to the next free memory location in the frame buffer
+
+	//variables relevant to receiving process
+	bool received_sof_good_packet = false; //we've received a SOF character and waiting for an EOF character
+	volatile uint32_t dropped_count = 0;
+	volatile uint32_t overflow_count = 0;
+	volatile uint32_t reject_count = 0;
+};
+
+#endif /* HAL_APP_HAL_UART_FRAME_EXTRACTOR_H_ */
@@ -12,24 +12,19 @@
 //to get request handler types
 #include "app_comms_parser.h"
 #include "app_cmhand_mapping.h" //to get the mapping for different command handlers
+#include "app_comms_typed_handler.h" //handlers here are all generated from the wrapper methods they call
 
 #include "app_power_stage_top_level.h" //to host an array of power stage controls
+#include "app_control_regulator.h" //need this for regulator wrapper
 
 class Controller_Command_Handlers
 {
 public:
 
-	//### NOTE: these are all FUNCTION DEFINITIONS with the appropriate signature of a command handler
-	static Parser::command_handler_sig_t set_controller_rate;
-	static Parser::command_handler_sig_t set_controller_crossover;
-	static Parser::command_handler_sig_t set_controller_gain;
-	static Parser::command_handler_sig_t set_load_resistance;
-	static Parser::command_handler_sig_t set_load_natural_freq;
-	//###
-
 	//return some kinda stl-compatible container
 	//that contains all the request or command handlers defined in this class
-	static std::span<const Parser::command_mapping_t, std::dynamic_extent> command_handlers();
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::command_mapping_t, std::dynamic_extent> command_handlers() { return COMMAND_HANDLERS; }
 
 	//pass stl container of instantiated power stage systems
 	static void attach_power_stage_systems(std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages);
@@ -41,12 +36,22 @@ public:
 private:
 	static std::span<Power_Stage_Subsystem*, std::dynamic_extent> stages; //have a container that holds a handful of power stages
 
+	//regulator on channel `channel`, or nullptr if we don't have that channel
+	static Regulator_Wrapper* regulator(const size_t channel);
+
+	/*
+	 * CONTROL_SET_FREQUENCY:	[1:4] controller update rate (and ADC sampling frequency) for ALL channels, Hz
+	 * CONTROL_SET_DC_GAIN:		[1] channel, [2:5] controller DC gain
+	 * CONTROL_SET_CROSSOVER:	[1] channel, [2:5] controller crossover frequency, Hz
+	 * LOAD_SET_DC_RESISTANCE:	[1] channel, [2:5] load resistance, ohms
+	 * LOAD_SET_NATURAL_FREQ:	[1] channel, [2:5] load natural frequency (r/2*pi*l), Hz
+	 */
 	static constexpr std::array<Parser::command_mapping_t, 5> COMMAND_HANDLERS = {
-			std::make_pair(CM_Mapping::CONTROL_SET_FREQUENCY, set_controller_rate),
-			std::make_pair(CM_Mapping::CONTROL_SET_DC_GAIN, set_controller_crossover),
-			std::make_pair(CM_Mapping::CONTROL_SET_CROSSOVER, set_controller_gain),
-			std::make_pair(CM_Mapping::LOAD_SET_DC_RESISTANCE, set_load_resistance),
-			std::make_pair(CM_Mapping::LOAD_SET_NATURAL_FREQ, set_load_natural_freq),
+			Typed_Handler::command<CM_Mapping::CONTROL_SET_FREQUENCY, Power_Stage_Subsystem::set_controller_frequency>(),
+			Typed_Handler::channel_command<CM_Mapping::CONTROL_SET_DC_GAIN, regulator, &Regulator_Wrapper::update_gain>(),
+			Typed_Handler::channel_command<CM_Mapping::CONTROL_SET_CROSSOVER, regulator, &Regulator_Wrapper::update_crossover_freq>(),
+			Typed_Handler::channel_command<CM_Mapping::LOAD_SET_DC_RESISTANCE, regulator, &Regulator_Wrapper::update_load_resistance>(),
+			Typed_Handler::channel_command<CM_Mapping::LOAD_SET_NATURAL_FREQ, regulator, &Regulator_Wrapper::update_load_natural_freq>(),
 	};
 };
 
@@ -0,0 +1,28 @@
+/*
+ * app_cmhand_estop.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+
+
+#include "app_cmhand_estop.h"
+
+
+//================================================= STATIC MEMBER INITIALIZATION =================================================
+
+//initialze as empty at the start; expect to populate this before any commands get processed
+Comms_Emergency_Stop* Estop_Command_Handlers::estop = nullptr;
+
+//======================================================== GETTER AND SETTER METHODS/UTILITIES ===================================================
+
+//pass the emergency stop
+void Estop_Command_Handlers::attach_estop(Comms_Emergency_Stop* _estop) {
+	estop = _estop;
+}
+
+bool Estop_Command_Handlers::stop() {
+	if(estop == nullptr) return false;
+	return estop->stop();
+}
@@ -0,0 +1,55 @@
+/*
+ * app_cmhand_estop.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Command handler for the emergency stop (see `Comms_Emergency_Stop`)
+ *  By the time this runs, the receive ISR has usually already stopped everything; this is the regular path for stops that
+ *  came in a way the ISR doesn't pick out (i.e. inside a batch), and what sends the ACK
+ */
+
+#ifndef HANDLERS___COMMAND_APP_CMHAND_ESTOP_H_
+#define HANDLERS___COMMAND_APP_CMHAND_ESTOP_H_
+
+#include <utility> //for make pair
+
+//to get request handler types
+#include "app_comms_parser.h"
+#include "app_cmhand_mapping.h" //to get the mapping for different command handlers
+#include "app_comms_typed_handler.h" //handler is generated from the function it calls
+
+#include "app_comms_estop.h" //does the actual stopping
+
+class Estop_Command_Handlers
+{
+public:
+	//return some kinda stl-compatible container
+	//that contains all the request or command handlers defined in this class
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::command_mapping_t, std::dynamic_extent> command_handlers() { return COMMAND_HANDLERS; }
+
+	//pass the emergency stop instance
+	static void attach_estop(Comms_Emergency_Stop* _estop);
+
+	//disable every stage
+	static bool stop();
+
+	//delete any constructors
+	Estop_Command_Handlers() = delete;
+	Estop_Command_Handlers(Estop_Command_Handlers const&) = delete;
+
+private:
+	static Comms_Emergency_Stop* estop;
+
+	/*
+	 * STAGE_EMERGENCY_STOP:	no args; disable every stage on the device
+	 */
+	static constexpr std::array<Parser::command_mapping_t, 1> COMMAND_HANDLERS = {
+			Typed_Handler::command<CM_Mapping::STAGE_EMERGENCY_STOP, stop>(),
+	};
+};
+
+
+
+#endif /* HANDLERS___COMMAND_APP_CMHAND_ESTOP_H_ */
@@ -0,0 +1,60 @@
+/*
+ * app_cmhand_link.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+
+
+#include "app_cmhand_link.h"
+
+#include "app_utils.h" //for unpacking functions
+
+
+//================================================= STATIC MEMBER INITIALIZATION =================================================
+
+//initialze as empty at the start; expect to populate this before any commands get processed
+Comms_Baud_Negotiator* Link_Command_Handlers::negotiator = nullptr;
+
+//======================================================== GETTER AND SETTER METHODS/UTILITIES ===================================================
+
+//pass the baud rate negotiator
+void Link_Command_Handlers::attach_baud_negotiator(Comms_Baud_Negotiator* _negotiator) {
+	negotiator = _negotiator;
+}
+
+//======================================================== THE ACTUAL COMMAND HANDLERS ===================================================
+
+/*
+ * switch the link this command came in on over to baud rate `rx_payload[1:4]`
+ * the ACK goes out at the current rate, and the switch happens right after
+ * host has FALLBACK_TIMEOUT_MS to send a valid frame at the new rate, otherwise we go back to the old one
+ */
+std::pair<Parser::MessageType_t, size_t> Link_Command_Handlers::set_baud_rate(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																				std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	//sanity check the received command
+	uint8_t tx_len;
+	if(!CM_Mapping::VALIDATE_COMMAND(tx_payload, rx_payload, 1, 5, CM_Mapping::LINK_SET_BAUD_RATE, tx_len))
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
+
+	//grab the baud rate we want to switch to
+	uint32_t baud = unpack_uint32(rx_payload.subspan(1, 4));
+
+	//make sure we actually have a negotiator to talk to
+	if(negotiator == nullptr) {
+		tx_payload[0] = Parser::NACK_ERROR_INTERNAL_FW;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	//schedule the switch; fails if the UART can't do that rate, or it'd put our multi-drop reply slot too far out
+	if(!negotiator->request(baud)) {
+		tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	//respond with an ACK if the switch was scheduled
+	tx_payload[0] = CM_Mapping::LINK_SET_BAUD_RATE;
+	return std::make_pair(Parser::DEVICE_ACK_HOST_MESSAGE, 1); //and return an ack message along with the single-byte payload
+}
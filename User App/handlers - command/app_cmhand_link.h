@@ -0,0 +1,50 @@
+/*
+ * app_cmhand_link.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#ifndef HANDLERS___COMMAND_APP_CMHAND_LINK_H_
+#define HANDLERS___COMMAND_APP_CMHAND_LINK_H_
+
+#include <utility> //for make pair
+
+//to get request handler types
+#include "app_comms_parser.h"
+#include "app_cmhand_mapping.h" //to get the mapping for different command handlers
+
+#include "app_comms_baud.h" //to negotiate baud rate changes
+
+class Link_Command_Handlers
+{
+public:
+
+	//### NOTE: these are all FUNCTION DEFINITIONS with the appropriate signature of a command handler
+	static Parser::command_handler_sig_t set_baud_rate;
+	//###
+
+	//return some kinda stl-compatible container
+	//that contains all the request or command handlers defined in this class
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::command_mapping_t, std::dynamic_extent> command_handlers() { return COMMAND_HANDLERS; }
+
+	//pass the baud rate negotiator owned by the comms subsystem
+	//each comms link attaches its own right before parsing a request, so this always points at the link the command came in on
+	static void attach_baud_negotiator(Comms_Baud_Negotiator* _negotiator);
+
+	//delete any constructors
+	Link_Command_Handlers() = delete;
+	Link_Command_Handlers(Link_Command_Handlers const&) = delete;
+
+private:
+	static Comms_Baud_Negotiator* negotiator;
+
+	static constexpr std::array<Parser::command_mapping_t, 1> COMMAND_HANDLERS = {
+			std::make_pair(CM_Mapping::LINK_SET_BAUD_RATE, set_baud_rate),
+	};
+};
+
+
+
+#endif /* HANDLERS___COMMAND_APP_CMHAND_LINK_H_ */
@@ -8,12 +8,11 @@
 #ifndef HANDLERS___COMMAND_APP_CMHAND_MAPPING_H_
 #define HANDLERS___COMMAND_APP_CMHAND_MAPPING_H_
 
-extern "C" {
-	#include "stm32g474xx.h" //for uint8_t
-}
+#include <stdint.h> //for uint8_t; no device headers here so the streaming decoder builds for the host too
 
 //dropping in its own namespace in order to not pollute global namespace
-//very annoying that there isn't an easy way to check that no enum values overlap
+//nothing stops two enum values from overlapping here, BUT the dispatch tables are generated at compile time
+//so two handlers mapped to the same code won't compile (see `Parser::make_dispatch_table()`)
 class CM_Mapping {
 public:
 	enum Map_Code : uint8_t {
@@ -23,6 +22,9 @@ public:
 		TEST_FLOAT 		= (uint8_t)0x03,
 		TEST_STRING 	= (uint8_t)0x04,
 
+		//communication link configuration
+		LINK_SET_BAUD_RATE		= (uint8_t)0x08,
+
 		//fundamental stage-related commands
 		STAGE_DISABLE			= (uint8_t)0x10,
 		STAGE_SET_FSW			= (uint8_t)0x11,
@@ -33,6 +35,9 @@ public:
 		STAGE_MANUAL_SET_DRIVE	= (uint8_t)0x17,
 		STAGE_MANUAL_SET_DUTIES	= (uint8_t)0x18,
 
+		//disables every stage straight from the receive ISR (see `Comms_Emergency_Stop`)
+		STAGE_EMERGENCY_STOP	= (uint8_t)0x1F,
+
 		//control related functionality
 		STAGE_ENABLE_REGULATOR 	= (uint8_t)0x20,
 		CONTROL_SET_FREQUENCY	= (uint8_t)0x21,
@@ -50,6 +55,10 @@ public:
 		SAMPLER_TRIM_COARSE 	= (uint8_t)0x42,
 		SAMPLER_SET_FINE_LIMITS	= (uint8_t)0x43,
 
+		//commands scheduled to run at a particular time (i.e. lined up across devices)
+		SYNC_SCHEDULE			= (uint8_t)0x50,
+		SYNC_CANCEL				= (uint8_t)0x51,
+
 		//setpoint control functions
 		//TODO: SETPOINT TICK FREQUENCY, SETPOINT BANDWIDTH
 		SETPOINT_SOFT_TRIGGER	= (uint8_t)0x60,
@@ -57,6 +66,17 @@ public:
 		SETPOINT_RESET			= (uint8_t)0x62,
 		SETPOINT_DRIVE_DC		= (uint8_t)0x63,
 
+		//telemetry streaming
+		TELEMETRY_START			= (uint8_t)0x70,
+		TELEMETRY_STOP			= (uint8_t)0x71,
+		TRACE_START				= (uint8_t)0x72,
+		TRACE_STOP				= (uint8_t)0x73,
+
+		//parameter map (see `Param_Map`)
+		PARAM_SET				= (uint8_t)0x80,
+		PARAM_SUBSCRIBE			= (uint8_t)0x81,
+		PARAM_UNSUBSCRIBE		= (uint8_t)0x82,
+
 	};
 
 	//utility function to validate formatting for request handlers
@@ -0,0 +1,159 @@
+/*
+ * app_cmhand_params.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+
+
+#include "app_cmhand_params.h"
+
+#include "app_utils.h" //for unpacking functions
+
+
+//================================================= STATIC MEMBER INITIALIZATION =================================================
+
+//initialze as empty at the start; expect to populate this before any commands get processed
+Param_Map* Param_Command_Handlers::params = nullptr;
+Comms_Param_Notifier* Param_Command_Handlers::notifier = nullptr;
+
+//======================================================== GETTER AND SETTER METHODS/UTILITIES ===================================================
+
+//pass the parameter map
+void Param_Command_Handlers::attach_param_map(Param_Map* _params) {
+	params = _params;
+}
+
+//pass the parameter change notifier
+void Param_Command_Handlers::attach_param_notifier(Comms_Param_Notifier* _notifier) {
+	notifier = _notifier;
+}
+
+//======================================================== THE ACTUAL COMMAND HANDLERS ===================================================
+
+/*
+ * write `rx_payload[3]` parameters, starting at ID `rx_payload[1:2]`
+ * rx_payload[4:] = a 4-byte value for each parameter, packed according to its type (see `Param_Map::Param_Type_t`)
+ * all-or-nothing: nothing gets written unless every value checks out, and anything already written gets put back if one gets refused
+ * NACKs with:
+ * 		COMMAND_OUT_OF_RANGE if an ID isn't mapped, is read-only, or a value is out of bounds
+ * 		COMMAND_EXEC_FAILED if a subsystem refused a value (i.e. changing control parameters while the regulator is running)
+ */
+std::pair<Parser::MessageType_t, size_t> Param_Command_Handlers::set_params(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																				std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	//sanity check the received command; have to peek at the count to know how long it should be
+	uint8_t tx_len;
+	size_t count = (rx_payload.size() >= RANGE_HEADER_LENGTH) ? rx_payload[3] : 0;
+	if(!CM_Mapping::VALIDATE_COMMAND(tx_payload, rx_payload, 1, RANGE_HEADER_LENGTH + count * 4, CM_Mapping::PARAM_SET, tx_len))
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
+
+	//make sure we actually have a parameter map to talk to, and that the range isn't too big for it
+	if(params == nullptr) {
+		tx_payload[0] = Parser::NACK_ERROR_INTERNAL_FW;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+	if(count == 0 || count > Param_Map::MAX_RANGE_COUNT) {
+		tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	//unpack all the values, then write them in one go
+	uint16_t first = (uint16_t)((rx_payload[1] << 8) | rx_payload[2]);
+	std::array<uint32_t, Param_Map::MAX_RANGE_COUNT> values;
+	for(size_t i = 0; i < count; i++)
+		values[i] = unpack_uint32(rx_payload.subspan(RANGE_HEADER_LENGTH + i * 4, 4));
+
+	switch(params->set_range(first, std::span<const uint32_t, std::dynamic_extent>(values.data(), count))) {
+		case Param_Map::PARAM_OK:
+			break;
+		case Param_Map::PARAM_APPLY_FAILED:
+			tx_payload[0] = Parser::NACK_ERROR_COMMAND_EXEC_FAILED;
+			return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+		default:
+			tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
+			return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	//respond with an ACK if everything got written
+	tx_payload[0] = CM_Mapping::PARAM_SET;
+	return std::make_pair(Parser::DEVICE_ACK_HOST_MESSAGE, 1); //and return an ack message along with the single-byte payload
+}
+
+/*
+ * subscribe to changes in `rx_payload[1]` parameters
+ * rx_payload[2:] = a 2-byte ID for each parameter
+ * the bulk link sends a DEVICE_PARAM_CHANGE frame with the current value of each one right away, and again whenever it changes
+ * all-or-nothing: nothing gets subscribed unless every ID is mapped and there's room for all of them
+ * NACKs with:
+ * 		COMMAND_OUT_OF_RANGE if an ID isn't mapped, or the subscription table would overflow
+ */
+std::pair<Parser::MessageType_t, size_t> Param_Command_Handlers::subscribe_params(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																					std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	std::array<uint16_t, Comms_Param_Notifier::SUBSCRIPTION_COUNT> ids;
+	size_t count;
+	std::pair<Parser::MessageType_t, size_t> nack_response;
+	if(!unpack_ids(rx_payload, tx_payload, CM_Mapping::PARAM_SUBSCRIBE, ids, count, nack_response)) return nack_response;
+
+	//have to subscribe to something
+	if(count == 0 || notifier->subscribe(std::span<const uint16_t, std::dynamic_extent>(ids.data(), count)) != Param_Map::PARAM_OK) {
+		tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	//respond with an ACK if everything got subscribed
+	tx_payload[0] = CM_Mapping::PARAM_SUBSCRIBE;
+	return std::make_pair(Parser::DEVICE_ACK_HOST_MESSAGE, 1);
+}
+
+/*
+ * stop sending changes to `rx_payload[1]` parameters; a count of 0 drops every subscription
+ * rx_payload[2:] = a 2-byte ID for each parameter; anything we weren't subscribed to is just ignored
+ */
+std::pair<Parser::MessageType_t, size_t> Param_Command_Handlers::unsubscribe_params(const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																					std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	std::array<uint16_t, Comms_Param_Notifier::SUBSCRIPTION_COUNT> ids;
+	size_t count;
+	std::pair<Parser::MessageType_t, size_t> nack_response;
+	if(!unpack_ids(rx_payload, tx_payload, CM_Mapping::PARAM_UNSUBSCRIBE, ids, count, nack_response)) return nack_response;
+
+	if(count == 0) notifier->unsubscribe_all();
+	else notifier->unsubscribe(std::span<const uint16_t, std::dynamic_extent>(ids.data(), count));
+
+	tx_payload[0] = CM_Mapping::PARAM_UNSUBSCRIBE;
+	return std::make_pair(Parser::DEVICE_ACK_HOST_MESSAGE, 1);
+}
+
+//======================================================== PRIVATE UTILITIES ===================================================
+
+bool Param_Command_Handlers::unpack_ids(	const std::span<uint8_t, std::dynamic_extent> rx_payload, std::span<uint8_t, std::dynamic_extent> tx_payload,
+											const CM_Mapping::Map_Code code, std::span<uint16_t, Comms_Param_Notifier::SUBSCRIPTION_COUNT> ids,
+											size_t& count, std::pair<Parser::MessageType_t, size_t>& nack_response)
+{
+	//sanity check the received command; have to peek at the count to know how long it should be
+	uint8_t tx_len;
+	count = (rx_payload.size() >= LIST_HEADER_LENGTH) ? rx_payload[1] : 0;
+	if(!CM_Mapping::VALIDATE_COMMAND(tx_payload, rx_payload, 1, LIST_HEADER_LENGTH + count * 2, code, tx_len)) {
+		nack_response = std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
+		return false;
+	}
+
+	//make sure we actually have a notifier to talk to, and that the list isn't longer than it could ever hold
+	if(notifier == nullptr) {
+		tx_payload[0] = Parser::NACK_ERROR_INTERNAL_FW;
+		nack_response = std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+		return false;
+	}
+	if(count > ids.size()) {
+		tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
+		nack_response = std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+		return false;
+	}
+
+	for(size_t i = 0; i < count; i++)
+		ids[i] = (uint16_t)((rx_payload[LIST_HEADER_LENGTH + i * 2] << 8) | rx_payload[LIST_HEADER_LENGTH + i * 2 + 1]);
+	return true;
+}
@@ -0,0 +1,70 @@
+/*
+ * app_cmhand_params.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Command handlers to write ranges of parameters through the parameter map
+ *  ...and to subscribe to changes in them (see `Comms_Param_Notifier`)
+ */
+
+#ifndef HANDLERS___COMMAND_APP_CMHAND_PARAMS_H_
+#define HANDLERS___COMMAND_APP_CMHAND_PARAMS_H_
+
+#include <utility> //for make pair
+
+//to get request handler types
+#include "app_comms_parser.h"
+#include "app_cmhand_mapping.h" //to get the mapping for different command handlers
+
+#include "app_config_param_map.h" //the parameters we're writing
+#include "app_comms_param_notify.h" //for subscribing to parameter changes
+
+class Param_Command_Handlers
+{
+public:
+
+	//### NOTE: these are all FUNCTION DEFINITIONS with the appropriate signature of a command handler
+	static Parser::command_handler_sig_t set_params;
+	static Parser::command_handler_sig_t subscribe_params;
+	static Parser::command_handler_sig_t unsubscribe_params;
+	//###
+
+	//return some kinda stl-compatible container
+	//that contains all the request or command handlers defined in this class
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::command_mapping_t, std::dynamic_extent> command_handlers() { return COMMAND_HANDLERS; }
+
+	//pass the parameter map instance
+	static void attach_param_map(Param_Map* _params);
+	static void attach_param_notifier(Comms_Param_Notifier* _notifier);
+
+	//delete any constructors
+	Param_Command_Handlers() = delete;
+	Param_Command_Handlers(Param_Command_Handlers const&) = delete;
+
+private:
+	static Param_Map* params;
+	static Comms_Param_Notifier* notifier;
+
+	//[PARAM_SET][first ID (2)][count]
+	static constexpr size_t RANGE_HEADER_LENGTH = 4;
+
+	//[PARAM_(UN)SUBSCRIBE][count]
+	static constexpr size_t LIST_HEADER_LENGTH = 2;
+
+	//validate a list of IDs and unpack them; returns false (with the NACK all set up) if it's no good
+	static bool unpack_ids(	const std::span<uint8_t, std::dynamic_extent> rx_payload, std::span<uint8_t, std::dynamic_extent> tx_payload,
+							const CM_Mapping::Map_Code code, std::span<uint16_t, Comms_Param_Notifier::SUBSCRIPTION_COUNT> ids,
+							size_t& count, std::pair<Parser::MessageType_t, size_t>& nack_response);
+
+	static constexpr std::array<Parser::command_mapping_t, 3> COMMAND_HANDLERS = {
+			std::make_pair(CM_Mapping::PARAM_SET, set_params),
+			std::make_pair(CM_Mapping::PARAM_SUBSCRIBE, subscribe_params),
+			std::make_pair(CM_Mapping::PARAM_UNSUBSCRIBE, unsubscribe_params),
+	};
+};
+
+
+
+#endif /* HANDLERS___COMMAND_APP_CMHAND_PARAMS_H_ */
@@ -17,12 +17,6 @@ std::span<Power_Stage_Subsystem*, std::dynamic_extent> Power_Stage_Command_Handl
 
 //======================================================== GETTER AND SETTER METHODS/UTILITIES ===================================================
 
-//return some kinda stl-compatible container
-//that contains all the request or command handlers defined in this class
-std::span<const Parser::command_mapping_t, std::dynamic_extent> Power_Stage_Command_Handlers::command_handlers() {
-	return Power_Stage_Command_Handlers::COMMAND_HANDLERS;
-}
-
 //pass stl container of instantiated power stage systems
 void Power_Stage_Command_Handlers::attach_power_stage_systems(std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages) {
 	//just copy over the span passed into the member variable
@@ -323,34 +317,3 @@ std::pair<Parser::MessageType_t, size_t> Power_Stage_Command_Handlers::stage_man
 	tx_payload[0] = CM_Mapping::STAGE_MANUAL_SET_DUTIES;
 	return std::make_pair(Parser::DEVICE_ACK_HOST_MESSAGE, 1); //and return an ack message along with the single-byte payload
 }
-
-//========================= SET SWITCHING FREQUENCY FOR ALL CHANNELS =========================
-
-/*
- * set the switching frequency (in Hz) to `rx_packet[1:4]`
- */
-std::pair<Parser::MessageType_t, size_t> Power_Stage_Command_Handlers::stage_set_fsw(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
-																						std::span<uint8_t, std::dynamic_extent> tx_payload)
-{
-	//sanity check the received command
-	uint8_t tx_len;
-	if(!CM_Mapping::VALIDATE_COMMAND(tx_payload, rx_payload, 1, 5, CM_Mapping::STAGE_SET_FSW, tx_len))
-		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
-
-	//grab the float that was sent over starting at index 1
-	float fsw_hz = unpack_float(rx_payload.subspan(1, 4));
-
-	//now try to set switching frequency
-	//execution can fail if switching frequency out of range OR power stage not disabled
-	//it's gonna be more effort than its worth to differentiate between the two, so return a more generic error
-	if(!Power_Stage_Subsystem::set_switching_frequency(fsw_hz)) { //if execution of this fails
-		tx_payload[0] = Parser::NACK_ERROR_COMMAND_EXEC_FAILED;
-		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
-	}
-
-	//execution succeeds
-	//respond with ACK, payload contains the particular command ID as the payload
-	tx_payload[0] = CM_Mapping::STAGE_SET_FSW;
-	return std::make_pair(Parser::DEVICE_ACK_HOST_MESSAGE, 1); //and return an ack message along with the single-byte payload
-}
-
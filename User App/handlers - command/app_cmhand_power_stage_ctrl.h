@@ -12,6 +12,7 @@
 //to get request handler types
 #include "app_comms_parser.h"
 #include "app_cmhand_mapping.h" //to get the mapping for different command handlers
+#include "app_comms_typed_handler.h" //for the handlers that are just a straight function call
 
 #include <string> //need this for the test string
 #include <array> //to hold an stl array
@@ -34,12 +35,12 @@ public:
 	static Parser::command_handler_sig_t stage_manual_off;
 	static Parser::command_handler_sig_t stage_manual_drive;
 	static Parser::command_handler_sig_t stage_manual_duties;
-	static Parser::command_handler_sig_t stage_set_fsw; //a little different than the others; can only be set when stage disabled
 	//###
 
 	//return some kinda stl-compatible container
 	//that contains all the request or command handlers defined in this class
-	static std::span<const Parser::command_mapping_t, std::dynamic_extent> command_handlers();
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::command_mapping_t, std::dynamic_extent> command_handlers() { return COMMAND_HANDLERS; }
 
 	//pass stl container of instantiated power stage systems
 	static void attach_power_stage_systems(std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages);
@@ -61,7 +62,9 @@ private:
 			std::make_pair(CM_Mapping::STAGE_MANUAL_DRIVE_OFF, stage_manual_off),
 			std::make_pair(CM_Mapping::STAGE_MANUAL_SET_DRIVE, stage_manual_drive),
 			std::make_pair(CM_Mapping::STAGE_MANUAL_SET_DUTIES, stage_manual_duties),
-			std::make_pair(CM_Mapping::STAGE_SET_FSW, stage_set_fsw),
+
+			//switching frequency (Hz) in [1:4]; a little different than the others, applies to all channels and can only be set when stages are disabled
+			Typed_Handler::command<CM_Mapping::STAGE_SET_FSW, Power_Stage_Subsystem::set_switching_frequency>(),
 	};
 };
 
@@ -13,22 +13,19 @@
 //to get request handler types
 #include "app_comms_parser.h"
 #include "app_cmhand_mapping.h" //to get the mapping for different command handlers
+#include "app_comms_typed_handler.h" //handlers here are all generated from the wrapper methods they call
 
 #include "app_power_stage_top_level.h" //to host an array of power stage controls
+#include "app_power_stage_sampler.h" //for sampler wrapper
 
 class Sampler_Command_Handlers
 {
 public:
 
-	//### NOTE: these are all FUNCTION DEFINITIONS with the appropriate signature of a command handler
-	static Parser::command_handler_sig_t trim_fine;
-	static Parser::command_handler_sig_t trim_coarse;
-	static Parser::command_handler_sig_t set_fine_limits;
-	//###
-
 	//return some kinda stl-compatible container
 	//that contains all the request or command handlers defined in this class
-	static std::span<const Parser::command_mapping_t, std::dynamic_extent> command_handlers();
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::command_mapping_t, std::dynamic_extent> command_handlers() { return COMMAND_HANDLERS; }
 
 	//pass stl container of instantiated power stage systems
 	static void attach_power_stage_systems(std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages);
@@ -40,10 +37,18 @@ public:
 private:
 	static std::span<Power_Stage_Subsystem*, std::dynamic_extent> stages; //have a container that holds a handful of power stages
 
+	//sampler on channel `channel`, or nullptr if we don't have that channel
+	static Sampler_Wrapper* sampler(const size_t channel);
+
+	/*
+	 * SAMPLER_TRIM_FINE:		[1] channel, [2:5] gain trim, [6:9] offset trim
+	 * SAMPLER_TRIM_COARSE:		[1] channel, [2:5] gain trim, [6:9] offset trim
+	 * SAMPLER_SET_FINE_LIMITS:	[1] channel, [2:5] minimum code, [6:9] maximum code
+	 */
 	static constexpr std::array<Parser::command_mapping_t, 3> COMMAND_HANDLERS = {
-			std::make_pair(CM_Mapping::SAMPLER_TRIM_FINE, trim_fine),
-			std::make_pair(CM_Mapping::SAMPLER_TRIM_COARSE, trim_coarse),
-			std::make_pair(CM_Mapping::SAMPLER_SET_FINE_LIMITS, set_fine_limits),
+			Typed_Handler::channel_command<CM_Mapping::SAMPLER_TRIM_FINE, sampler, &Sampler_Wrapper::trim_fine>(),
+			Typed_Handler::channel_command<CM_Mapping::SAMPLER_TRIM_COARSE, sampler, &Sampler_Wrapper::trim_coarse>(),
+			Typed_Handler::channel_command<CM_Mapping::SAMPLER_SET_FINE_LIMITS, sampler, &Sampler_Wrapper::set_limits_fine>(),
 	};
 };
 
@@ -17,12 +17,6 @@ std::span<Power_Stage_Subsystem*, std::dynamic_extent> Setpoint_Command_Handlers
 
 //======================================================== GETTER AND SETTER METHODS/UTILITIES ===================================================
 
-//return some kinda stl-compatible container
-//that contains all the request or command handlers defined in this class
-std::span<const Parser::command_mapping_t, std::dynamic_extent> Setpoint_Command_Handlers::command_handlers() {
-	return Setpoint_Command_Handlers::COMMAND_HANDLERS;
-}
-
 //pass stl container of instantiated power stage systems
 void Setpoint_Command_Handlers::attach_power_stage_systems(std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages) {
 	//just copy over the span passed into the member variable
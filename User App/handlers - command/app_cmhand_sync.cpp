@@ -0,0 +1,84 @@
+/*
+ * app_cmhand_sync.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+
+
+#include "app_cmhand_sync.h"
+
+#include <algorithm> //for max
+
+#include "app_utils.h" //for unpacking functions
+
+
+//================================================= STATIC MEMBER INITIALIZATION =================================================
+
+//initialze as empty at the start; expect to populate this before any commands get processed
+Comms_Sync_Scheduler* Sync_Command_Handlers::scheduler = nullptr;
+uint32_t Sync_Command_Handlers::arrival_cycles = 0;
+
+//======================================================== GETTER AND SETTER METHODS/UTILITIES ===================================================
+
+//pass the scheduler
+void Sync_Command_Handlers::attach_scheduler(Comms_Sync_Scheduler* _scheduler) {
+	scheduler = _scheduler;
+}
+
+void Sync_Command_Handlers::set_frame_arrival(const uint32_t _arrival_cycles) {
+	arrival_cycles = _arrival_cycles;
+}
+
+bool Sync_Command_Handlers::cancel_all() {
+	if(scheduler == nullptr) return false;
+	scheduler->cancel();
+	return true;
+}
+
+//======================================================== THE ACTUAL COMMAND HANDLERS ===================================================
+
+/*
+ * run the command in `rx_payload[5:]` (code + args, exactly as it'd be sent on its own) `rx_payload[1:4]` microseconds after this frame landed
+ * the ACK just means the command was accepted and is pending--its own ACK/NACK never goes out (see SYNC_GET_STATUS/the trace log for that)
+ * NACKs with:
+ * 		UNKNOWN_COMMAND_CODE if nothing's mapped to the inner command
+ * 		COMMAND_OUT_OF_RANGE if the delay or inner command is too long, or the inner command can't be scheduled
+ * 		SYSTEM_BUSY if every slot already has a command pending
+ */
+std::pair<Parser::MessageType_t, size_t> Sync_Command_Handlers::schedule(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																			std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	//sanity check the received command; inner command can be any length, so just make sure there's one there at all
+	uint8_t tx_len;
+	if(!CM_Mapping::VALIDATE_COMMAND(	tx_payload, rx_payload, 1, std::max(rx_payload.size(), SCHEDULE_HEADER_LENGTH + 1),
+										CM_Mapping::SYNC_SCHEDULE, tx_len))
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
+
+	//make sure we actually have a scheduler to talk to
+	if(scheduler == nullptr) {
+		tx_payload[0] = Parser::NACK_ERROR_INTERNAL_FW;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	//grab the delay, and hand the scheduler the command along with when this frame landed
+	uint32_t delay_us = unpack_uint32(rx_payload.subspan(1, 4));
+	switch(scheduler->schedule(rx_payload.subspan(SCHEDULE_HEADER_LENGTH), arrival_cycles, delay_us)) {
+		case Comms_Sync_Scheduler::SCHEDULED:
+			break;
+		case Comms_Sync_Scheduler::UNKNOWN_COMMAND:
+			tx_payload[0] = Parser::NACK_ERROR_UNKNOWN_COMMAND_CODE;
+			return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+		case Comms_Sync_Scheduler::BUSY:
+			tx_payload[0] = Parser::NACK_ERROR_SYSTEM_BUSY;
+			return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+		default:
+			tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
+			return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	//respond with an ACK if the command is pending
+	tx_payload[0] = CM_Mapping::SYNC_SCHEDULE;
+	return std::make_pair(Parser::DEVICE_ACK_HOST_MESSAGE, 1); //and return an ack message along with the single-byte payload
+}
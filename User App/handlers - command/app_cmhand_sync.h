@@ -0,0 +1,68 @@
+/*
+ * app_cmhand_sync.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Command handlers to line up commands to run at a particular time (see `Comms_Sync_Scheduler`)
+ *  Meant to be broadcast (HOST_COMMAND_ALL_DEVICES), so every device on the bus applies the command in the same control cycle
+ */
+
+#ifndef HANDLERS___COMMAND_APP_CMHAND_SYNC_H_
+#define HANDLERS___COMMAND_APP_CMHAND_SYNC_H_
+
+#include <utility> //for make pair
+
+//to get request handler types
+#include "app_comms_parser.h"
+#include "app_cmhand_mapping.h" //to get the mapping for different command handlers
+#include "app_comms_typed_handler.h" //cancel handler is generated from the function it calls
+
+#include "app_comms_sync.h" //the scheduler holding the commands
+
+class Sync_Command_Handlers
+{
+public:
+
+	//### NOTE: these are all FUNCTION DEFINITIONS with the appropriate signature of a command handler
+	static Parser::command_handler_sig_t schedule;
+	//###
+
+	//return some kinda stl-compatible container
+	//that contains all the request or command handlers defined in this class
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::command_mapping_t, std::dynamic_extent> command_handlers() { return COMMAND_HANDLERS; }
+
+	//pass the scheduler instance
+	static void attach_scheduler(Comms_Sync_Scheduler* _scheduler);
+
+	//when the frame about to be parsed landed (in cycle counter ticks); the comms links set this right before parsing each request
+	//delays count from here, so how long the frame waited on the main loop doesn't matter
+	static void set_frame_arrival(const uint32_t _arrival_cycles);
+
+	//drop every scheduled command that hasn't run yet
+	static bool cancel_all();
+
+	//delete any constructors
+	Sync_Command_Handlers() = delete;
+	Sync_Command_Handlers(Sync_Command_Handlers const&) = delete;
+
+private:
+	static Comms_Sync_Scheduler* scheduler;
+	static uint32_t arrival_cycles;
+
+	//[SYNC_SCHEDULE][DELAY_US (4)][command code][command args...]
+	static constexpr size_t SCHEDULE_HEADER_LENGTH = 5;
+
+	/*
+	 * SYNC_CANCEL:		no args; cancel everything scheduled that hasn't run yet
+	 */
+	static constexpr std::array<Parser::command_mapping_t, 2> COMMAND_HANDLERS = {
+			std::make_pair(CM_Mapping::SYNC_SCHEDULE, schedule),
+			Typed_Handler::command<CM_Mapping::SYNC_CANCEL, cancel_all>(),
+	};
+};
+
+
+
+#endif /* HANDLERS___COMMAND_APP_CMHAND_SYNC_H_ */
@@ -0,0 +1,104 @@
+/*
+ * app_cmhand_telemetry.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+
+
+#include "app_cmhand_telemetry.h"
+
+#include "app_control_regulator.h" //need this for regulator wrapper
+#include "app_utils.h" //for unpacking functions
+
+
+//================================================= STATIC MEMBER INITIALIZATION =================================================
+
+//initialze as empty at the start; expect to populate this before any commands get processed
+std::span<Power_Stage_Subsystem*, std::dynamic_extent> Telemetry_Command_Handlers::stages{};
+Comms_Telemetry* Telemetry_Command_Handlers::telemetry = nullptr;
+
+//======================================================== GETTER AND SETTER METHODS/UTILITIES ===================================================
+
+//pass stl container of instantiated power stage systems
+void Telemetry_Command_Handlers::attach_power_stage_systems(std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages) {
+	//just copy over the span passed into the member variable
+	stages = _stages;
+}
+
+//pass the telemetry streamer
+void Telemetry_Command_Handlers::attach_telemetry(Comms_Telemetry* _telemetry) {
+	telemetry = _telemetry;
+}
+
+//======================================================== THE ACTUAL COMMAND HANDLERS ===================================================
+
+/*
+ * start streaming telemetry from the regulator on channel `rx_payload[1]`:
+ * 	signals:		`rx_payload[2]` (bitmask, see `Comms_Telemetry::Signal_t`)
+ * 	decimation:		`rx_payload[3:6]` (take one sample every this many regulation cycles)
+ * replaces any subscription that's already running
+ */
+std::pair<Parser::MessageType_t, size_t> Telemetry_Command_Handlers::start_telemetry(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																						std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	//sanity check the received command
+	uint8_t tx_len;
+	if(!CM_Mapping::VALIDATE_COMMAND(tx_payload, rx_payload, 1, 7, CM_Mapping::TELEMETRY_START, tx_len))
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
+
+	//grab the channel, signals, and decimation factor
+	size_t channel = rx_payload[1];
+	uint8_t signals = rx_payload[2];
+	uint32_t decimation = unpack_uint32(rx_payload.subspan(3, 4));
+
+	//make sure we actually have a telemetry streamer to talk to
+	if(telemetry == nullptr) {
+		tx_payload[0] = Parser::NACK_ERROR_INTERNAL_FW;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	//check if we can index into the appropriate channel number
+	if(channel >= stages.size()) {
+		tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	//grab the reference to the regulator we'll be listening in on
+	Regulator_Wrapper& regulator = stages[channel]->get_regulator_instance();
+
+	//try to start the stream; fails if the signals or decimation don't make sense
+	if(!telemetry->start(regulator, (uint8_t)channel, signals, decimation)) {
+		tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	//respond with an ACK if the stream started successfully
+	tx_payload[0] = CM_Mapping::TELEMETRY_START;
+	return std::make_pair(Parser::DEVICE_ACK_HOST_MESSAGE, 1); //and return an ack message along with the single-byte payload
+}
+
+/*
+ * stop streaming telemetry; any samples already buffered still get sent
+ */
+std::pair<Parser::MessageType_t, size_t> Telemetry_Command_Handlers::stop_telemetry(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																						std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	//sanity check the received command
+	uint8_t tx_len;
+	if(!CM_Mapping::VALIDATE_COMMAND(tx_payload, rx_payload, 1, 1, CM_Mapping::TELEMETRY_STOP, tx_len))
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
+
+	//make sure we actually have a telemetry streamer to talk to
+	if(telemetry == nullptr) {
+		tx_payload[0] = Parser::NACK_ERROR_INTERNAL_FW;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	telemetry->stop();
+
+	//respond with an ACK
+	tx_payload[0] = CM_Mapping::TELEMETRY_STOP;
+	return std::make_pair(Parser::DEVICE_ACK_HOST_MESSAGE, 1); //and return an ack message along with the single-byte payload
+}
@@ -0,0 +1,64 @@
+/*
+ * app_cmhand_telemetry.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#ifndef HANDLERS___COMMAND_APP_CMHAND_TELEMETRY_H_
+#define HANDLERS___COMMAND_APP_CMHAND_TELEMETRY_H_
+
+#include <utility> //for make pair
+
+//to get request handler types
+#include "app_comms_parser.h"
+#include "app_cmhand_mapping.h" //to get the mapping for different command handlers
+#include "app_comms_typed_handler.h" //trace handlers are generated from the functions they call
+
+#include "app_power_stage_top_level.h" //to host an array of power stage controls
+#include "app_comms_telemetry.h" //to start and stop the telemetry stream
+#include "app_utils_trace.h" //to start and stop the trace stream
+
+class Telemetry_Command_Handlers
+{
+public:
+
+	//### NOTE: these are all FUNCTION DEFINITIONS with the appropriate signature of a command handler
+	static Parser::command_handler_sig_t start_telemetry;
+	static Parser::command_handler_sig_t stop_telemetry;
+	//###
+
+	//return some kinda stl-compatible container
+	//that contains all the request or command handlers defined in this class
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::command_mapping_t, std::dynamic_extent> command_handlers() { return COMMAND_HANDLERS; }
+
+	//pass stl container of instantiated power stage systems
+	static void attach_power_stage_systems(std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages);
+
+	//pass the telemetry streamer owned by the comms subsystem
+	static void attach_telemetry(Comms_Telemetry* _telemetry);
+
+	//delete any constructors
+	Telemetry_Command_Handlers() = delete;
+	Telemetry_Command_Handlers(Telemetry_Command_Handlers const&) = delete;
+
+private:
+	static std::span<Power_Stage_Subsystem*, std::dynamic_extent> stages; //have a container that holds a handful of power stages
+	static Comms_Telemetry* telemetry; //and the telemetry streamer we're controlling
+
+	/*
+	 * TRACE_START:		no args; start streaming trace records over the bulk link
+	 * TRACE_STOP:		no args; stop streaming them (events still get logged until the ring fills up)
+	 */
+	static constexpr std::array<Parser::command_mapping_t, 4> COMMAND_HANDLERS = {
+			std::make_pair(CM_Mapping::TELEMETRY_START, start_telemetry),
+			std::make_pair(CM_Mapping::TELEMETRY_STOP, stop_telemetry),
+			Typed_Handler::command<CM_Mapping::TRACE_START, Trace::start_streaming>(),
+			Typed_Handler::command<CM_Mapping::TRACE_STOP, Trace::stop_streaming>(),
+	};
+};
+
+
+
+#endif /* HANDLERS___COMMAND_APP_CMHAND_TELEMETRY_H_ */
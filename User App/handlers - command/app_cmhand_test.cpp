@@ -123,10 +123,3 @@ std::pair<Parser::MessageType_t, size_t> Test_Command_Handlers::test_string(cons
 	return std::make_pair(Parser::DEVICE_ACK_HOST_MESSAGE, 1); //and return an ack message along with the single-byte payload
 }
 
-//================================================== getter functions for container of handlers ===============================================
-
-//automatic conversion to `span` happens which is kinda sick
-std::span<const Parser::command_mapping_t, std::dynamic_extent> Test_Command_Handlers::command_handlers() {
-	return Test_Command_Handlers::COMMAND_HANDLERS;
-}
-
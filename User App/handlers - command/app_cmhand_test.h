@@ -31,7 +31,8 @@ public:
 
 	//return some kinda stl-compatible container
 	//that contains all the request or command handlers defined in this class
-	static std::span<const Parser::command_mapping_t, std::dynamic_extent> command_handlers();
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::command_mapping_t, std::dynamic_extent> command_handlers() { return COMMAND_HANDLERS; }
 
 	//delete any constructors
 	Test_Command_Handlers() = delete;
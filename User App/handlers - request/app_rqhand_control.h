@@ -12,27 +12,22 @@
 //to get request handler types
 #include "app_comms_parser.h"
 #include "app_rqhand_mapping.h" //to get the mapping for different request handlers
+#include "app_comms_typed_handler.h" //handlers here are all generated from the wrapper methods they call
 
 #include <span> //for stl span functions
 #include <utility> //for pair
 
 #include "app_power_stage_top_level.h" //to host an array of power stage controls
+#include "app_control_regulator.h" //to get access to the regulator
 
 class Controller_Request_Handlers
 {
 public:
 
-	//### NOTE: these are all FUNCTION DEFINITIONS with the appropriate signature of a request handler
-	static Parser::request_handler_sig_t get_rate;
-	static Parser::request_handler_sig_t get_crossover;
-	static Parser::request_handler_sig_t get_dc_gain;
-	static Parser::request_handler_sig_t get_load_res;
-	static Parser::request_handler_sig_t get_load_natural_freq;
-	//###
-
 	//return some kinda stl-compatible container
 	//that contains all the request or command handlers defined in this class
-	static std::span<const Parser::command_mapping_t, std::dynamic_extent> request_handlers();
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::command_mapping_t, std::dynamic_extent> request_handlers() { return REQUEST_HANDLERS; }
 
 	//pass stl container of instantiated power stage systems
 	static void attach_power_stage_systems(std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages);
@@ -46,12 +41,19 @@ private:
 	//but this keeps the interface a little more explicit which is chill
 	static std::span<Power_Stage_Subsystem*, std::dynamic_extent> stages; //have a container that holds a handful of power stages
 
+	//regulator on channel `channel`, or nullptr if we don't have that channel
+	static Regulator_Wrapper* regulator(const size_t channel);
+
+	/*
+	 * CONTROL_GET_FREQUENCY:	--> [1:4] controller update rate of all channels, Hz
+	 * everything else:			[1] channel --> [1] channel, [2:5] value
+	 */
 	static constexpr std::array<Parser::command_mapping_t, 5> REQUEST_HANDLERS = {
-			std::make_pair(RQ_Mapping::CONTROL_GET_FREQUENCY, get_rate),
-			std::make_pair(RQ_Mapping::CONTROL_GET_CROSSOVER, get_crossover),
-			std::make_pair(RQ_Mapping::CONTROL_GET_DC_GAIN, get_dc_gain),
-			std::make_pair(RQ_Mapping::LOAD_GET_DC_RESISTANCE, get_load_res),
-			std::make_pair(RQ_Mapping::LOAD_GET_NATURAL_FREQ, get_load_natural_freq),
+			Typed_Handler::request<RQ_Mapping::CONTROL_GET_FREQUENCY, Power_Stage_Subsystem::get_controller_frequency>(),
+			Typed_Handler::channel_request<RQ_Mapping::CONTROL_GET_CROSSOVER, regulator, &Regulator_Wrapper::get_crossover_freq>(),
+			Typed_Handler::channel_request<RQ_Mapping::CONTROL_GET_DC_GAIN, regulator, &Regulator_Wrapper::get_gain>(),
+			Typed_Handler::channel_request<RQ_Mapping::LOAD_GET_DC_RESISTANCE, regulator, &Regulator_Wrapper::get_load_resistance>(),
+			Typed_Handler::channel_request<RQ_Mapping::LOAD_GET_NATURAL_FREQ, regulator, &Regulator_Wrapper::get_load_natural_freq>(),
 	};
 };
 
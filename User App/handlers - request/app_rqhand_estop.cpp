@@ -0,0 +1,60 @@
+/*
+ * app_rqhand_estop.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+
+
+#include "app_rqhand_estop.h"
+
+#include "app_utils.h" //for packing functions
+
+
+//================================================= STATIC MEMBER INITIALIZATION =================================================
+
+//initialze as empty at the start; expect to populate this before any requests get processed
+Comms_Emergency_Stop* Estop_Request_Handlers::estop = nullptr;
+
+//======================================================== GETTER AND SETTER METHODS/UTILITIES ===================================================
+
+//pass the emergency stop
+void Estop_Request_Handlers::attach_estop(Comms_Emergency_Stop* _estop) {
+	estop = _estop;
+}
+
+//======================================================== THE ACTUAL REQUEST HANDLERS ===================================================
+
+/*
+ * no args
+ *
+ * tx_packet[1:4] = emergency stops handled straight from the receive ISR
+ * tx_packet[5:8] = how long the last one took from the frame's EOF landing to every stage being off, ns
+ * tx_packet[9:12] = worst case of the above, ns
+ * tx_packet[13:16] = stages found back on after a trip (i.e. the trip raced a mode change), and disabled again
+ * all counts free-running since power up
+ */
+std::pair<Parser::MessageType_t, size_t> Estop_Request_Handlers::get_stats(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																			std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	//sanity check the received request
+	uint8_t tx_len;
+	if(!RQ_Mapping::VALIDATE_REQUEST(tx_payload, rx_payload, STATS_RESPONSE_LENGTH, 1, RQ_Mapping::STAGE_GET_ESTOP_STATS, tx_len))
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
+
+	//make sure we actually have an emergency stop to talk to
+	if(estop == nullptr) {
+		tx_payload[0] = Parser::NACK_ERROR_INTERNAL_FW;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	//everything's kosher --> pack the stats into the tx payload
+	Comms_Emergency_Stop::Estop_Stats_t stats = estop->get_stats();
+	tx_payload[0] = RQ_Mapping::STAGE_GET_ESTOP_STATS; //this is the request we serviced
+	pack(stats.trips, tx_payload.subspan(1, 4));
+	pack(stats.latency_last_ns, tx_payload.subspan(5, 4));
+	pack(stats.latency_max_ns, tx_payload.subspan(9, 4));
+	pack(stats.reasserts, tx_payload.subspan(13, 4));
+	return std::make_pair(Parser::DEVICE_RESPONSE_HOST_REQUEST, STATS_RESPONSE_LENGTH); //and return a response along with the packed stats
+}
@@ -0,0 +1,54 @@
+/*
+ * app_rqhand_estop.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Request handlers to see how the emergency stop fast path has been doing
+ */
+
+#ifndef HANDLERS___REQUEST_APP_RQHAND_ESTOP_H_
+#define HANDLERS___REQUEST_APP_RQHAND_ESTOP_H_
+
+//to get request handler types
+#include "app_comms_parser.h"
+#include "app_rqhand_mapping.h" //to get the mapping for different request handlers
+
+#include <span> //for stl span functions
+#include <utility> //for pair
+
+#include "app_comms_estop.h" //keeps the stats
+
+class Estop_Request_Handlers
+{
+public:
+
+	//### NOTE: these are all FUNCTION DEFINITIONS with the appropriate signature of a request handler
+	static Parser::request_handler_sig_t get_stats;
+	//###
+
+	//return some kinda stl-compatible container
+	//that contains all the request or command handlers defined in this class
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::request_mapping_t, std::dynamic_extent> request_handlers() { return REQUEST_HANDLERS; }
+
+	//pass the emergency stop instance
+	static void attach_estop(Comms_Emergency_Stop* _estop);
+
+	//delete any constructors
+	Estop_Request_Handlers() = delete;
+	Estop_Request_Handlers(Estop_Request_Handlers const&) = delete;
+
+private:
+	static Comms_Emergency_Stop* estop;
+
+	static constexpr size_t STATS_RESPONSE_LENGTH = 17;
+
+	static constexpr std::array<Parser::request_mapping_t, 1> REQUEST_HANDLERS = {
+			std::make_pair(RQ_Mapping::STAGE_GET_ESTOP_STATS, get_stats),
+	};
+};
+
+
+
+#endif /* HANDLERS___REQUEST_APP_RQHAND_ESTOP_H_ */
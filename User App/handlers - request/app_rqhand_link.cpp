@@ -0,0 +1,102 @@
+/*
+ * app_rqhand_link.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+
+
+#include "app_rqhand_link.h"
+
+#include "app_utils.h" //for packing functions
+
+
+//================================================= STATIC MEMBER INITIALIZATION =================================================
+
+//initialze as empty at the start; expect to populate this before any requests get processed
+std::span<Comms_Exec_Subsystem*, std::dynamic_extent> Link_Request_Handlers::links{};
+
+//======================================================== GETTER AND SETTER METHODS/UTILITIES ===================================================
+
+//pass stl container of instantiated comms links
+void Link_Request_Handlers::attach_links(std::span<Comms_Exec_Subsystem*, std::dynamic_extent> _links) {
+	//just copy over the span passed into the member variable
+	links = _links;
+}
+
+//======================================================== THE ACTUAL REQUEST HANDLERS ===================================================
+
+/*
+ * rx_packet[1] = link
+ *
+ * tx_packet[1] = link
+ * tx_packet[2] = role (see `Comms_Exec_Subsystem::Link_Role_t`)
+ * tx_packet[3:6] = frames received
+ * tx_packet[7:10] = ...of which failed CRC
+ * tx_packet[11:14] = frames dropped because the receive queue was full
+ * tx_packet[15:18] = frames dropped because they were too long
+ * tx_packet[19:22] = frames dropped because of broken framing
+ * tx_packet[23:26] = responses sent
+ * tx_packet[27:30] = telemetry frames sent
+ * tx_packet[31:34] = frames that couldn't be encoded
+ * tx_packet[35:38] = latency of the last request, us
+ * tx_packet[39:42] = worst case request latency, us
+ * tx_packet[43:46] = average request latency, us
+ * tx_packet[47:50] = frames thrown away since they were for another device on the bus (multi-drop links only)
+ * tx_packet[51:54] = broadcast responses held back to our reply slot
+ * tx_packet[55:58] = ...of which went out late
+ * tx_packet[59:62] = trace frames sent
+ * tx_packet[63:66] = parameter change frames sent
+ * tx_packet[67:70] = debug text frames sent
+ * all counts free-running since power up; latency is from a request's EOF landing to its response being queued
+ */
+std::pair<Parser::MessageType_t, size_t> Link_Request_Handlers::get_stats(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																			std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	//sanity check the received request
+	uint8_t tx_len;
+	if(!RQ_Mapping::VALIDATE_REQUEST(tx_payload, rx_payload, STATS_RESPONSE_LENGTH, 2, RQ_Mapping::LINK_GET_STATS, tx_len))
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
+
+	//grab the link we wanna query
+	size_t link = rx_payload[1];
+
+	//check if we can index into the appropriate link
+	if(link >= links.size()) {
+		tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	//take a copy of the stats first--if we're querying the link we came in on, its counters will move once we've responded
+	Comms_Exec_Subsystem::Link_Stats_t stats = links[link]->get_stats();
+	UART& uart = links[link]->get_uart();
+
+	//the UART counts other devices' frames as decoder rejects too; take them back out so [19:22] is just broken framing
+	//read the filtered count first--the ISR bumps it before the reject count, so this can never come out negative
+	uint32_t rx_filtered = links[link]->get_rx_filtered_count();
+	uint32_t rx_rejects = uart.get_rx_reject_count() - rx_filtered;
+
+	//everything's kosher --> pack the stats into the tx payload
+	tx_payload[0] = RQ_Mapping::LINK_GET_STATS; //this is the request we serviced
+	tx_payload[1] = (uint8_t)link; //encode the particular link this request corresponds to
+	tx_payload[2] = (uint8_t)links[link]->get_role();
+	pack(stats.rx_frames, tx_payload.subspan(3, 4));
+	pack(stats.rx_crc_errors, tx_payload.subspan(7, 4));
+	pack(uart.get_rx_dropped_count(), tx_payload.subspan(11, 4));
+	pack(uart.get_rx_overflow_count(), tx_payload.subspan(15, 4));
+	pack(rx_rejects, tx_payload.subspan(19, 4));
+	pack(stats.tx_responses, tx_payload.subspan(23, 4));
+	pack(stats.tx_telemetry, tx_payload.subspan(27, 4));
+	pack(stats.tx_encode_errors, tx_payload.subspan(31, 4));
+	pack(stats.latency_last_us, tx_payload.subspan(35, 4));
+	pack(stats.latency_max_us, tx_payload.subspan(39, 4));
+	pack(stats.latency_avg_us, tx_payload.subspan(43, 4));
+	pack(rx_filtered, tx_payload.subspan(47, 4));
+	pack(stats.tx_slot_replies, tx_payload.subspan(51, 4));
+	pack(stats.tx_slot_late, tx_payload.subspan(55, 4));
+	pack(stats.tx_trace, tx_payload.subspan(59, 4));
+	pack(stats.tx_param_changes, tx_payload.subspan(63, 4));
+	pack(stats.tx_debug_text, tx_payload.subspan(67, 4));
+	return std::make_pair(Parser::DEVICE_RESPONSE_HOST_REQUEST, STATS_RESPONSE_LENGTH); //and return a response along with the packed stats
+}
@@ -0,0 +1,54 @@
+/*
+ * app_rqhand_link.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Request handlers to check up on the health of each serial link the device talks over
+ */
+
+#ifndef HANDLERS___REQUEST_APP_RQHAND_LINK_H_
+#define HANDLERS___REQUEST_APP_RQHAND_LINK_H_
+
+//to get request handler types
+#include "app_comms_parser.h"
+#include "app_rqhand_mapping.h" //to get the mapping for different request handlers
+
+#include <span> //for stl span functions
+#include <utility> //for pair
+
+#include "app_comms_top_level.h" //to host an array of comms links
+
+class Link_Request_Handlers
+{
+public:
+
+	//### NOTE: these are all FUNCTION DEFINITIONS with the appropriate signature of a request handler
+	static Parser::request_handler_sig_t get_stats;
+	//###
+
+	//return some kinda stl-compatible container
+	//that contains all the request or command handlers defined in this class
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::request_mapping_t, std::dynamic_extent> request_handlers() { return REQUEST_HANDLERS; }
+
+	//pass stl container of instantiated comms links; index in here is the link number the host asks for
+	static void attach_links(std::span<Comms_Exec_Subsystem*, std::dynamic_extent> _links);
+
+	//delete any constructors
+	Link_Request_Handlers() = delete;
+	Link_Request_Handlers(Link_Request_Handlers const&) = delete;
+
+private:
+	static std::span<Comms_Exec_Subsystem*, std::dynamic_extent> links; //every link the device talks over
+
+	static constexpr size_t STATS_RESPONSE_LENGTH = 71;
+
+	static constexpr std::array<Parser::request_mapping_t, 1> REQUEST_HANDLERS = {
+			std::make_pair(RQ_Mapping::LINK_GET_STATS, get_stats),
+	};
+};
+
+
+
+#endif /* HANDLERS___REQUEST_APP_RQHAND_LINK_H_ */
@@ -28,9 +28,14 @@ public:
 		TEST_FLOAT 		= (uint8_t)0x03,
 		TEST_STRING 	= (uint8_t)0x04,
 
+		//link diagnostics
+		LINK_GET_STATS			= (uint8_t)0x08,
+
 		//power stage global information
 		STAGE_ENABLE_STATUS		= (uint8_t)0x10,
 		STAGE_GET_FSW			= (uint8_t)0x11,
+		STAGE_GET_SNAPSHOT		= (uint8_t)0x12,
+		STAGE_GET_ESTOP_STATS	= (uint8_t)0x1F,
 
 		//power stage requests (fair game whenever, not just in manual mode)
 		STAGE_GET_DRIVE			= (uint8_t)0x17,
@@ -53,10 +58,18 @@ public:
 		SAMPLER_READ_FINE_RAW	= (uint8_t)0x44,
 		SAMPLER_READ_COARSE_RAW	= (uint8_t)0x45,
 
+		//scheduled command status
+		SYNC_GET_STATUS			= (uint8_t)0x50,
+
 		//sampler status and current output value
 		SETPOINT_GET_STATUS		= (uint8_t)0x61,
 		SETPOINT_GET_WAVE_TYPE	= (uint8_t)0x62,
 		SETPOINT_GET_VALUE		= (uint8_t)0x63,
+
+		//parameter map (see `Param_Map`)
+		PARAM_GET				= (uint8_t)0x80,
+		PARAM_DESCRIBE			= (uint8_t)0x81,
+		PARAM_GET_SUBSCRIPTIONS	= (uint8_t)0x82,
 	};
 
 	//utility function to validate formatting for request handlers
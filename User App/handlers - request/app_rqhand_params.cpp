@@ -0,0 +1,173 @@
+/*
+ * app_rqhand_params.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+
+
+#include "app_rqhand_params.h"
+
+#include "app_utils.h" //for packing functions
+
+
+//================================================= STATIC MEMBER INITIALIZATION =================================================
+
+//initialze as empty at the start; expect to populate this before any requests get processed
+Param_Map* Param_Request_Handlers::params = nullptr;
+Comms_Param_Notifier* Param_Request_Handlers::notifier = nullptr;
+
+//======================================================== GETTER AND SETTER METHODS/UTILITIES ===================================================
+
+//pass the parameter map
+void Param_Request_Handlers::attach_param_map(Param_Map* _params) {
+	params = _params;
+}
+
+//pass the parameter change notifier
+void Param_Request_Handlers::attach_param_notifier(Comms_Param_Notifier* _notifier) {
+	notifier = _notifier;
+}
+
+//======================================================== THE ACTUAL REQUEST HANDLERS ===================================================
+
+/*
+ * rx_packet[1:2] = first ID
+ * rx_packet[3] = count
+ *
+ * tx_packet[1:2] = first ID
+ * tx_packet[3] = count
+ * tx_packet[4:] = a 4-byte value for each parameter, packed according to its type (see `Param_Map::Param_Type_t`)
+ */
+std::pair<Parser::MessageType_t, size_t> Param_Request_Handlers::get_params(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																				std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	uint16_t first;
+	size_t count;
+	std::pair<Parser::MessageType_t, size_t> nack_response;
+	if(!unpack_range(rx_payload, tx_payload, RQ_Mapping::PARAM_GET, 4, first, count, nack_response)) return nack_response;
+
+	//read everything in one go
+	std::array<uint32_t, Param_Map::MAX_RANGE_COUNT> values;
+	if(params->get_range(first, std::span<uint32_t, std::dynamic_extent>(values.data(), count)) != Param_Map::PARAM_OK) {
+		tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	//everything's kosher --> echo the range and pack the values
+	tx_payload[0] = RQ_Mapping::PARAM_GET; //this is the request we serviced
+	tx_payload[1] = rx_payload[1];
+	tx_payload[2] = rx_payload[2];
+	tx_payload[3] = (uint8_t)count;
+	for(size_t i = 0; i < count; i++)
+		pack(values[i], tx_payload.subspan(RANGE_HEADER_LENGTH + i * 4, 4));
+	return std::make_pair(Parser::DEVICE_RESPONSE_HOST_REQUEST, RANGE_HEADER_LENGTH + count * 4);
+}
+
+/*
+ * rx_packet[1:2] = first ID
+ * rx_packet[3] = count
+ *
+ * tx_packet[1:2] = first ID
+ * tx_packet[3] = count
+ * tx_packet[4:] = a DESCRIPTION_LENGTH byte description of each parameter:
+ * 		[0] type (see `Param_Map::Param_Type_t`)
+ * 		[1] flags: [0] writable
+ * 		[2:5] lower bound (float)
+ * 		[6:9] upper bound (float)
+ */
+std::pair<Parser::MessageType_t, size_t> Param_Request_Handlers::describe_params(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																					std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	uint16_t first;
+	size_t count;
+	std::pair<Parser::MessageType_t, size_t> nack_response;
+	if(!unpack_range(rx_payload, tx_payload, RQ_Mapping::PARAM_DESCRIBE, DESCRIPTION_LENGTH, first, count, nack_response)) return nack_response;
+
+	//make sure every ID in the range is mapped before writing anything
+	for(size_t i = 0; i < count; i++) {
+		if(params->describe((uint16_t)(first + i)) == nullptr) {
+			tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
+			return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+		}
+	}
+
+	//everything's kosher --> echo the range and pack the descriptions
+	tx_payload[0] = RQ_Mapping::PARAM_DESCRIBE; //this is the request we serviced
+	tx_payload[1] = rx_payload[1];
+	tx_payload[2] = rx_payload[2];
+	tx_payload[3] = (uint8_t)count;
+	for(size_t i = 0; i < count; i++) {
+		const Param_Map::Param_Descriptor_t* descriptor = params->describe((uint16_t)(first + i));
+		std::span<uint8_t, std::dynamic_extent> description = tx_payload.subspan(RANGE_HEADER_LENGTH + i * DESCRIPTION_LENGTH, DESCRIPTION_LENGTH);
+		description[0] = (uint8_t)descriptor->type;
+		description[1] = (descriptor->apply != nullptr) ? 0x01 : 0x00;
+		pack(descriptor->min, description.subspan(2, 4));
+		pack(descriptor->max, description.subspan(6, 4));
+	}
+	return std::make_pair(Parser::DEVICE_RESPONSE_HOST_REQUEST, RANGE_HEADER_LENGTH + count * DESCRIPTION_LENGTH);
+}
+
+/*
+ * tx_packet[1] = count
+ * tx_packet[2:] = the 2-byte ID of every parameter we're sending changes for, in no particular order
+ */
+std::pair<Parser::MessageType_t, size_t> Param_Request_Handlers::get_subscriptions(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																					std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	//sanity check the received request
+	uint8_t tx_len;
+	if(!RQ_Mapping::VALIDATE_REQUEST(tx_payload, rx_payload, 2 + Comms_Param_Notifier::SUBSCRIPTION_COUNT * 2, 1, RQ_Mapping::PARAM_GET_SUBSCRIPTIONS, tx_len))
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
+
+	//make sure we actually have a notifier to talk to
+	if(notifier == nullptr) {
+		tx_payload[0] = Parser::NACK_ERROR_INTERNAL_FW;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	std::array<uint16_t, Comms_Param_Notifier::SUBSCRIPTION_COUNT> ids;
+	size_t count = notifier->get_subscriptions(ids);
+
+	//everything's kosher --> pack the list
+	tx_payload[0] = RQ_Mapping::PARAM_GET_SUBSCRIPTIONS; //this is the request we serviced
+	tx_payload[1] = (uint8_t)count;
+	for(size_t i = 0; i < count; i++) {
+		tx_payload[2 + i * 2] = (uint8_t)(ids[i] >> 8);
+		tx_payload[2 + i * 2 + 1] = (uint8_t)ids[i];
+	}
+	return std::make_pair(Parser::DEVICE_RESPONSE_HOST_REQUEST, 2 + count * 2);
+}
+
+//======================================================== PRIVATE UTILITIES ===================================================
+
+bool Param_Request_Handlers::unpack_range(	const std::span<uint8_t, std::dynamic_extent> rx_payload, std::span<uint8_t, std::dynamic_extent> tx_payload,
+											const RQ_Mapping::Map_Code code, const size_t bytes_per_param,
+											uint16_t& first, size_t& count, std::pair<Parser::MessageType_t, size_t>& nack_response)
+{
+	//sanity check the received request
+	uint8_t tx_len;
+	if(!RQ_Mapping::VALIDATE_REQUEST(tx_payload, rx_payload, RANGE_HEADER_LENGTH, RANGE_HEADER_LENGTH, code, tx_len)) {
+		nack_response = std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
+		return false;
+	}
+
+	//make sure we actually have a parameter map to talk to
+	if(params == nullptr) {
+		tx_payload[0] = Parser::NACK_ERROR_INTERNAL_FW;
+		nack_response = std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+		return false;
+	}
+
+	//and that the range is something we can actually respond to
+	first = (uint16_t)((rx_payload[1] << 8) | rx_payload[2]);
+	count = rx_payload[3];
+	if(count == 0 || count > Param_Map::MAX_RANGE_COUNT || RANGE_HEADER_LENGTH + count * bytes_per_param > tx_payload.size()) {
+		tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
+		nack_response = std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+		return false;
+	}
+
+	return true;
+}
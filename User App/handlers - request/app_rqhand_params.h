@@ -0,0 +1,69 @@
+/*
+ * app_rqhand_params.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Request handlers to read ranges of parameters (and what they are) through the parameter map
+ *  ...and which ones the host is subscribed to (see `Comms_Param_Notifier`)
+ */
+
+#ifndef HANDLERS___REQUEST_APP_RQHAND_PARAMS_H_
+#define HANDLERS___REQUEST_APP_RQHAND_PARAMS_H_
+
+//to get request handler types
+#include "app_comms_parser.h"
+#include "app_rqhand_mapping.h" //to get the mapping for different request handlers
+
+#include <span> //for stl span functions
+#include <utility> //for pair
+
+#include "app_config_param_map.h" //the parameters we're reading
+#include "app_comms_param_notify.h" //for the subscription list
+
+class Param_Request_Handlers
+{
+public:
+
+	//### NOTE: these are all FUNCTION DEFINITIONS with the appropriate signature of a request handler
+	static Parser::request_handler_sig_t get_params;
+	static Parser::request_handler_sig_t describe_params;
+	static Parser::request_handler_sig_t get_subscriptions;
+	//###
+
+	//return some kinda stl-compatible container
+	//that contains all the request or command handlers defined in this class
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::request_mapping_t, std::dynamic_extent> request_handlers() { return REQUEST_HANDLERS; }
+
+	//pass the parameter map instance
+	static void attach_param_map(Param_Map* _params);
+	static void attach_param_notifier(Comms_Param_Notifier* _notifier);
+
+	//delete any constructors
+	Param_Request_Handlers() = delete;
+	Param_Request_Handlers(Param_Request_Handlers const&) = delete;
+
+private:
+	static Param_Map* params;
+	static Comms_Param_Notifier* notifier;
+
+	//[code][first ID (2)][count], for both the request and the start of the response
+	static constexpr size_t RANGE_HEADER_LENGTH = 4;
+	static constexpr size_t DESCRIPTION_LENGTH = 10;
+
+	//validate a range request and pull out what it's asking for; returns false (with the NACK all set up) if it's no good
+	static bool unpack_range(	const std::span<uint8_t, std::dynamic_extent> rx_payload, std::span<uint8_t, std::dynamic_extent> tx_payload,
+								const RQ_Mapping::Map_Code code, const size_t bytes_per_param,
+								uint16_t& first, size_t& count, std::pair<Parser::MessageType_t, size_t>& nack_response);
+
+	static constexpr std::array<Parser::request_mapping_t, 3> REQUEST_HANDLERS = {
+			std::make_pair(RQ_Mapping::PARAM_GET, get_params),
+			std::make_pair(RQ_Mapping::PARAM_DESCRIBE, describe_params),
+			std::make_pair(RQ_Mapping::PARAM_GET_SUBSCRIPTIONS, get_subscriptions),
+	};
+};
+
+
+
+#endif /* HANDLERS___REQUEST_APP_RQHAND_PARAMS_H_ */
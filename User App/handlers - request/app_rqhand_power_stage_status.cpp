@@ -16,135 +16,130 @@ std::span<Power_Stage_Subsystem*, std::dynamic_extent> Power_Stage_Request_Handl
 
 //======================================================== GETTER AND SETTER METHODS/UTILITIES ===================================================
 
-//return some kinda stl-compatible container
-//that contains all the request or command handlers defined in this class
-std::span<const Parser::command_mapping_t, std::dynamic_extent> Power_Stage_Request_Handlers::request_handlers() {
-	return Power_Stage_Request_Handlers::REQUEST_HANDLERS;
-}
-
 //pass stl container of instantiated power stage systems
 void Power_Stage_Request_Handlers::attach_power_stage_systems(std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages) {
 	//just copy over the span passed into the member variable
 	stages = _stages;
 }
 
-//======================================================== THE ACTUAL REQUEST HANDLERS ===================================================
-
-/*
- * get the `enable_status` of channel `rx_packet[1]`
- */
-std::pair<Parser::MessageType_t, size_t> Power_Stage_Request_Handlers::stage_get_enable_status(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
-																								std::span<uint8_t, std::dynamic_extent> tx_payload)
-{
-	//sanity check the received request
-	uint8_t tx_len;
-	if(!RQ_Mapping::VALIDATE_REQUEST(tx_payload, rx_payload, 3, 2, RQ_Mapping::STAGE_ENABLE_STATUS, tx_len))
-		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
-
-	//grab the channel we wann query
-	size_t channel = rx_payload[1];
-
-	//check if we can index into the appropriate channel number
-	if(channel >= stages.size()) {
-		tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
-		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
-	}
-
-	//grab the power stage instance corresponding to the particular channel
-	uint8_t stage_mode = (uint8_t)stages[channel]->get_mode();
+//grab the power stage subsystem of a particular channel, if we have it
+Power_Stage_Subsystem* Power_Stage_Request_Handlers::stage(const size_t channel) {
+	if(channel >= stages.size()) return nullptr;
+	return stages[channel];
+}
 
-	//everything's kosher --> encode the channel enable status value into the tx payload
-	tx_payload[0] = RQ_Mapping::STAGE_ENABLE_STATUS; //this is the request we serviced
-	tx_payload[1] = (uint8_t)channel; //encode the particular channel this request corresponds to
-	tx_payload[2] = stage_mode; //encode the enumeration for the stage enable mode into this byte
-	return std::make_pair(Parser::DEVICE_RESPONSE_HOST_REQUEST, 3); //and return an ack message along with a three-byte payload
+//grab the bridge drive of a particular channel, if we have it
+Power_Stage_Wrapper* Power_Stage_Request_Handlers::bridge(const size_t channel) {
+	if(channel >= stages.size()) return nullptr;
+	return &stages[channel]->get_direct_stage_control_instance();
 }
 
+//======================================================== THE ACTUAL REQUEST HANDLERS ===================================================
+
 /*
- * get the drive of channel `rx_packet[1]`
+ * rx_packet[1] = channel, or SNAPSHOT_ALL_CHANNELS
+ *
+ * tx_packet[1] = SNAPSHOT_VERSION
+ * tx_packet[2] = number of channel records that follow
+ * tx_packet[3:6] = switching frequency of all channels, Hz
+ * tx_packet[7:10] = controller update rate of all channels, Hz
+ * tx_packet[11:] = a SNAPSHOT_RECORD_LENGTH byte record per channel (see `pack_snapshot()`)
+ *
+ * all channels won't necessarily fit in a regular frame; send the request as an extended message if they don't (NACKs with INVALID_MSG_SIZE otherwise)
  */
-std::pair<Parser::MessageType_t, size_t> Power_Stage_Request_Handlers::stage_get_drive(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
-																						std::span<uint8_t, std::dynamic_extent> tx_payload)
+std::pair<Parser::MessageType_t, size_t> Power_Stage_Request_Handlers::get_snapshot(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																					std::span<uint8_t, std::dynamic_extent> tx_payload)
 {
 	//sanity check the received request
 	uint8_t tx_len;
-	if(!RQ_Mapping::VALIDATE_REQUEST(tx_payload, rx_payload, 6, 2, RQ_Mapping::STAGE_GET_DRIVE, tx_len))
+	if(!RQ_Mapping::VALIDATE_REQUEST(tx_payload, rx_payload, SNAPSHOT_HEADER_LENGTH + SNAPSHOT_RECORD_LENGTH, 2, RQ_Mapping::STAGE_GET_SNAPSHOT, tx_len))
 		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
 
-	//grab the channel we wann query
-	size_t channel = rx_payload[1];
+	//work out which channels we're snapshotting
+	size_t first = rx_payload[1];
+	size_t count = 1;
+	if(rx_payload[1] == SNAPSHOT_ALL_CHANNELS) {
+		first = 0;
+		count = stages.size();
+	}
 
 	//check if we can index into the appropriate channel number
-	if(channel >= stages.size()) {
+	if(first + count > stages.size()) {
 		tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
 		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
 	}
 
-	//grab the power stage instance corresponding to the particular channel
-	Power_Stage_Wrapper& stage = stages[channel]->get_direct_stage_control_instance();
-
-	//grab the channel drive value from the particular power stage (should always be able to do this)
-	float channel_drive = stage.get_drive_duty();
-
-	//everything's kosher --> encode the channel drive value into the tx payload
-	tx_payload[0] = RQ_Mapping::STAGE_GET_DRIVE; //this is the request we serviced
-	tx_payload[1] = (uint8_t)channel; //encode the particular channel this request corresponds to
-	pack(channel_drive, tx_payload.subspan(2, 4)); //put the drive_value starting at index 2, taking 4 bytes
-	return std::make_pair(Parser::DEVICE_RESPONSE_HOST_REQUEST, 6); //and return an ack message along with a six-byte payload
-}
-
-/*
- * get the duty cycles of channel `rx_packet[1]`
- */
-std::pair<Parser::MessageType_t, size_t> Power_Stage_Request_Handlers::stage_get_duties(const std::span<uint8_t, std::dynamic_extent> rx_payload,
-																						std::span<uint8_t, std::dynamic_extent> tx_payload)
-{
-	//sanity check the received request
-	uint8_t tx_len;
-	if(!RQ_Mapping::VALIDATE_REQUEST(tx_payload, rx_payload, 10, 2, RQ_Mapping::STAGE_GET_DUTIES, tx_len))
-		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
-
-	//grab the channel we wann query
-	size_t channel = rx_payload[1];
-
-	//check if we can index into the appropriate channel number
-	if(channel >= stages.size()) {
-		tx_payload[0] = Parser::NACK_ERROR_COMMAND_OUT_OF_RANGE;
+	//and that all of them fit in the response
+	size_t response_length = SNAPSHOT_HEADER_LENGTH + count * SNAPSHOT_RECORD_LENGTH;
+	if(tx_payload.size() < response_length) {
+		tx_payload[0] = Parser::NACK_ERROR_INVALID_MSG_SIZE;
 		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
 	}
 
-	//grab the power stage instance corresponding to the particular channel
-	Power_Stage_Wrapper& stage = stages[channel]->get_direct_stage_control_instance();
-
-	//grab the channel duty cycle value from the particular power stage (should always be able to do this)
-	auto [drive_pos, drive_neg] = stage.get_drive_halves();
-
-	//everything's kosher --> encode the channel drive value into the tx payload
-	tx_payload[0] = RQ_Mapping::STAGE_GET_DUTIES; //this is the request we serviced
-	tx_payload[1] = (uint8_t)channel; //encode the particular channel this request corresponds to
-	pack(drive_pos, tx_payload.subspan(2, 4)); //put the positive duty cycle starting at index 2, taking 4 bytes
-	pack(drive_neg, tx_payload.subspan(6, 4)); //put the negative duty cycle starting at index 6, taking 4 bytes
-	return std::make_pair(Parser::DEVICE_RESPONSE_HOST_REQUEST, 10); //and return an ack message along with a six-byte payload
+	//everything's kosher --> pack the header, then a record for every channel
+	tx_payload[0] = RQ_Mapping::STAGE_GET_SNAPSHOT; //this is the request we serviced
+	tx_payload[1] = SNAPSHOT_VERSION;
+	tx_payload[2] = (uint8_t)count;
+	pack(Power_Stage_Subsystem::get_switching_frequency(), tx_payload.subspan(3, 4));
+	pack(Power_Stage_Subsystem::get_controller_frequency(), tx_payload.subspan(7, 4));
+	for(size_t i = 0; i < count; i++)
+		pack_snapshot(first + i, tx_payload.subspan(SNAPSHOT_HEADER_LENGTH + i * SNAPSHOT_RECORD_LENGTH, SNAPSHOT_RECORD_LENGTH));
+	return std::make_pair(Parser::DEVICE_RESPONSE_HOST_REQUEST, response_length); //and return a response along with the packed snapshot(s)
 }
 
+//======================================================== PRIVATE UTILITIES ===================================================
+
 /*
- * Get the switching frequency of all channels
- * won't have any other parameters to the request
+ * record[0] = channel
+ * record[1] = stage mode (see `Power_Stage_Subsystem::Stage_Mode`)
+ * record[2] = flags: [0] regulator enabled, [1] sampler running, [2] ISR-written values below all come from the same regulation cycle
+ * record[3:6] = regulation cycles run so far
+ * record[7:10] = setpoint the regulator was aiming for last cycle, A
+ * record[11:14] = current the regulator measured last cycle, A
+ * record[15:18] = regulator output last cycle
+ * record[19:22] = drive value, -1 to 1
+ * record[23:26] = positive duty cycle
+ * record[27:30] = negative duty cycle
+ * record[31:34] = latest current reading, A
+ * record[35:38] = fine channel raw readout
+ * record[39:42] = coarse channel raw readout
+ * record[43:46] = fine gain trim
+ * record[47:50] = fine offset trim
+ * record[51:54] = coarse gain trim
+ * record[55:58] = coarse offset trim
+ * record[59:62] = fine channel lower boundary count
+ * record[63:66] = fine channel upper boundary count
+ * record[67:70] = crossover frequency, Hz
+ * record[71:74] = DC gain
+ * record[75:78] = load DC resistance, ohms
+ * record[79:82] = load natural frequency, Hz
  */
-std::pair<Parser::MessageType_t, size_t> Power_Stage_Request_Handlers::stage_get_fsw(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
-																						std::span<uint8_t, std::dynamic_extent> tx_payload)
-{
-	//sanity check the received request
-	uint8_t tx_len;
-	if(!RQ_Mapping::VALIDATE_REQUEST(tx_payload, rx_payload, 5, 1, RQ_Mapping::STAGE_GET_FSW, tx_len))
-		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
-
-	//grab the switching frequency of all power stages
-	float fsw_hz = Power_Stage_Subsystem::get_switching_frequency();
-
-	//everything's kosher --> encode the channel drive value into the tx payload
-	tx_payload[0] = RQ_Mapping::STAGE_GET_FSW; //this is the request we serviced
-	pack(fsw_hz, tx_payload.subspan(1, 4)); //put the positive switching frequency starting at index 1, taking 4 bytes
-	return std::make_pair(Parser::DEVICE_RESPONSE_HOST_REQUEST, 5); //and return an ack message along with a five-byte payload
+void Power_Stage_Request_Handlers::pack_snapshot(const size_t channel, std::span<uint8_t, std::dynamic_extent> record) {
+	Power_Stage_Subsystem::Status_Snapshot_t snapshot = stages[channel]->get_snapshot();
+
+	record[0] = (uint8_t)channel;
+	record[1] = (uint8_t)snapshot.mode;
+	record[2] = (uint8_t)(	(snapshot.regulator_enabled ? 0x01 : 0) |
+							(snapshot.sampler_running ? 0x02 : 0) |
+							(snapshot.consistent ? 0x04 : 0));
+	pack(snapshot.cycle_count, record.subspan(3, 4));
+	pack(snapshot.setpoint, record.subspan(7, 4));
+	pack(snapshot.current, record.subspan(11, 4));
+	pack(snapshot.output, record.subspan(15, 4));
+	pack(snapshot.drive_duty, record.subspan(19, 4));
+	pack(snapshot.drive_halves.first, record.subspan(23, 4));
+	pack(snapshot.drive_halves.second, record.subspan(27, 4));
+	pack(snapshot.current_reading, record.subspan(31, 4));
+	pack((uint32_t)snapshot.fine_raw, record.subspan(35, 4));
+	pack((uint32_t)snapshot.coarse_raw, record.subspan(39, 4));
+	pack(snapshot.trim_fine.first, record.subspan(43, 4));
+	pack(snapshot.trim_fine.second, record.subspan(47, 4));
+	pack(snapshot.trim_coarse.first, record.subspan(51, 4));
+	pack(snapshot.trim_coarse.second, record.subspan(55, 4));
+	pack(snapshot.limits_fine.first, record.subspan(59, 4));
+	pack(snapshot.limits_fine.second, record.subspan(63, 4));
+	pack(snapshot.crossover_freq, record.subspan(67, 4));
+	pack(snapshot.dc_gain, record.subspan(71, 4));
+	pack(snapshot.load_resistance, record.subspan(75, 4));
+	pack(snapshot.load_natural_freq, record.subspan(79, 4));
 }
-
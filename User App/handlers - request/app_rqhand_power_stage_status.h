@@ -12,6 +12,7 @@
 //to get request handler types
 #include "app_comms_parser.h"
 #include "app_rqhand_mapping.h" //to get the mapping for different request handlers
+#include "app_comms_typed_handler.h" //handlers here are all generated from the methods they call
 
 #include <span> //for stl span functions
 #include <utility> //for pair
@@ -25,15 +26,13 @@ class Power_Stage_Request_Handlers
 public:
 
 	//### NOTE: these are all FUNCTION DEFINITIONS with the appropriate signature of a request handler
-	static Parser::request_handler_sig_t stage_get_enable_status;
-	static Parser::request_handler_sig_t stage_get_drive;
-	static Parser::request_handler_sig_t stage_get_duties;
-	static Parser::request_handler_sig_t stage_get_fsw;
+	static Parser::request_handler_sig_t get_snapshot;
 	//###
 
 	//return some kinda stl-compatible container
 	//that contains all the request or command handlers defined in this class
-	static std::span<const Parser::command_mapping_t, std::dynamic_extent> request_handlers();
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::command_mapping_t, std::dynamic_extent> request_handlers() { return REQUEST_HANDLERS; }
 
 	//pass stl container of instantiated power stage systems
 	static void attach_power_stage_systems(std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages);
@@ -47,11 +46,32 @@ private:
 	//but this keeps the interface a little more explicit which is chill
 	static std::span<Power_Stage_Subsystem*, std::dynamic_extent> stages; //have a container that holds a handful of power stages
 
-	static constexpr std::array<Parser::command_mapping_t, 4> REQUEST_HANDLERS = {
-			std::make_pair(RQ_Mapping::STAGE_ENABLE_STATUS, stage_get_enable_status),
-			std::make_pair(RQ_Mapping::STAGE_GET_DRIVE, stage_get_drive),
-			std::make_pair(RQ_Mapping::STAGE_GET_DUTIES, stage_get_duties),
-			std::make_pair(RQ_Mapping::STAGE_GET_FSW, stage_get_fsw),
+	//power stage subsystem/bridge drive on channel `channel`, or nullptr if we don't have that channel
+	static Power_Stage_Subsystem* stage(const size_t channel);
+	static Power_Stage_Wrapper* bridge(const size_t channel);
+
+	//bump this whenever the snapshot layout changes (see `get_snapshot()`); only ever append fields to the per-channel record
+	static constexpr uint8_t SNAPSHOT_VERSION = 1;
+	static constexpr uint8_t SNAPSHOT_ALL_CHANNELS = 0xFF;
+	static constexpr size_t SNAPSHOT_HEADER_LENGTH = 11;
+	static constexpr size_t SNAPSHOT_RECORD_LENGTH = 83;
+
+	//pack a single channel's snapshot into `record`, which has to be SNAPSHOT_RECORD_LENGTH long
+	static void pack_snapshot(const size_t channel, std::span<uint8_t, std::dynamic_extent> record);
+
+	/*
+	 * STAGE_ENABLE_STATUS:	[1] channel --> [1] channel, [2] stage mode (see `Power_Stage_Subsystem::Stage_Mode`)
+	 * STAGE_GET_DRIVE:		[1] channel --> [1] channel, [2:5] drive value, -1 to 1
+	 * STAGE_GET_DUTIES:	[1] channel --> [1] channel, [2:5] positive duty cycle, [6:9] negative duty cycle
+	 * STAGE_GET_FSW:		--> [1:4] switching frequency of all channels, Hz
+	 * STAGE_GET_SNAPSHOT:	[1] channel (or 0xFF for all) --> everything about the channel(s) in one go; see `get_snapshot()`
+	 */
+	static constexpr std::array<Parser::command_mapping_t, 5> REQUEST_HANDLERS = {
+			Typed_Handler::channel_request<RQ_Mapping::STAGE_ENABLE_STATUS, stage, &Power_Stage_Subsystem::get_mode>(),
+			Typed_Handler::channel_request<RQ_Mapping::STAGE_GET_DRIVE, bridge, &Power_Stage_Wrapper::get_drive_duty>(),
+			Typed_Handler::channel_request<RQ_Mapping::STAGE_GET_DUTIES, bridge, &Power_Stage_Wrapper::get_drive_halves>(),
+			Typed_Handler::request<RQ_Mapping::STAGE_GET_FSW, Power_Stage_Subsystem::get_switching_frequency>(),
+			std::make_pair(RQ_Mapping::STAGE_GET_SNAPSHOT, get_snapshot),
 	};
 };
 
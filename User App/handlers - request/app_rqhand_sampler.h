@@ -12,28 +12,22 @@
 //to get request handler types
 #include "app_comms_parser.h"
 #include "app_rqhand_mapping.h" //to get the mapping for different request handlers
+#include "app_comms_typed_handler.h" //handlers here are all generated from the wrapper methods they call
 
 #include <span> //for stl span functions
 #include <utility> //for pair
 
 #include "app_power_stage_top_level.h" //to host an array of power stage controls
+#include "app_power_stage_sampler.h" //to get access to sampler functions
 
 class Sampler_Request_Handlers
 {
 public:
 
-	//### NOTE: these are all FUNCTION DEFINITIONS with the appropriate signature of a request handler
-	static Parser::request_handler_sig_t read_current;
-	static Parser::request_handler_sig_t get_trim_fine;
-	static Parser::request_handler_sig_t get_trim_coarse;
-	static Parser::request_handler_sig_t get_fine_limits;
-	static Parser::request_handler_sig_t read_fine_raw;
-	static Parser::request_handler_sig_t read_coarse_raw;
-	//###
-
 	//return some kinda stl-compatible container
 	//that contains all the request or command handlers defined in this class
-	static std::span<const Parser::command_mapping_t, std::dynamic_extent> request_handlers();
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::command_mapping_t, std::dynamic_extent> request_handlers() { return REQUEST_HANDLERS; }
 
 	//pass stl container of instantiated power stage systems
 	static void attach_power_stage_systems(std::span<Power_Stage_Subsystem*, std::dynamic_extent> _stages);
@@ -47,13 +41,25 @@ private:
 	//but this keeps the interface a little more explicit which is chill
 	static std::span<Power_Stage_Subsystem*, std::dynamic_extent> stages; //have a container that holds a handful of power stages
 
+	//sampler on channel `channel`, or nullptr if we don't have that channel
+	static Sampler_Wrapper* sampler(const size_t channel);
+
+	/*
+	 * all of these take [1] channel, and respond with [1] channel followed by:
+	 * SAMPLER_READ_CURRENT:		[2:5] current reading, A
+	 * SAMPLER_GET_TRIM_FINE:		[2:5] gain trim, [6:9] offset trim
+	 * SAMPLER_GET_TRIM_COARSE:		[2:5] gain trim, [6:9] offset trim
+	 * SAMPLER_GET_FINE_LIMITS:		[2:5] lower boundary count, [6:9] upper boundary count
+	 * SAMPLER_READ_FINE_RAW:		[2:5] fine channel raw readout
+	 * SAMPLER_READ_COARSE_RAW:		[2:5] coarse channel raw readout
+	 */
 	static constexpr std::array<Parser::command_mapping_t, 6> REQUEST_HANDLERS = {
-			std::make_pair(RQ_Mapping::SAMPLER_READ_CURRENT, read_current),
-			std::make_pair(RQ_Mapping::SAMPLER_GET_TRIM_FINE, get_trim_fine),
-			std::make_pair(RQ_Mapping::SAMPLER_GET_TRIM_COARSE, get_trim_coarse),
-			std::make_pair(RQ_Mapping::SAMPLER_GET_FINE_LIMITS, get_fine_limits),
-			std::make_pair(RQ_Mapping::SAMPLER_READ_FINE_RAW, read_fine_raw),
-			std::make_pair(RQ_Mapping::SAMPLER_READ_COARSE_RAW, read_coarse_raw),
+			Typed_Handler::channel_request<RQ_Mapping::SAMPLER_READ_CURRENT, sampler, &Sampler_Wrapper::get_current_reading>(),
+			Typed_Handler::channel_request<RQ_Mapping::SAMPLER_GET_TRIM_FINE, sampler, &Sampler_Wrapper::get_trim_fine>(),
+			Typed_Handler::channel_request<RQ_Mapping::SAMPLER_GET_TRIM_COARSE, sampler, &Sampler_Wrapper::get_trim_coarse>(),
+			Typed_Handler::channel_request<RQ_Mapping::SAMPLER_GET_FINE_LIMITS, sampler, &Sampler_Wrapper::get_limits_fine>(),
+			Typed_Handler::channel_request<RQ_Mapping::SAMPLER_READ_FINE_RAW, sampler, &Sampler_Wrapper::read_fine_raw>(),
+			Typed_Handler::channel_request<RQ_Mapping::SAMPLER_READ_COARSE_RAW, sampler, &Sampler_Wrapper::read_coarse_raw>(),
 	};
 };
 
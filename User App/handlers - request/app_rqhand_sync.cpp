@@ -0,0 +1,68 @@
+/*
+ * app_rqhand_sync.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+
+
+#include "app_rqhand_sync.h"
+
+#include "app_utils.h" //for packing functions
+
+
+//================================================= STATIC MEMBER INITIALIZATION =================================================
+
+//initialze as empty at the start; expect to populate this before any requests get processed
+Comms_Sync_Scheduler* Sync_Request_Handlers::scheduler = nullptr;
+
+//======================================================== GETTER AND SETTER METHODS/UTILITIES ===================================================
+
+//pass the scheduler
+void Sync_Request_Handlers::attach_scheduler(Comms_Sync_Scheduler* _scheduler) {
+	scheduler = _scheduler;
+}
+
+//======================================================== THE ACTUAL REQUEST HANDLERS ===================================================
+
+/*
+ * no args
+ *
+ * tx_packet[1] = commands pending right now
+ * tx_packet[2:5] = commands scheduled
+ * tx_packet[6:9] = ...that ran and ACKed
+ * tx_packet[10:13] = ...that ran and NACKed
+ * tx_packet[14:17] = ...that got cancelled
+ * tx_packet[18:21] = ...that ran more than `Comms_Sync_Scheduler::LATE_THRESHOLD_US` after they were due
+ * tx_packet[22:25] = how long after its due time the last command ran, us
+ * tx_packet[26:29] = worst case of the above, us
+ * all counts free-running since power up
+ */
+std::pair<Parser::MessageType_t, size_t> Sync_Request_Handlers::get_status(	const std::span<uint8_t, std::dynamic_extent> rx_payload,
+																			std::span<uint8_t, std::dynamic_extent> tx_payload)
+{
+	//sanity check the received request
+	uint8_t tx_len;
+	if(!RQ_Mapping::VALIDATE_REQUEST(tx_payload, rx_payload, STATUS_RESPONSE_LENGTH, 1, RQ_Mapping::SYNC_GET_STATUS, tx_len))
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, tx_len);
+
+	//make sure we actually have a scheduler to talk to
+	if(scheduler == nullptr) {
+		tx_payload[0] = Parser::NACK_ERROR_INTERNAL_FW;
+		return std::make_pair(Parser::DEVICE_NACK_HOST_MESSAGE, 1);
+	}
+
+	//everything's kosher --> pack the stats into the tx payload
+	Comms_Sync_Scheduler::Sync_Stats_t stats = scheduler->get_stats();
+	tx_payload[0] = RQ_Mapping::SYNC_GET_STATUS; //this is the request we serviced
+	tx_payload[1] = (uint8_t)scheduler->get_pending_count();
+	pack(stats.scheduled, tx_payload.subspan(2, 4));
+	pack(stats.applied, tx_payload.subspan(6, 4));
+	pack(stats.failed, tx_payload.subspan(10, 4));
+	pack(stats.cancelled, tx_payload.subspan(14, 4));
+	pack(stats.late, tx_payload.subspan(18, 4));
+	pack(stats.lateness_last_us, tx_payload.subspan(22, 4));
+	pack(stats.lateness_max_us, tx_payload.subspan(26, 4));
+	return std::make_pair(Parser::DEVICE_RESPONSE_HOST_REQUEST, STATUS_RESPONSE_LENGTH); //and return a response along with the packed stats
+}
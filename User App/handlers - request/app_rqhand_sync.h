@@ -0,0 +1,54 @@
+/*
+ * app_rqhand_sync.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Request handlers to check up on commands scheduled to run at a particular time
+ */
+
+#ifndef HANDLERS___REQUEST_APP_RQHAND_SYNC_H_
+#define HANDLERS___REQUEST_APP_RQHAND_SYNC_H_
+
+//to get request handler types
+#include "app_comms_parser.h"
+#include "app_rqhand_mapping.h" //to get the mapping for different request handlers
+
+#include <span> //for stl span functions
+#include <utility> //for pair
+
+#include "app_comms_sync.h" //the scheduler holding the commands
+
+class Sync_Request_Handlers
+{
+public:
+
+	//### NOTE: these are all FUNCTION DEFINITIONS with the appropriate signature of a request handler
+	static Parser::request_handler_sig_t get_status;
+	//###
+
+	//return some kinda stl-compatible container
+	//that contains all the request or command handlers defined in this class
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::request_mapping_t, std::dynamic_extent> request_handlers() { return REQUEST_HANDLERS; }
+
+	//pass the scheduler instance
+	static void attach_scheduler(Comms_Sync_Scheduler* _scheduler);
+
+	//delete any constructors
+	Sync_Request_Handlers() = delete;
+	Sync_Request_Handlers(Sync_Request_Handlers const&) = delete;
+
+private:
+	static Comms_Sync_Scheduler* scheduler;
+
+	static constexpr size_t STATUS_RESPONSE_LENGTH = 30;
+
+	static constexpr std::array<Parser::request_mapping_t, 1> REQUEST_HANDLERS = {
+			std::make_pair(RQ_Mapping::SYNC_GET_STATUS, get_status),
+	};
+};
+
+
+
+#endif /* HANDLERS___REQUEST_APP_RQHAND_SYNC_H_ */
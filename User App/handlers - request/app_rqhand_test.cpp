@@ -82,9 +82,3 @@ std::pair<Parser::MessageType_t, size_t> Test_Request_Handlers::test_string(cons
 	return std::make_pair(Parser::DEVICE_RESPONSE_HOST_REQUEST, the_test_string.size() + 1); //and return an ack message along with a <size+1>-byte payload
 }
 
-//================================================== getter functions for container of handlers ===============================================
-
-//automatic conversion to `span` happens which is kinda sick
-std::span<const Parser::request_mapping_t, std::dynamic_extent> Test_Request_Handlers::request_handlers() {
-	return Test_Request_Handlers::REQUEST_HANDLERS;
-}
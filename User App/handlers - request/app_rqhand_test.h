@@ -34,7 +34,8 @@ public:
 
 	//return some kinda stl-compatible container
 	//that contains all the request or command handlers defined in this class
-	static std::span<const Parser::request_mapping_t, std::dynamic_extent> request_handlers();
+	//constexpr so the parser's dispatch tables can be generated from it at compile time
+	static constexpr std::span<const Parser::request_mapping_t, std::dynamic_extent> request_handlers() { return REQUEST_HANDLERS; }
 
 	//delete any constructors
 	Test_Request_Handlers() = delete;
@@ -17,6 +17,10 @@
 
 //subsystem includes
 #include "app_comms_top_level.h"
+#include "app_comms_sync.h"
+#include "app_comms_estop.h"
+#include "app_comms_heartbeat.h"
+#include "app_comms_param_notify.h"
 #include "app_power_stage_top_level.h"
 
 //command/request handler includes
@@ -24,14 +28,24 @@
 #include "app_cmhand_setpoint.h"
 #include "app_cmhand_control.h"
 #include "app_cmhand_sampler.h"
+#include "app_cmhand_telemetry.h"
+#include "app_cmhand_sync.h"
+#include "app_cmhand_params.h"
+#include "app_cmhand_estop.h"
 #include "app_rqhand_power_stage_status.h"
 #include "app_rqhand_setpoint.h"
 #include "app_rqhand_control.h"
 #include "app_rqhand_sampler.h"
+#include "app_rqhand_link.h"
+#include "app_rqhand_sync.h"
+#include "app_rqhand_params.h"
+#include "app_rqhand_estop.h"
 
 
 //configuration + utility includes
 #include "app_config.h"
+#include "app_config_param_map.h"
+#include "app_utils_trace.h"
 #include "app_utils_debug_print.h"
 #include "app_utils.h"
 
@@ -39,31 +53,59 @@
 Configuration config;
 
 //instantiating subsystems
-Comms_Exec_Subsystem comms_exec(Comms_Exec_Subsystem::COMMS_CHANNEL_0); //create a comms executor on hardware channel 0
+Comms_Exec_Subsystem comms_control(Comms_Exec_Subsystem::COMMS_CHANNEL_0); //low latency control link on hardware channel 0
+Comms_Exec_Subsystem comms_bulk(Comms_Exec_Subsystem::COMMS_CHANNEL_1); //bulk transfers + telemetry on hardware channel 1
+std::array<Comms_Exec_Subsystem*, 2> comms_links = {&comms_control, &comms_bulk}; //link numbers the host can query diagnostics for
+Comms_Sync_Scheduler sync_scheduler(Comms_Exec_Subsystem::command_table()); //holds commands the host wants run at a particular time
 Power_Stage_Subsystem power_stage_sys(Power_Stage_Subsystem::POWER_STAGE_CHANNEL_0, &config.active, 0); //instantiate an object that controls power stage 0
 std::array<Power_Stage_Subsystem*, config.POWER_STAGE_COUNT> power_stage_systems = {&power_stage_sys}; //we have just a single power stage we're controlling (pass to the command handler)
+Param_Map param_map(config.active, power_stage_systems); //every tunable on the device, by ID
+Comms_Emergency_Stop estop(power_stage_systems); //disables every stage straight from the receive ISRs
+Comms_Heartbeat heartbeat(config.active, comms_links, power_stage_systems); //shuts the stages down if the host goes quiet
+Comms_Param_Notifier param_notifier(param_map); //tells the host when parameters it cares about change
 
-Debug_Print db(UART::UART3);
+Debug_Print db; //text printed from anywhere on the device; goes out on the bulk link
 
 //TODO: comms handlers for ADC reading + setpoint stuff + tuning stuff, also instantiate some more UARTs and ADCs
 
 void app_init() {
 	//DIO::init();
-	comms_exec.init(0x00); //comms ID
+	Timer::init_cycle_counter(); //comms links use this to time their requests, and the trace log to timestamp events
+	Trace::log<Trace::BOOT>(Timer::get_cycles_per_second());
+	comms_control.init(0x00); //comms ID
+	comms_bulk.init(0x00); //same device, so same ID on both links
 	power_stage_sys.init();
 
+	//scheduled commands land at the start of a regulation cycle
+	for(Power_Stage_Subsystem* stage : power_stage_systems)
+		stage->get_regulator_instance().attach_cycle_start_cb(Context_Callback_Function<>(&sync_scheduler, Comms_Sync_Scheduler::service_forwarder));
+
 	//attach subsystem instances to command and request handlers
 	Power_Stage_Command_Handlers::attach_power_stage_systems(power_stage_systems);
 	Setpoint_Command_Handlers::attach_power_stage_systems(power_stage_systems);
 	Controller_Command_Handlers::attach_power_stage_systems(power_stage_systems);
 	Sampler_Command_Handlers::attach_power_stage_systems(power_stage_systems);
+	Telemetry_Command_Handlers::attach_power_stage_systems(power_stage_systems);
 
 	Power_Stage_Request_Handlers::attach_power_stage_systems(power_stage_systems);
 	Setpoint_Request_Handlers::attach_power_stage_systems(power_stage_systems);
 	Controller_Request_Handlers::attach_power_stage_systems(power_stage_systems);
 	Sampler_Request_Handlers::attach_power_stage_systems(power_stage_systems);
-
-	db.init(); //initialize debug UART
+	Link_Request_Handlers::attach_links(comms_links);
+	Sync_Command_Handlers::attach_scheduler(&sync_scheduler);
+	Sync_Request_Handlers::attach_scheduler(&sync_scheduler);
+	Param_Command_Handlers::attach_param_map(&param_map);
+	Param_Request_Handlers::attach_param_map(&param_map);
+	Estop_Command_Handlers::attach_estop(&estop);
+	Estop_Request_Handlers::attach_estop(&estop);
+	Param_Command_Handlers::attach_param_notifier(&param_notifier);
+	Param_Request_Handlers::attach_param_notifier(&param_notifier);
+	comms_bulk.attach_param_notifier(&param_notifier); //changes go out alongside telemetry
+	comms_bulk.attach_debug_printer(&db); //and debug text goes out with whatever bandwidth is left
+
+	//and only let the receive ISRs stop the stages once they've been initialized
+	for(Comms_Exec_Subsystem* link : comms_links)
+		link->attach_emergency_stop_cb(&estop, Comms_Emergency_Stop::trip_forwarder);
 }
 
 //void debug_func() {
@@ -73,7 +115,6 @@ void app_init() {
 //
 //	if(Timer::get_ms() - tick > TICKRATE) {
 //		std::string text = std::to_string(sampler.read_fine_raw()) + std::string("\t\t") + std::to_string(sampler.read_coarse_raw()) + std::string("\r\n");
-//		db.print(text);
 //		tick += TICKRATE;
 //	}
 //}
@@ -120,7 +161,6 @@ void debug_func() {
 //		for(int i = 0; i < 10; i++) {
 //			stage.set_drive(drive);
 //			std::string text = f2s<4>(sampler.get_current_reading()) + std::string("\r\n");
-//			db.print(text);
 //			Timer::delay_ms(1);
 //		}
 //	}
@@ -129,7 +169,6 @@ void debug_func() {
 //		for(int i = 0; i < 10; i++) {
 //			stage.set_drive(drive);
 //			std::string text = f2s<4>(sampler.get_current_reading()) + std::string("\r\n");
-//			db.print(text);
 //			Timer::delay_ms(1);
 //		}
 //	}
@@ -137,11 +176,19 @@ void debug_func() {
 
 void app_loop() {
 	//handle the communication + command/request execution
-	comms_exec.loop();
+	//control link goes first, so anything waiting on it never sits behind bulk traffic
+	comms_control.loop();
+	comms_bulk.loop();
+	sync_scheduler.loop(); //run anything scheduled that the regulator ISR isn't around to run
+	estop.loop(); //make sure an emergency stop didn't lose a race with a mode change
+	heartbeat.loop(); //and that the host is still around to be driving anything
 
 	//call the loop function for all power stage subsystems
 	for(Power_Stage_Subsystem* stage : power_stage_systems) stage->loop();
 
+	//catch anything that changed this pass (from anywhere); goes out on the bulk link next time around
+	param_notifier.loop();
+
 	debug_func();
 }
 
@@ -8,6 +8,10 @@
 #include "app_power_stage_top_level.h"
 
 #include <functional> //for std::ref
+#include <atomic> //for compiler fences around snapshot reads
+#include <string.h> //for memcmp
+
+#include "app_utils_trace.h" //to log mode changes
 
 
 //============================= STATIC MEMBER INITIALIZATION ============================
@@ -169,6 +173,7 @@ bool Power_Stage_Subsystem::set_mode(Stage_Mode mode) {
 	if(mode == operating_mode) return true;
 
 	//we're changing modes
+	Stage_Mode previous_mode = operating_mode;
 	switch(mode) {
 		case Stage_Mode::UNINITIALIZED:
 			return false; //can't go back into unitialized state
@@ -217,6 +222,7 @@ bool Power_Stage_Subsystem::set_mode(Stage_Mode mode) {
 			break;
 	}
 
+	Trace::log<Trace::STAGE_MODE>((uint32_t)CHANNEL_NUM, previous_mode, operating_mode);
 	return true;
 }
 
@@ -226,6 +232,59 @@ Power_Stage_Subsystem::Stage_Mode Power_Stage_Subsystem::get_mode() {
 	return operating_mode;
 }
 
+/*
+ * Grab everything about this channel without stopping (or even pausing) the regulator
+ * Anything an ISR can write gets read in a tight block--and that block gets read TWICE, between two reads of the regulator's cycle counter
+ * 	\--> more than just the regulator ISR writes in here: the mode can change from the receive ISRs (emergency stop) and the sync
+ * 		  scheduler's hook, and the sampler keeps updating its readings from the ADC ISR even with the regulator off
+ * 	\--> the cycle counter only moves while a regulator is enabled, so it can't catch those on its own
+ * 	\--> instead, if both reads of the block come back bit-for-bit identical (and the counter didn't move), nothing changed under us
+ * 		  (or whatever did write, wrote back what was already there); otherwise just read it all again
+ * 		  the block's short enough that the next try almost always lands between two updates
+ * Everything else only ever changes from the main loop (i.e. this context) so it can't change under us
+ */
+Power_Stage_Subsystem::Status_Snapshot_t Power_Stage_Subsystem::get_snapshot() {
+	//both copies start out zeroed (padding and all) so they can be compared as plain bytes
+	Status_Snapshot_t snapshot = {};
+	Status_Snapshot_t check = {};
+
+	auto read_isr_fields = [this](Status_Snapshot_t& s) {
+		s.mode = operating_mode;
+		s.regulator_enabled = regulator.get_enabled();
+		s.setpoint = regulator.get_last_setpoint();
+		s.current = regulator.get_last_current();
+		s.output = regulator.get_last_output();
+		s.drive_duty = stage.get_drive_duty();
+		s.drive_halves = stage.get_drive_halves();
+		s.current_reading = current_sampler.get_current_reading();
+		s.fine_raw = current_sampler.get_raw_fine();
+		s.coarse_raw = current_sampler.get_raw_coarse();
+	};
+
+	for(size_t attempt = 0; attempt < SNAPSHOT_MAX_ATTEMPTS && !snapshot.consistent; attempt++) {
+		uint32_t cycles_before = regulator.get_cycle_count();
+		std::atomic_signal_fence(std::memory_order_seq_cst); //keep the compiler from hoisting reads above the counter
+
+		read_isr_fields(snapshot);
+		std::atomic_signal_fence(std::memory_order_seq_cst); //...or merging the two reads
+		read_isr_fields(check);
+
+		std::atomic_signal_fence(std::memory_order_seq_cst); //...or sinking them below it
+		snapshot.cycle_count = check.cycle_count = regulator.get_cycle_count();
+		snapshot.consistent = (snapshot.cycle_count == cycles_before) && (memcmp(&snapshot, &check, sizeof(snapshot)) == 0);
+	}
+
+	snapshot.sampler_running = current_sampler.get_running();
+	snapshot.trim_fine = current_sampler.get_trim_fine();
+	snapshot.trim_coarse = current_sampler.get_trim_coarse();
+	snapshot.limits_fine = current_sampler.get_limits_fine();
+	snapshot.crossover_freq = regulator.get_crossover_freq();
+	snapshot.dc_gain = regulator.get_gain();
+	snapshot.load_resistance = regulator.get_load_resistance();
+	snapshot.load_natural_freq = regulator.get_load_natural_freq();
+	return snapshot;
+}
+
 Power_Stage_Wrapper& Power_Stage_Subsystem::get_direct_stage_control_instance() {
 	return stage_wrapper; //access controlled version of the power stage
 }
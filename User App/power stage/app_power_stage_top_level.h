@@ -54,6 +54,35 @@ public:
 		ENABLED_AUTOTUNING	= (uint8_t)0x03,
 	};
 
+	//================================================== EVERYTHING ABOUT A CHANNEL IN ONE SPOT ==================================================
+	//everything the host could otherwise only get through a dozen-odd separate requests
+	struct Status_Snapshot_t {
+		Stage_Mode mode;
+		bool regulator_enabled;
+		bool sampler_running;
+		bool consistent; //false if ISRs kept getting in the way and the values below may straddle two updates
+
+		//written from ISRs (mostly the regulator's)--all from the same instant if `consistent`
+		uint32_t cycle_count; //regulation cycles run so far
+		float setpoint; //what the regulator was aiming for last cycle
+		float current; //what it measured last cycle
+		float output; //what it asked the stage for last cycle
+		float drive_duty; //what the stage is actually being driven with
+		std::pair<float, float> drive_halves;
+		float current_reading; //latest sampler reading
+		uint16_t fine_raw;
+		uint16_t coarse_raw;
+
+		//only ever change from the main loop
+		std::pair<float, float> trim_fine;
+		std::pair<float, float> trim_coarse;
+		std::pair<uint32_t, uint32_t> limits_fine;
+		float crossover_freq;
+		float dc_gain;
+		float load_resistance;
+		float load_natural_freq;
+	};
+
 	//======================================================= PUBLIC METHODS =======================================================
 
 	//constructor; delete copy constructor and assignment operator to avoid weird hardware conflicts
@@ -67,6 +96,9 @@ public:
 	bool set_mode(Stage_Mode mode); //returns true if successfully set
 	Stage_Mode get_mode(); //equivalent getter method
 
+	//capture everything about this channel at once, without stopping the regulator (see the .cpp for how)
+	Status_Snapshot_t get_snapshot();
+
 	void init(); //call from the setup function
 	void loop(); //call from the loop function
 
@@ -104,6 +136,9 @@ private:
 	//=============================== PRIVATE METHOD TO UPDATE INSTANCES WHEN OPERATING FREQUENCIES UPDATED =====================================
 	bool recompute_rates();
 
+	//how many times `get_snapshot()` tries for a clean read before giving up and flagging the snapshot as inconsistent
+	static constexpr size_t SNAPSHOT_MAX_ATTEMPTS = 8;
+
 
 	//##### all these objects will be initialized in the constructor of `Comms_Exec_Subsystem` #####
 	//======================== Everything Power-stage Related =========================
@@ -7,40 +7,50 @@
 
 
 #include "app_utils_debug_print.h"
-#include "app_utils.h" //for span casting functions
 
-Debug_Print::Debug_Print(UART::UART_Hardware_Channel& hw):
-	debug_serial_port(hw, '\n', '\r', txbuf, rxbuf)
-{}
+#include <algorithm> //for copy
 
-void Debug_Print::init() {
-	debug_serial_port.init();
-}
+#include "app_utils.h" //for packing functions
 
-void Debug_Print::print(std::string text) {
-	//just return if we can't fit our text into our transmit buffer
-	if(text.size() > BUFFER_LENGTH) return;
+Debug_Print::Debug_Print():
+	messages(ring_storage)
+{}
 
-	//copy the string into our intermediate buffer
-	std::copy(text.begin(), text.end(), tx_conversion_buffer.begin());
+bool Debug_Print::print(std::string_view text) {
+	//a message that doesn't fit in a frame would never make it out, so don't let it clog up the ring
+	//(and the ring doesn't take empty records anyway)
+	if(text.empty() || text.size() > MESSAGE_MAX_LENGTH) {
+		rejected_count.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
 
-	//transmit the bytes over UART
-	debug_serial_port.transmit(spn(tx_conversion_buffer, text.size()));
+	//just drop it into the ring; the bulk link takes it from there
+	return messages.write(std::span<const uint8_t, std::dynamic_extent>(reinterpret_cast<const uint8_t*>(text.data()), text.size()));
 }
 
-bool Debug_Print::available() {
-	return debug_serial_port.available();
+bool Debug_Print::frame_ready() {
+	return !messages.front().empty();
 }
 
-std::string Debug_Print::read() {
-	//poll the UART, waiting until data is available; then copy any data into the RX intermediate buffer
-	size_t packet_size = 0;
-	do {
-		packet_size = debug_serial_port.get_packet(rx_intermediate_buffer);
-	} while(packet_size <= 0);
-
-	//build a string outta the received data (minus leading and trailing frame characters)
-	return std::string(rx_intermediate_buffer.begin() + 1, rx_intermediate_buffer.begin() + packet_size - 1);
+size_t Debug_Print::pack_frame(std::span<uint8_t, std::dynamic_extent> tx_payload) {
+	if(tx_payload.size() < MESSAGES_START_INDEX) return 0;
+
+	//pull whole messages out of the ring until the next one doesn't fit
+	size_t tx_index = MESSAGES_START_INDEX;
+	for(auto message = messages.front(); !message.empty(); message = messages.front()) {
+		if(tx_index + 1 + message.size() > tx_payload.size()) break;
+		tx_payload[tx_index++] = (uint8_t)message.size();
+		std::copy(message.begin(), message.end(), tx_payload.begin() + tx_index);
+		tx_index += message.size();
+		messages.pop();
+	}
+	if(tx_index == MESSAGES_START_INDEX) return 0;
+
+	//let the host know if it missed anything
+	pack(get_dropped_count(), tx_payload.subspan(DROPPED_INDEX, 4));
+	return tx_index;
 }
 
-
+uint32_t Debug_Print::get_dropped_count() {
+	return messages.get_dropped_count() + rejected_count.load(std::memory_order_relaxed);
+}
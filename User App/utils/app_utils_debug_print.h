@@ -4,49 +4,74 @@
  *  Created on: Oct 16, 2023
  *      Author: Ishaan
  *
- *  Use this to print to a serial monitor
+ *  Use this to print text back to the host
+ *
+ *  UPDATE: printing never blocks and never touches the heap
+ *  	- `print()` just drops the text into a `Record_Ring`, so it's safe to call from any context (ISRs included)
+ *  		\--> if the ring is full, the message is dropped and counted rather than waiting on the wire
+ *  	- the bulk comms link packs waiting messages into DEVICE_DEBUG_TEXT frames in the background, same as the trace log
+ *  		\--> and those get chained out of the UART's transmit queue by DMA, like every other frame
+ *
+ *  UPDATE: text used to go out raw over USART3, which now runs the bulk comms link--so it rides on that link instead
+ *  	\--> which means there's no line-based `read()` any more; anything the host wants to tell the device goes through a command
+ *  	\--> reach for this for one-off bring-up and debugging; anything worth keeping around should be a trace event (see `app_utils_trace.h`)
+ *  		 since those cost a fraction of the time and bandwidth, and don't need any text built up on the device
+ *
+ *  DEVICE_DEBUG_TEXT frame payload:
+ *  	[0:3]		DROPPED		free-running count of messages dropped, for being too long or the ring being full (big endian)
+ *  	[4:...]		MESSAGES	back to back, each as [LEN] followed by LEN bytes of text (not null terminated)
  */
 
 #ifndef UTILS_APP_UTILS_DEBUG_PRINT_H_
 #define UTILS_APP_UTILS_DEBUG_PRINT_H_
 
-#include <array> //to create TX and RX buffers
-#include <string> //to pass strings to and from
+#include <stddef.h> //for size_t
+#include <stdint.h> //for uint8_t
+#include <span> //for passing buffers around
+#include <array> //for ring storage
+#include <string_view> //to pass text in without copying it into a string first
+#include <atomic> //for the drop counter
 
-#include "app_hal_uart.h" //print over some kinda UART connection
+#include "app_utils_record_ring.h" //to queue up messages from any context
 
 class Debug_Print {
 public:
-	Debug_Print(UART::UART_Hardware_Channel& hw);
+	//how many bytes of messages can be waiting to go out (header words included); power of two
+	static constexpr size_t RING_LENGTH = 2048;
+
+	//layout of a DEVICE_DEBUG_TEXT frame payload
+	static constexpr size_t DROPPED_INDEX = 0;
+	static constexpr size_t MESSAGES_START_INDEX = 4;
 
-	//delete copy constructor and assignment operator
+	//longest message that goes out in one go; anything longer gets dropped
+	//sized so any message fits in a single (short) frame, behind the frame header and its length byte
+	static constexpr size_t MESSAGE_MAX_LENGTH = 200;
+
+	Debug_Print();
+
+	//delete copy constructor and assignment operator; the bulk link hangs onto a pointer to this
 	Debug_Print(Debug_Print const&) = delete;
 	void operator=(Debug_Print const&) = delete;
 
-	//call to initialize the UART
-	void init();
+	//queue up some text to print; SAFE FROM ANY CONTEXT, NEVER BLOCKS
+	//returns false if the message was empty, too long, or there was no room for it (counted in `get_dropped_count()`)
+	bool print(std::string_view text);
 
-	//print a line to the serial port (make sure it can fit in the tx buffer in one go)
-	//BLOCKING FUNCTION CALL UNTIL LINE CAN SEND
-	void print(std::string text);
+	//================== CALL FROM MAIN LOOP ==================
+	//returns true if there are messages waiting to go out
+	bool frame_ready();
 
-	//check to see if a packet is available over UART
-	bool available();
+	//pack as many waiting messages as fit into a DEVICE_DEBUG_TEXT payload; returns the payload length (0 if nothing to send)
+	size_t pack_frame(std::span<uint8_t, std::dynamic_extent> tx_payload);
 
-	//read a complete line from the serial port
-	//ENSURE THAT LINES ARE TERMINATED WITH "\r\n" IN THAT ORDER
-	//BLOCKING FUNCTION CALL UNTIL LINE IS RECEIVED
-	std::string read();
+	//free-running count of messages that were dropped rather than printed
+	uint32_t get_dropped_count();
 
 private:
-	static const size_t BUFFER_LENGTH = 1024;
-
-	UART debug_serial_port;
-	std::array<uint8_t, BUFFER_LENGTH> txbuf; //place for UART to put outgoing serial data
-	std::array<uint8_t, BUFFER_LENGTH> rxbuf; //place for UART to put incoming serial data
-
-	std::array<uint8_t, BUFFER_LENGTH> tx_conversion_buffer; //intermediate place to put string bytes before tx
-	std::array<uint8_t, BUFFER_LENGTH> rx_intermediate_buffer; //place to get packets from debug uart
+	//messages waiting to go out
+	std::array<uint32_t, RING_LENGTH / sizeof(uint32_t)> ring_storage;
+	Record_Ring messages;
+	std::atomic<uint32_t> rejected_count{0}; //messages too long (or short) to ever go out
 };
 
 
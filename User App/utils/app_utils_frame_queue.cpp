@@ -0,0 +1,66 @@
+/*
+ * app_utils_frame_queue.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#include "app_utils_frame_queue.h"
+
+#include <bit> //for bit_floor
+
+//round the slot count down to a power of two, so a slot index never jumps when the free-running counters wrap
+Frame_Queue::Frame_Queue(std::span<uint8_t, std::dynamic_extent> _storage, std::span<size_t, std::dynamic_extent> _lengths):
+	storage(_storage), lengths(_lengths.first(std::bit_floor(_lengths.size()))),
+	SLOT_SIZE(lengths.size() ? _storage.size() / lengths.size() : 0),
+	INDEX_MASK(lengths.size() ? lengths.size() - 1 : 0)
+{}
+
+//================================== PRODUCER SIDE ==================================
+
+std::span<uint8_t, std::dynamic_extent> Frame_Queue::write_slot() {
+	//producer owns `head`, so a relaxed read is fine; need to see the consumer's latest `tail` though
+	size_t h = head.load(std::memory_order_relaxed);
+	if(h - tail.load(std::memory_order_acquire) >= capacity()) return {};
+	return slot(h);
+}
+
+bool Frame_Queue::push(const size_t length) {
+	size_t h = head.load(std::memory_order_relaxed);
+	if(h - tail.load(std::memory_order_acquire) >= capacity()) return false;
+	if(length > SLOT_SIZE) return false;
+
+	//record the length, then publish the frame
+	//release ordering guarantees the consumer sees the slot contents + length before it sees the new head
+	lengths[h & INDEX_MASK] = length;
+	head.store(h + 1, std::memory_order_release);
+	return true;
+}
+
+//================================== CONSUMER SIDE ==================================
+
+std::span<uint8_t, std::dynamic_extent> Frame_Queue::front() {
+	size_t t = tail.load(std::memory_order_relaxed);
+	if(head.load(std::memory_order_acquire) == t) return {};
+	return slot(t).subspan(0, lengths[t & INDEX_MASK]);
+}
+
+void Frame_Queue::pop() {
+	size_t t = tail.load(std::memory_order_relaxed);
+	if(head.load(std::memory_order_acquire) == t) return;
+
+	//release ordering so the producer doesn't reuse the slot before we're done reading it
+	tail.store(t + 1, std::memory_order_release);
+}
+
+//================================== EITHER SIDE ==================================
+
+bool Frame_Queue::empty() { return size() == 0; }
+bool Frame_Queue::full() { return size() >= capacity(); }
+size_t Frame_Queue::size() { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+size_t Frame_Queue::capacity() { return lengths.size(); }
+size_t Frame_Queue::slot_size() { return SLOT_SIZE; }
+
+std::span<uint8_t, std::dynamic_extent> Frame_Queue::slot(const size_t index) {
+	return storage.subspan((index & INDEX_MASK) * SLOT_SIZE, SLOT_SIZE);
+}
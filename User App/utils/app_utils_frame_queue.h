@@ -0,0 +1,80 @@
+/*
+ * app_utils_frame_queue.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Fixed-capacity, single-producer/single-consumer queue of byte frames
+ *
+ *  The backing memory is split into `lengths.size()` equally sized slots. The producer (typically an ISR)
+ *  writes directly into the slot handed out by `write_slot()` and publishes it with `push()`;
+ *  the consumer (typically the main loop) reads the oldest frame with `front()` and frees it with `pop()`.
+ *  No frame is ever copied by the queue itself.
+ *
+ *  Lock-free as long as there's exactly ONE producer context and ONE consumer context:
+ *  	- only the producer ever writes `head`, only the consumer ever writes `tail`
+ *  	- indices are free-running counters; occupancy is just `head - tail` (unsigned wraparound takes care of itself)
+ *  	- a counter maps to its slot by masking off the low bits, so the slot count HAS to be a power of two
+ *  		\--> otherwise the slot index would jump when the counters wrap past 2^32 and the queue would hand out the wrong frames
+ *  		\--> the constructor just ignores any extra `lengths` past the biggest power of two that fits
+ *  		\--> compile-time queue depths should static_assert this where they're defined so that never actually happens
+ *  	- release/acquire ordering makes sure slot contents are visible before the index that publishes them
+ *
+ *  Following the convention of the UART class, memory is passed in as spans so instances can be statically allocated
+ *  without templating. No HAL dependencies here so the queue can be exercised on a host build.
+ */
+
+#ifndef UTILS_APP_UTILS_FRAME_QUEUE_H_
+#define UTILS_APP_UTILS_FRAME_QUEUE_H_
+
+#include <stddef.h> //for size_t
+#include <stdint.h> //for uint8_t
+#include <span> //for c++ style pointer+length data structures
+#include <atomic> //for lock-free index sharing between contexts
+
+class Frame_Queue {
+public:
+	//`storage` gets split evenly into `lengths.size()` slots
+	//only a power-of-two number of slots is used (see above); `storage` gets split between those
+	Frame_Queue(std::span<uint8_t, std::dynamic_extent> _storage, std::span<size_t, std::dynamic_extent> _lengths);
+
+	//delete copy constructor and assignment operator; other contexts hang onto references of this
+	Frame_Queue(Frame_Queue const&) = delete;
+	void operator=(Frame_Queue const&) = delete;
+
+	//================== PRODUCER SIDE ==================
+	//returns the full slot the next frame should be written into; empty span if the queue is full
+	std::span<uint8_t, std::dynamic_extent> write_slot();
+
+	//publish the frame written into `write_slot()` with the given length
+	//returns false if the queue was full or the length doesn't fit in a slot
+	bool push(const size_t length);
+
+	//================== CONSUMER SIDE ==================
+	//returns the oldest frame, truncated to its length; empty span if the queue is empty
+	std::span<uint8_t, std::dynamic_extent> front();
+
+	//free the oldest frame; does nothing if the queue is empty
+	void pop();
+
+	//================== EITHER SIDE ==================
+	bool empty();
+	bool full();
+	size_t size(); //how many frames are waiting
+	size_t capacity(); //how many frames can wait at once
+	size_t slot_size(); //how many bytes a single frame can occupy
+
+private:
+	std::span<uint8_t, std::dynamic_extent> storage;
+	std::span<size_t, std::dynamic_extent> lengths;
+	const size_t SLOT_SIZE;
+	const size_t INDEX_MASK; //capacity - 1; picks the slot out of a free-running counter
+
+	//return the memory corresponding to a particular free-running index
+	std::span<uint8_t, std::dynamic_extent> slot(const size_t index);
+
+	std::atomic<size_t> head{0}; //number of frames ever pushed; ONLY WRITTEN BY PRODUCER
+	std::atomic<size_t> tail{0}; //number of frames ever popped; ONLY WRITTEN BY CONSUMER
+};
+
+#endif /* UTILS_APP_UTILS_FRAME_QUEUE_H_ */
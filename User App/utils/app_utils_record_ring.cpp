@@ -0,0 +1,124 @@
+/*
+ * app_utils_record_ring.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#include "app_utils_record_ring.h"
+
+#include <algorithm> //for copy and fill
+
+Record_Ring::Record_Ring(std::span<uint32_t, std::dynamic_extent> _storage):
+	storage(_storage)
+{
+	//every word starts out zeroed, i.e. not a committed header
+	std::fill(storage.begin(), storage.end(), 0);
+}
+
+//================================== PRODUCER SIDE ==================================
+
+std::span<uint8_t, std::dynamic_extent> Record_Ring::claim(const size_t length) {
+	//zero-length records don't get through either--the span we'd hand back couldn't tell `commit()` where its header is
+	//(a header in the last word of the ring would need padding that `words_for(0)` doesn't ask for)
+	size_t words = words_for(length);
+	if(length == 0 || length > MAX_RECORD_LENGTH || words > storage.size()) {
+		dropped_count.fetch_add(1, std::memory_order_relaxed);
+		return {};
+	}
+
+	//keep trying to bump `head` past our record until nobody beats us to it
+	size_t h = head.load(std::memory_order_relaxed);
+	size_t padding;
+	do {
+		//if the record would run off the end of the ring, claim the rest of the ring as filler and start over at the beginning
+		size_t offset = h % storage.size();
+		padding = (offset + words > storage.size()) ? storage.size() - offset : 0;
+
+		//need to see the consumer's latest `tail` so we don't write over anything it hasn't freed yet
+		if(h + padding + words - tail.load(std::memory_order_acquire) > storage.size()) {
+			dropped_count.fetch_add(1, std::memory_order_relaxed);
+			return {};
+		}
+	} while(!head.compare_exchange_weak(h, h + padding + words, std::memory_order_acquire, std::memory_order_relaxed));
+
+	//the words are ours now; nothing else to write for the filler so commit it right away
+	if(padding) header(h).store(HEADER_COMMITTED | HEADER_PADDING | (uint32_t)padding, std::memory_order_release);
+
+	//hand out the bytes after our header
+	uint32_t* record = &storage[(h + padding + 1) % storage.size()];
+	return std::span<uint8_t, std::dynamic_extent>(reinterpret_cast<uint8_t*>(record), length);
+}
+
+void Record_Ring::commit(const std::span<uint8_t, std::dynamic_extent> record) {
+	if(record.data() == nullptr) return;
+
+	//header sits in the word right before the record
+	//release ordering guarantees the consumer sees the record contents before it sees the COMMITTED bit
+	uint32_t* record_header = reinterpret_cast<uint32_t*>(record.data()) - 1;
+	std::atomic_ref<uint32_t>(*record_header).store(HEADER_COMMITTED | (uint32_t)record.size(), std::memory_order_release);
+}
+
+bool Record_Ring::write(const std::span<const uint8_t, std::dynamic_extent> bytes) {
+	std::span<uint8_t, std::dynamic_extent> record = claim(bytes.size());
+	if(record.data() == nullptr) return false;
+	std::copy(bytes.begin(), bytes.end(), record.begin());
+	commit(record);
+	return true;
+}
+
+//================================== CONSUMER SIDE ==================================
+
+std::span<uint8_t, std::dynamic_extent> Record_Ring::front() {
+	skip_padding();
+
+	//nothing claimed, or the oldest record is still being written
+	size_t t = tail.load(std::memory_order_relaxed);
+	if(head.load(std::memory_order_acquire) == t) return {};
+	uint32_t record_header = header(t).load(std::memory_order_acquire);
+	if(!(record_header & HEADER_COMMITTED)) return {};
+
+	uint32_t* record = &storage[(t + 1) % storage.size()];
+	return std::span<uint8_t, std::dynamic_extent>(reinterpret_cast<uint8_t*>(record), record_header & HEADER_LENGTH_MASK);
+}
+
+void Record_Ring::pop() {
+	skip_padding();
+
+	size_t t = tail.load(std::memory_order_relaxed);
+	if(head.load(std::memory_order_acquire) == t) return;
+	uint32_t record_header = header(t).load(std::memory_order_acquire);
+	if(!(record_header & HEADER_COMMITTED)) return;
+
+	//wipe the record so none of it can pass as a committed header next time around, then hand the words back
+	//release ordering so producers don't reuse the words before we're done with them
+	size_t offset = t % storage.size();
+	size_t words = words_for(record_header & HEADER_LENGTH_MASK);
+	std::fill(storage.begin() + offset, storage.begin() + offset + words, 0);
+	tail.store(t + words, std::memory_order_release);
+}
+
+void Record_Ring::skip_padding() {
+	size_t t = tail.load(std::memory_order_relaxed);
+	while(head.load(std::memory_order_acquire) != t) {
+		uint32_t record_header = header(t).load(std::memory_order_acquire);
+		if((record_header & (HEADER_COMMITTED | HEADER_PADDING)) != (HEADER_COMMITTED | HEADER_PADDING)) return;
+
+		//filler always runs to the end of the ring
+		size_t offset = t % storage.size();
+		size_t words = record_header & HEADER_LENGTH_MASK;
+		std::fill(storage.begin() + offset, storage.begin() + offset + words, 0);
+		t += words;
+		tail.store(t, std::memory_order_release);
+	}
+}
+
+//================================== EITHER SIDE ==================================
+
+bool Record_Ring::empty() { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+size_t Record_Ring::capacity() { return storage.size() * sizeof(uint32_t); }
+uint32_t Record_Ring::get_dropped_count() { return dropped_count.load(std::memory_order_relaxed); }
+
+std::atomic_ref<uint32_t> Record_Ring::header(const size_t index) {
+	return std::atomic_ref<uint32_t>(storage[index % storage.size()]);
+}
@@ -0,0 +1,95 @@
+/*
+ * app_utils_record_ring.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Fixed-capacity, MULTI-producer/single-consumer ring of variable length byte records
+ *
+ *  Where `Frame_Queue` hands out equally sized slots to exactly one producer, this packs records back to back
+ *  so short messages don't waste a whole slot, and lets any number of contexts (main loop, any ISR) write at once
+ *  Meant for logging-type traffic: lots of small records from all over the place, drained by a single consumer in the background
+ *
+ *  Every record is a header word followed by its bytes, padded out to a whole number of words:
+ *  	[31]		COMMITTED	set by the producer once the record's contents are all written
+ *  	[30]		PADDING		record is just filler up to the end of the ring (see below); consumer skips it
+ *  	[15:0]		LENGTH		bytes in the record (or words of filler, for PADDING records)
+ *
+ *  How the contexts stay out of each other's way without locking (or disabling interrupts):
+ *  	- producers claim space by bumping `head` with a compare-and-swap; whoever wins owns those words outright
+ *  		\--> an ISR that preempts a producer mid-claim just makes that producer retry; nobody ever waits on anybody
+ *  	- a record always sits contiguously in memory; if it doesn't fit before the end of the ring, the claim includes
+ *  	  a PADDING record out to the end and the record itself starts back at the beginning
+ *  	- the consumer only ever looks at the record at `tail`, and only once its COMMITTED bit is set
+ *  		\--> records claimed later but committed earlier (i.e. by an ISR that preempted a producer) wait their turn
+ *  	- the consumer zeroes out everything it frees before handing it back, so a stale word never looks like a committed header
+ *  If there's no room, the record is dropped (and counted) rather than waiting for the consumer
+ *
+ *  Memory is passed in as a span of words so instances can be statically allocated without templating
+ *  	\--> make it a power of two words long, so the free-running indices stay consistent when they wrap around
+ *  No HAL dependencies here so the ring can be exercised on a host build
+ */
+
+#ifndef UTILS_APP_UTILS_RECORD_RING_H_
+#define UTILS_APP_UTILS_RECORD_RING_H_
+
+#include <stddef.h> //for size_t
+#include <stdint.h> //for uint8_t
+#include <span> //for c++ style pointer+length data structures
+#include <atomic> //for lock-free index sharing between contexts
+
+class Record_Ring {
+public:
+	//longest record the header can describe
+	static constexpr size_t MAX_RECORD_LENGTH = 0xFFFF;
+
+	Record_Ring(std::span<uint32_t, std::dynamic_extent> _storage);
+
+	//delete copy constructor and assignment operator; other contexts hang onto references of this
+	Record_Ring(Record_Ring const&) = delete;
+	void operator=(Record_Ring const&) = delete;
+
+	//================== PRODUCER SIDE; SAFE FROM ANY CONTEXT ==================
+	//claim room for a `length` byte record; fill the span that comes back, then `commit()` it
+	//returns an empty span (and counts a drop) if there isn't room right now, or if `length` is 0
+	//NOTE: every claimed record must be committed, otherwise the consumer stalls behind it forever
+	std::span<uint8_t, std::dynamic_extent> claim(const size_t length);
+	void commit(const std::span<uint8_t, std::dynamic_extent> record);
+
+	//claim + copy + commit in one go; returns false if the record was dropped
+	bool write(const std::span<const uint8_t, std::dynamic_extent> bytes);
+
+	//================== CONSUMER SIDE; ONE CONTEXT ONLY ==================
+	//returns the oldest committed record; empty span if there's nothing (finished) to read
+	std::span<uint8_t, std::dynamic_extent> front();
+
+	//free the oldest record; does nothing if `front()` would come back empty
+	void pop();
+
+	//================== EITHER SIDE ==================
+	bool empty(); //true if nothing is claimed or waiting
+	size_t capacity(); //in bytes, including record headers
+	uint32_t get_dropped_count(); //free-running count of records that didn't fit
+
+private:
+	static constexpr uint32_t HEADER_COMMITTED = 0x80000000;
+	static constexpr uint32_t HEADER_PADDING = 0x40000000;
+	static constexpr uint32_t HEADER_LENGTH_MASK = 0xFFFF;
+
+	//how many words a record of `length` bytes takes up, header included
+	static constexpr size_t words_for(const size_t length) { return 1 + (length + sizeof(uint32_t) - 1) / sizeof(uint32_t); }
+
+	//header word of the record at a particular free-running index
+	std::atomic_ref<uint32_t> header(const size_t index);
+
+	//skip over any PADDING records sitting at `tail`
+	void skip_padding();
+
+	std::span<uint32_t, std::dynamic_extent> storage;
+
+	std::atomic<size_t> head{0}; //words ever claimed; bumped by producers with compare-and-swap
+	std::atomic<size_t> tail{0}; //words ever freed; ONLY WRITTEN BY CONSUMER
+	std::atomic<uint32_t> dropped_count{0};
+};
+
+#endif /* UTILS_APP_UTILS_RECORD_RING_H_ */
@@ -0,0 +1,58 @@
+/*
+ * app_utils_trace.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ */
+
+#include "app_utils_trace.h"
+
+#include <algorithm> //for copy
+
+#include "app_utils.h" //for packing functions
+
+//================================================= STATIC MEMBER INITIALIZATION =================================================
+
+std::array<uint32_t, Trace::RING_LENGTH / sizeof(uint32_t)> Trace::ring_storage;
+Record_Ring Trace::ring(ring_storage);
+bool Trace::streaming = false;
+
+//================================================= MAIN LOOP SIDE =================================================
+
+bool Trace::start_streaming() {
+	streaming = true;
+	return true;
+}
+
+bool Trace::stop_streaming() {
+	streaming = false;
+	return true;
+}
+
+bool Trace::frame_ready() {
+	return streaming && !ring.front().empty();
+}
+
+size_t Trace::pack_frame(std::span<uint8_t, std::dynamic_extent> tx_payload) {
+	if(tx_payload.size() < RECORDS_START_INDEX) return 0;
+
+	//pull whole records out of the ring until the next one doesn't fit
+	size_t tx_index = RECORDS_START_INDEX;
+	for(auto record = ring.front(); !record.empty(); record = ring.front()) {
+		if(tx_index + 1 + record.size() > tx_payload.size()) break;
+		tx_payload[tx_index++] = (uint8_t)record.size();
+		std::copy(record.begin(), record.end(), tx_payload.begin() + tx_index);
+		tx_index += record.size();
+		ring.pop();
+	}
+	if(tx_index == RECORDS_START_INDEX) return 0;
+
+	//stamp the frame with what the host needs to make sense of it
+	pack(get_dropped_count(), tx_payload.subspan(DROPPED_INDEX, 4));
+	pack(Timer::get_cycles_per_second(), tx_payload.subspan(CLOCK_INDEX, 4));
+	return tx_index;
+}
+
+uint32_t Trace::get_dropped_count() {
+	return ring.get_dropped_count();
+}
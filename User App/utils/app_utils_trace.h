@@ -0,0 +1,152 @@
+/*
+ * app_utils_trace.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Binary trace log that's cheap enough to leave on in production, even inside control code
+ *
+ *  Building text on the device (`std::to_string()`, `f2s<>()`, etc.) costs heap allocations and hundreds of cycles per float
+ *  Instead, `log()` just drops the event's ID, a timestamp and the raw argument bits into a `Record_Ring`
+ *  	\--> a compare-and-swap, a handful of stores and a commit--a few dozen cycles, from any context (ISRs included)
+ *  	\--> format strings (see `app_utils_trace_formats.h`) only exist at compile time, so they don't even take up flash
+ *  	\--> if the ring's full, the event is dropped and counted
+ *  Once the host turns streaming on (TRACE_START), the bulk comms link packs waiting records into DEVICE_TRACE frames in the background
+ *  and the host decoder (`trace_decode.py`) turns them back into text using the same format list
+ *
+ *  Each record in the ring is laid out as follows:
+ *  	[0:1]		ID			which event (position in `TRACE_FORMATS`)
+ *  	[2:5]		TIMESTAMP	cycle counter when the event was logged (see `Timer::get_cycles()`)
+ *  	[6:...]		ARGS		4 bytes per argument, in the order they appear in the format string
+ *  THESE ARE LITTLE ENDIAN (i.e. straight out of memory, unlike the rest of the protocol), so logging doesn't have to shuffle bytes around
+ *
+ *  DEVICE_TRACE frame payload:
+ *  	[0:3]		DROPPED		free-running count of events dropped because the ring was full (big endian)
+ *  	[4:7]		CLOCK		cycle counter frequency, Hz (big endian)
+ *  	[8:...]		RECORDS		back to back, each as [LEN] followed by LEN bytes of record (as above)
+ */
+
+#ifndef UTILS_APP_UTILS_TRACE_H_
+#define UTILS_APP_UTILS_TRACE_H_
+
+#include <stddef.h> //for size_t
+#include <stdint.h> //for uint8_t
+#include <string.h> //for memcpy
+#include <span> //for passing buffers around
+#include <array> //for ring storage
+#include <type_traits> //to check argument types
+
+#include "app_utils_record_ring.h" //to queue up events from any context
+#include "app_utils_trace_formats.h" //list of events we can log
+#include "app_hal_timing.h" //for timestamps
+
+class Trace {
+public:
+	//every event we know how to log; these are just positions in `TRACE_FORMATS`
+	#define TRACE_ID(name, format) name,
+	enum Trace_Id : uint16_t {
+		TRACE_FORMATS(TRACE_ID)
+	};
+	#undef TRACE_ID
+
+	//layout of a record
+	static constexpr size_t ID_INDEX = 0;
+	static constexpr size_t TIMESTAMP_INDEX = 2;
+	static constexpr size_t ARGS_START_INDEX = 6;
+	static constexpr size_t ARG_LENGTH = 4;
+
+	//layout of a DEVICE_TRACE frame payload
+	static constexpr size_t DROPPED_INDEX = 0;
+	static constexpr size_t CLOCK_INDEX = 4;
+	static constexpr size_t RECORDS_START_INDEX = 8;
+
+	//how many bytes of events can be waiting to go out (record headers included); power of two
+	static constexpr size_t RING_LENGTH = 4096;
+
+	//log an event; SAFE FROM ANY CONTEXT, NEVER BLOCKS
+	//won't compile if the arguments don't line up with the conversions in the event's format string
+	template<Trace_Id ID, typename... Args>
+	static inline void log(const Args... args) {
+		static_assert(arguments_match<Args...>(FORMATS[ID]), "trace arguments don't match the event's format string");
+
+		std::span<uint8_t, std::dynamic_extent> record = ring.claim(ARGS_START_INDEX + sizeof...(Args) * ARG_LENGTH);
+		if(record.data() == nullptr) return;
+
+		uint16_t id = ID;
+		uint32_t timestamp = Timer::get_cycles();
+		memcpy(record.data() + ID_INDEX, &id, sizeof(id));
+		memcpy(record.data() + TIMESTAMP_INDEX, &timestamp, sizeof(timestamp));
+		size_t index = ARGS_START_INDEX;
+		((store_arg(record.data() + index, args), index += ARG_LENGTH), ...);
+		ring.commit(record);
+	}
+
+	//================== CALL FROM MAIN LOOP ==================
+	//turn streaming records out to the host on and off; events still get logged (and pile up) while streaming is off
+	//returning bools so these can map straight onto command handlers
+	static bool start_streaming();
+	static bool stop_streaming();
+
+	//returns true if streaming is on and there are records waiting
+	static bool frame_ready();
+
+	//pack as many waiting records as fit into a DEVICE_TRACE payload; returns the payload length (0 if nothing to send)
+	static size_t pack_frame(std::span<uint8_t, std::dynamic_extent> tx_payload);
+
+	//free-running count of events dropped because the ring was full
+	static uint32_t get_dropped_count();
+
+	//delete any constructors
+	Trace() = delete;
+	Trace(Trace const&) = delete;
+
+private:
+	//only ever used at compile time, to check arguments
+	#define TRACE_FORMAT(name, format) format,
+	static constexpr const char* FORMATS[] = {
+		TRACE_FORMATS(TRACE_FORMAT)
+	};
+	#undef TRACE_FORMAT
+
+	//which format conversion an argument type goes with; '?' if we can't log that type
+	template<typename T>
+	static consteval char conversion() {
+		if constexpr (sizeof(T) > ARG_LENGTH) return '?';
+		else if constexpr (std::is_same_v<T, float>) return 'f';
+		else if constexpr (std::is_enum_v<T> || std::is_same_v<T, bool>) return 'u';
+		else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) return 'd';
+		else if constexpr (std::is_integral_v<T>) return 'u';
+		else return '?';
+	}
+
+	//walk the format string, making sure every conversion has an argument of the right type (and vice versa)
+	template<typename... Args>
+	static consteval bool arguments_match(const char* format) {
+		constexpr char conversions[] = {conversion<Args>()..., '\0'};
+		size_t arg = 0;
+		for(const char* c = format; *c != '\0'; c++) {
+			if(*c != '%') continue;
+			c++;
+			if(*c == '%') continue; //literal percent sign
+			char expected = (*c == 'x') ? 'u' : *c; //hex is just another way of printing an unsigned value
+			if(arg >= sizeof...(Args) || conversions[arg] != expected) return false;
+			arg++;
+		}
+		return arg == sizeof...(Args);
+	}
+
+	//widen an argument to 4 bytes and drop its raw bits into the record
+	template<typename T>
+	static inline void store_arg(uint8_t* dest, const T arg) {
+		if constexpr (std::is_same_v<T, float>) memcpy(dest, &arg, ARG_LENGTH);
+		else if constexpr (std::is_enum_v<T> || std::is_same_v<T, bool>) { uint32_t bits = (uint32_t)arg; memcpy(dest, &bits, ARG_LENGTH); }
+		else if constexpr (std::is_signed_v<T>) { int32_t bits = arg; memcpy(dest, &bits, ARG_LENGTH); }
+		else { uint32_t bits = arg; memcpy(dest, &bits, ARG_LENGTH); }
+	}
+
+	static std::array<uint32_t, RING_LENGTH / sizeof(uint32_t)> ring_storage;
+	static Record_Ring ring;
+	static bool streaming;
+};
+
+#endif /* UTILS_APP_UTILS_TRACE_H_ */
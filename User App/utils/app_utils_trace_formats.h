@@ -0,0 +1,33 @@
+/*
+ * app_utils_trace_formats.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Ishaan
+ *
+ *  Every trace event the firmware can log, along with the format string that turns it back into text
+ *  The format strings never make it onto the device--only the ID does; the host decoder reads THIS FILE to get them back
+ *
+ *  To add an event, just add a line to the list: X(<ID name>, "<format string>"), then log it with `Trace::log<Trace::<ID name>>(args...)`
+ *  	- keep each entry on a single line; the host decoder looks for exactly that pattern
+ *  	- only APPEND to the list; IDs are just positions in it, so reordering would garble traces from older firmware
+ *  	- every argument is 4 bytes; supported conversions are %u (uint32_t), %d (int32_t), %x (uint32_t, in hex) and %f (float)
+ *  		\--> `Trace::log()` checks at compile time that the arguments match the conversions in the format string
+ */
+
+#ifndef UTILS_APP_UTILS_TRACE_FORMATS_H_
+#define UTILS_APP_UTILS_TRACE_FORMATS_H_
+
+#define TRACE_FORMATS(X) \
+	X(BOOT,						"firmware up, core clock %u Hz") \
+	X(STAGE_MODE,				"stage %u: mode %u -> %u") \
+	X(BAUD_SWITCH,				"link baud rate %u -> %u") \
+	X(BAUD_FALLBACK,			"link baud rate fell back to %u, host never showed up") \
+	X(TELEMETRY_START,			"telemetry on stage %u, signals %x, decimation %u") \
+	X(SYNC_APPLIED,				"scheduled command %x ran %u us after it was due") \
+	X(SYNC_FAILED,				"scheduled command %x NACKed (reason %u), %u us after it was due") \
+	X(ESTOP,					"emergency stop: %u stage(s) off %u cycles after the frame's EOF landed") \
+	X(HEARTBEAT_LOST,			"host silent for %u ms (window %u ms), ramping down %u stage(s)") \
+	X(HEARTBEAT_SHUTDOWN,		"heartbeat watchdog disabled %u stage(s)") \
+	X(REPLY_SLOT_UNFIT,			"address %u reply slot too far out at %u baud (needs %u or faster), not answering broadcasts") \
+
+#endif /* UTILS_APP_UTILS_TRACE_FORMATS_H_ */